@@ -0,0 +1,144 @@
+/**
+ * @file AcquisitionStats.h
+ * @brief Fixed-size health counters and latency histograms for acquisition
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Each Sensor keeps one HealthCounters record; per-bus and per-chip-select
+ *          figures are the sum of the sensors attached to them. Histograms use
+ *          eight power-of-two buckets so recording is a shift loop and the
+ *          whole record stays a few dozen bytes with no heap use.
+ *
+ * @section dependencies Dependencies
+ * - <stdint.h> only; the header builds on the host for tests
+ */
+
+#ifndef ACQUISITION_STATS_H
+#define ACQUISITION_STATS_H
+
+#include <stdint.h>
+
+constexpr uint32_t HEALTH_READ_BASE_US = 500;   ///< First read-latency bucket: < 0.5 ms
+constexpr uint32_t HEALTH_SWEEP_BASE_MS = 50;   ///< First bus-sweep bucket: < 50 ms
+
+/**
+ * @struct LogHistogram
+ * @brief Eight-bucket histogram with power-of-two bucket widths
+ * @tparam Base Upper bound of bucket 0; bucket b holds values below Base << b,
+ *              the last bucket is open-ended
+ */
+template <uint32_t Base>
+struct LogHistogram {
+    static constexpr uint8_t BUCKETS = 8;   ///< Number of buckets
+
+    uint32_t counts[BUCKETS] = {};          ///< Samples per bucket
+    uint32_t maxValue = 0;                  ///< Largest sample recorded
+
+    /**
+     * @brief Add one sample
+     * @param[in] value Sample in the histogram's unit
+     */
+    void record(uint32_t value) {
+        uint32_t q = value / Base;
+        uint8_t bucket = 0;
+        while (q && bucket < BUCKETS - 1) {
+            q >>= 1;
+            bucket++;
+        }
+        counts[bucket]++;
+        if (value > maxValue) maxValue = value;
+    }
+
+    /**
+     * @brief Get exclusive upper bound of a bucket
+     * @param[in] bucket Bucket index
+     * @return uint32_t Base << bucket
+     */
+    static constexpr uint32_t bucketLimit(uint8_t bucket) { return Base << bucket; }
+
+    /**
+     * @brief Number of samples recorded
+     * @return uint32_t Sum of all buckets
+     */
+    uint32_t total() const {
+        uint32_t sum = 0;
+        for (uint8_t b = 0; b < BUCKETS; ++b) sum += counts[b];
+        return sum;
+    }
+
+    /**
+     * @brief Estimate a percentile
+     * @param[in] pct Percentile, 1-100
+     * @return uint32_t Upper bound of the bucket holding it (maxValue for the
+     *         open bucket, 0 if empty)
+     */
+    uint32_t percentile(uint8_t pct) const {
+        uint32_t n = total();
+        if (n == 0) return 0;
+        uint32_t rank = (uint32_t)(((uint64_t)n * pct + 99) / 100);
+        uint32_t seen = 0;
+        for (uint8_t b = 0; b < BUCKETS - 1; ++b) {
+            seen += counts[b];
+            if (seen >= rank) return bucketLimit(b) < maxValue ? bucketLimit(b) : maxValue;
+        }
+        return maxValue;
+    }
+
+    /**
+     * @brief Add another histogram of the same scale
+     * @param[in] other Histogram to add
+     */
+    void merge(const LogHistogram& other) {
+        for (uint8_t b = 0; b < BUCKETS; ++b) counts[b] += other.counts[b];
+        if (other.maxValue > maxValue) maxValue = other.maxValue;
+    }
+};
+
+/**
+ * @struct HealthCounters
+ * @brief Read statistics of one sensor, bus or chip select
+ * @note Written by the acquisition task; the loop task reads the 32-bit
+ *       fields without locking, so a snapshot may mix adjacent reads.
+ */
+struct HealthCounters {
+    LogHistogram<HEALTH_READ_BASE_US> readUs;  ///< Read latency in µs
+    uint32_t reads = 0;          ///< Read attempts
+    uint32_t failures = 0;       ///< Reads that returned no value
+    uint32_t crcErrors = 0;      ///< Scratchpad reads with bad CRC8
+    uint32_t retries = 0;        ///< Scratchpad re-reads after CRC failure
+    uint32_t timeouts = 0;       ///< Reads with no answer (no presence, bus stuck)
+    uint32_t quarantines = 0;    ///< Times the sensor entered quarantine
+    uint32_t lastGoodMs = 0;     ///< millis() of the last successful read, 0 = never
+
+    /**
+     * @brief Record one read attempt
+     * @param[in] latencyUs Time spent on the bus in µs
+     * @param[in] ok true if a value was returned
+     * @param[in] timeout true if the device did not answer
+     * @param[in] now millis() of the read
+     */
+    void recordRead(uint32_t latencyUs, bool ok, bool timeout, uint32_t now) {
+        readUs.record(latencyUs);
+        reads++;
+        if (ok) lastGoodMs = now ? now : 1;
+        else failures++;
+        if (timeout) timeouts++;
+    }
+
+    /**
+     * @brief Add another record (bus and chip-select totals)
+     * @param[in] other Record to add; lastGoodMs keeps the most recent
+     */
+    void merge(const HealthCounters& other) {
+        readUs.merge(other.readUs);
+        reads += other.reads;
+        failures += other.failures;
+        crcErrors += other.crcErrors;
+        retries += other.retries;
+        timeouts += other.timeouts;
+        quarantines += other.quarantines;
+        if (other.lastGoodMs && (lastGoodMs == 0 || (int32_t)(other.lastGoodMs - lastGoodMs) > 0))
+            lastGoodMs = other.lastGoodMs;
+    }
+};
+
+#endif // ACQUISITION_STATS_H
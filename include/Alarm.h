@@ -10,6 +10,7 @@
  * - Arduino.h for core functionality
  * - MeasurementPoint.h for measurement point association
  * - LoggerManager.h for alarm logging
+ * - SpscRing.h for the transition record ring
  * 
  * @section hardware Hardware Requirements
  * - ESP32 microcontroller
@@ -22,9 +23,12 @@
 #include <vector>
 #include "MeasurementPoint.h"
 #include "LoggerManager.h"
+#include "SpscRing.h"
 
 // Forward declaration
 class MeasurementPoint;
+class AlarmCounters;
+class AlarmQueues;
 
 /**
  * @brief Enumeration defining different types of alarms
@@ -61,6 +65,27 @@ enum class AlarmPriority {
     PRIORITY_CRITICAL    ///< Critical priority - immediate attention required
 };
 
+/**
+ * @struct AlarmEvent
+ * @brief Stage transition record passed from the alarm engine to its consumers
+ * @details Fixed size and allocation free; the consumer resolves the point
+ *          name and formats the log text when it drains the ring.
+ */
+struct AlarmEvent {
+    uint32_t timeMs;             ///< millis() at the transition
+    uint8_t pointAddress;        ///< Measurement point address (255 if no source)
+    AlarmType type;              ///< Alarm type
+    AlarmPriority priority;      ///< Priority at the transition
+    AlarmStage fromStage;        ///< Stage left
+    AlarmStage toStage;          ///< Stage entered
+    int16_t temperature;         ///< Point temperature at the transition
+    int16_t threshold;           ///< Threshold of a temperature alarm, 0 otherwise
+};
+
+constexpr size_t ALARM_EVENT_RING_SIZE = 32;   ///< Minimum transition records buffered for the consumer
+
+using AlarmEventRing = SpscHeapRing<AlarmEvent>; ///< Alarm engine -> consumer transitions
+
 
 /**
  * @brief Main alarm class for temperature monitoring system
@@ -150,6 +175,15 @@ public:
      * @return bool True if alarm is in RESOLVED stage
      */
     bool isResolved() const { return _stage == AlarmStage::RESOLVED; }
+
+    /**
+     * @brief Get the time at which the stage may change without a point change
+     * @param[out] dueAt millis() value from which updateCondition() must run;
+     *             in the past for NEW and CLEARED, which settle on the next update
+     * @return bool False if only a change of the source point can move the alarm
+     * @details ACKNOWLEDGED alarms are due when the acknowledgment delay elapses.
+     */
+    bool getPendingDeadline(unsigned long& dueAt) const;
     
     // State management
     /**
@@ -242,6 +276,39 @@ public:
      */
     String getStageString() const;
 
+    /**
+     * @brief Get alarm type name without allocating
+     * @return const char* Static type name, same text as getTypeString()
+     */
+    const char* getTypeName() const;
+
+    /**
+     * @brief Get alarm stage name without allocating
+     * @return const char* Static stage name, same text as getStageString()
+     */
+    const char* getStageName() const;
+
+    /**
+     * @brief Get the name of an alarm type
+     * @param[in] type Alarm type
+     * @return const char* Static name, as getTypeName()
+     */
+    static const char* typeName(AlarmType type);
+
+    /**
+     * @brief Get the name of an alarm stage
+     * @param[in] stage Alarm stage
+     * @return const char* Static name, as getStageName()
+     */
+    static const char* stageName(AlarmStage stage);
+
+    /**
+     * @brief Get the name of an alarm priority
+     * @param[in] priority Alarm priority
+     * @return const char* Static name ("LOW" ... "CRITICAL")
+     */
+    static const char* priorityName(AlarmPriority priority);
+
     // Configuration support
     /**
      * @brief Get the configuration key for this alarm
@@ -321,6 +388,26 @@ public:
      */
     unsigned long getAcknowledgedTimeLeft() const;
 
+    /**
+     * @brief Attach the counters and queues this alarm keeps up to date
+     * @param[in] counters Priority/stage counters, or nullptr
+     * @param[in] queues Active/acknowledged queues, or nullptr
+     * @details While enabled the alarm is counted in the cell of its priority
+     *          and stage and, if ACTIVE or ACKNOWLEDGED, linked into the
+     *          matching queue. It moves itself on every change. The
+     *          destructor detaches.
+     */
+    void attachIndexes(AlarmCounters* counters, AlarmQueues* queues);
+
+    /**
+     * @brief Set the ring that receives this alarm's stage transitions
+     * @param[in] events Ring, or nullptr to stop emitting
+     * @details Every stage change pushes one AlarmEvent; logging happens
+     *          when the consumer drains the ring, never during evaluation.
+     *          Must be called from the task that evaluates the alarms.
+     */
+    void setEventRing(AlarmEventRing* events) { _events = events; }
+
 
     
 
@@ -342,6 +429,14 @@ private:
     unsigned long _acknowledgedDelay; ///< Delay after acknowledgment (millis)
     String _configKey;               ///< Configuration key "alarm_<point>_<type>"
     bool _enabled;                   ///< Whether alarm is active in configuration
+    AlarmCounters* _counters;        ///< Priority/stage counters, nullptr if not attached
+    AlarmQueues* _queues;            ///< Active/acknowledged queues, nullptr if not attached
+    AlarmEventRing* _events;         ///< Transition record ring, nullptr if not attached
+    Alarm* _queuePrev;               ///< Older alarm in the same queue list
+    Alarm* _queueNext;               ///< Newer alarm in the same queue list
+    uint8_t _queueList;              ///< Queue list holding the alarm, ALARM_QUEUE_NONE if none
+
+    friend class AlarmQueues;
     
     // Display message
     String _message;                 ///< Human-readable alarm description
@@ -359,6 +454,34 @@ private:
      */
     bool _checkCondition();
 
+    /**
+     * @brief Hand the hysteresis of a temperature alarm to its point
+     * @details The threshold kernel evaluates the band per point
+     */
+    void _applyHysteresis();
+
+    /**
+     * @brief Change stage and move the alarm in the counters and queues
+     * @param[in] stage New stage
+     */
+    void _setStage(AlarmStage stage);
+
+    /**
+     * @brief Take the alarm out of the counters and queues before a change
+     */
+    void _leaveIndexes();
+
+    /**
+     * @brief Put the alarm back into the counters and queues after a change
+     */
+    void _enterIndexes();
+
+    /**
+     * @brief Push the transition just made into the event ring
+     * @param[in] fromStage Stage the alarm left
+     */
+    void _emitTransition(AlarmStage fromStage);
+
     /**
      * @brief Get priority as string (internal version)
      * @return String Priority level as text
@@ -0,0 +1,160 @@
+/**
+ * @file AlarmCounters.h
+ * @brief Enabled alarm counts by priority and stage, kept up to date on every transition
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Replaces the per-query scans of the configured alarm list behind
+ *          TemperatureController::getAlarmCount(). Alarms attached with
+ *          Alarm::attachIndexes() move their own count whenever their stage,
+ *          priority or enabled flag changes, so a query never looks at an
+ *          alarm.
+ *
+ *          Besides the 4x5 count matrix the class keeps its 2D prefix sums
+ *          (_prefix[p][s] = alarms with priority < p and stage < s), so any
+ *          combination of ==, !=, <, <=, > and >= on priority and stage is at
+ *          most four rectangle sums. An update touches at most 20 prefix cells.
+ *
+ *          Priority and stage are ordered by their enum values, as the
+ *          String comparisons they replace did.
+ *
+ * @section dependencies Dependencies
+ * - <stdint.h>, <string.h> only; the header builds on the host
+ */
+
+#ifndef ALARM_COUNTERS_H
+#define ALARM_COUNTERS_H
+
+#include <stdint.h>
+#include <string.h>
+
+constexpr uint8_t ALARM_PRIORITY_COUNT = 4;   ///< Number of AlarmPriority values
+constexpr uint8_t ALARM_STAGE_COUNT = 5;      ///< Number of AlarmStage values
+
+/**
+ * @brief Comparison applied to a priority or stage in a count query
+ */
+enum class AlarmCompare : uint8_t {
+    EQ,    ///< ==
+    NE,    ///< !=
+    LT,    ///< <
+    LE,    ///< <=
+    GT,    ///< >
+    GE     ///< >=
+};
+
+/**
+ * @class AlarmCounters
+ * @brief Priority x stage count matrix with prefix sums
+ */
+class AlarmCounters {
+public:
+    AlarmCounters() { clear(); }
+
+    /**
+     * @brief Reset all counts to zero
+     */
+    void clear() {
+        memset(_counts, 0, sizeof(_counts));
+        memset(_prefix, 0, sizeof(_prefix));
+    }
+
+    /**
+     * @brief Count one more alarm
+     * @param[in] priority AlarmPriority value
+     * @param[in] stage AlarmStage value
+     */
+    void add(uint8_t priority, uint8_t stage) { _update(priority, stage, 1); }
+
+    /**
+     * @brief Count one alarm less
+     * @param[in] priority AlarmPriority value
+     * @param[in] stage AlarmStage value
+     */
+    void remove(uint8_t priority, uint8_t stage) { _update(priority, stage, -1); }
+
+    /**
+     * @brief Move one alarm between cells
+     */
+    void move(uint8_t fromPriority, uint8_t fromStage, uint8_t toPriority, uint8_t toStage) {
+        if (fromPriority == toPriority && fromStage == toStage) return;
+        _update(fromPriority, fromStage, -1);
+        _update(toPriority, toStage, 1);
+    }
+
+    /**
+     * @brief Count alarms in one cell
+     * @return uint16_t Alarms with exactly this priority and stage
+     */
+    uint16_t count(uint8_t priority, uint8_t stage) const {
+        return (priority < ALARM_PRIORITY_COUNT && stage < ALARM_STAGE_COUNT) ? _counts[priority][stage] : 0;
+    }
+
+    /**
+     * @brief Count alarms matching a comparison on priority and on stage
+     * @param[in] priority Priority operand
+     * @param[in] priorityCompare Operator applied as (alarm priority) op (priority)
+     * @param[in] stage Stage operand
+     * @param[in] stageCompare Operator applied as (alarm stage) op (stage)
+     * @return uint16_t Matching alarms
+     */
+    uint16_t count(uint8_t priority, AlarmCompare priorityCompare,
+                   uint8_t stage, AlarmCompare stageCompare) const {
+        Range p[2], s[2];
+        const uint8_t pn = _ranges(priority, priorityCompare, ALARM_PRIORITY_COUNT, p);
+        const uint8_t sn = _ranges(stage, stageCompare, ALARM_STAGE_COUNT, s);
+        int32_t total = 0;
+        for (uint8_t i = 0; i < pn; ++i)
+            for (uint8_t j = 0; j < sn; ++j)
+                total += _prefix[p[i].end][s[j].end] - _prefix[p[i].begin][s[j].end]
+                       - _prefix[p[i].end][s[j].begin] + _prefix[p[i].begin][s[j].begin];
+        return (uint16_t)total;
+    }
+
+    /**
+     * @brief Count alarms matching a comparison on priority, any stage
+     */
+    uint16_t countPriority(uint8_t priority, AlarmCompare compare) const {
+        return count(priority, compare, 0, AlarmCompare::GE);
+    }
+
+    /**
+     * @brief Count alarms matching a comparison on stage, any priority
+     */
+    uint16_t countStage(uint8_t stage, AlarmCompare compare) const {
+        return count(0, AlarmCompare::GE, stage, compare);
+    }
+
+    /**
+     * @brief Total counted alarms
+     */
+    uint16_t total() const { return (uint16_t)_prefix[ALARM_PRIORITY_COUNT][ALARM_STAGE_COUNT]; }
+
+private:
+    struct Range { uint8_t begin, end; };   ///< Half-open [begin, end)
+
+    static uint8_t _ranges(uint8_t value, AlarmCompare compare, uint8_t n, Range* out) {
+        const uint8_t v = value < n ? value : n;
+        const uint8_t next = value < n ? (uint8_t)(value + 1) : n;
+        switch (compare) {
+            case AlarmCompare::NE: out[0] = { 0, v }; out[1] = { next, n }; return 2;
+            case AlarmCompare::LT: out[0] = { 0, v }; return 1;
+            case AlarmCompare::LE: out[0] = { 0, next }; return 1;
+            case AlarmCompare::GT: out[0] = { next, n }; return 1;
+            case AlarmCompare::GE: out[0] = { v, n }; return 1;
+            default:               out[0] = { v, next }; return 1;
+        }
+    }
+
+    void _update(uint8_t priority, uint8_t stage, int8_t delta) {
+        if (priority >= ALARM_PRIORITY_COUNT || stage >= ALARM_STAGE_COUNT) return;
+        _counts[priority][stage] = (uint16_t)(_counts[priority][stage] + delta);
+        for (uint8_t p = priority + 1; p <= ALARM_PRIORITY_COUNT; ++p)
+            for (uint8_t s = stage + 1; s <= ALARM_STAGE_COUNT; ++s)
+                _prefix[p][s] = (uint16_t)(_prefix[p][s] + delta);
+    }
+
+    uint16_t _counts[ALARM_PRIORITY_COUNT][ALARM_STAGE_COUNT];            ///< Alarms per cell
+    uint16_t _prefix[ALARM_PRIORITY_COUNT + 1][ALARM_STAGE_COUNT + 1];    ///< Sums over [0,p) x [0,s)
+};
+
+#endif // ALARM_COUNTERS_H
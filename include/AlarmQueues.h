@@ -0,0 +1,110 @@
+/**
+ * @file AlarmQueues.h
+ * @brief Active and acknowledged alarms in per-priority intrusive lists
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Replaces re-sorting the configured alarm list every alarm pass and
+ *          rebuilding the display queues every loop. Each of the two queues
+ *          (ACTIVE, ACKNOWLEDGED) has one doubly linked list per priority,
+ *          ordered oldest timestamp first; the links live in the Alarm itself,
+ *          so queueing never allocates.
+ *
+ *          Alarms attached with Alarm::attachIndexes() unlink themselves
+ *          before a stage, priority or enabled change and link again after
+ *          it. Insertion walks back from the tail, which is one step for a
+ *          newly raised alarm. Queue order is highest priority first, then
+ *          oldest first, the order AlarmComparator defines.
+ *
+ * @section dependencies Dependencies
+ * - AlarmCounters.h for ALARM_PRIORITY_COUNT
+ */
+
+#ifndef ALARM_QUEUES_H
+#define ALARM_QUEUES_H
+
+#include <stdint.h>
+#include "AlarmCounters.h"
+
+class Alarm;
+
+/**
+ * @brief Queues kept by AlarmQueues
+ */
+enum AlarmQueueId : uint8_t {
+    ALARM_QUEUE_ACTIVE = 0,         ///< Enabled alarms in stage ACTIVE
+    ALARM_QUEUE_ACKNOWLEDGED = 1,   ///< Enabled alarms in stage ACKNOWLEDGED
+    ALARM_QUEUE_COUNT = 2
+};
+
+constexpr uint8_t ALARM_QUEUE_NONE = 0xFF;   ///< Alarm::_queueList value of an unqueued alarm
+
+/**
+ * @class AlarmQueues
+ * @brief Per-queue, per-priority timestamp-ordered alarm lists
+ */
+class AlarmQueues {
+public:
+    AlarmQueues();
+
+    /**
+     * @brief Link an alarm into the list of its stage and priority
+     * @param[in] alarm Alarm; ignored unless ACTIVE or ACKNOWLEDGED, or if already queued
+     */
+    void insert(Alarm* alarm);
+
+    /**
+     * @brief Unlink an alarm
+     * @param[in] alarm Alarm; ignored if not queued
+     */
+    void remove(Alarm* alarm);
+
+    /**
+     * @brief Oldest alarm of one priority
+     * @param[in] queue Queue
+     * @param[in] priority AlarmPriority value
+     * @return Alarm* Head of the list or nullptr
+     */
+    Alarm* head(AlarmQueueId queue, uint8_t priority) const {
+        return priority < ALARM_PRIORITY_COUNT ? _head[queue][priority] : nullptr;
+    }
+
+    /**
+     * @brief First alarm in queue order (highest priority, oldest)
+     * @param[in] queue Queue
+     * @return Alarm* Alarm or nullptr if the queue is empty
+     */
+    Alarm* first(AlarmQueueId queue) const;
+
+    /**
+     * @brief Successor in queue order, continuing into lower priorities
+     * @param[in] alarm Queued alarm
+     * @return Alarm* Next alarm or nullptr at the end of the queue
+     */
+    Alarm* next(const Alarm* alarm) const;
+
+    /**
+     * @brief Alarm at a position in queue order
+     * @param[in] queue Queue
+     * @param[in] index Position, 0 = first()
+     * @return Alarm* Alarm or nullptr if index >= size()
+     * @details Walks the lists; meant for the display rotation, not hot paths
+     */
+    Alarm* at(AlarmQueueId queue, uint16_t index) const;
+
+    /**
+     * @brief Number of alarms in a queue
+     */
+    uint16_t size(AlarmQueueId queue) const { return _sizes[queue]; }
+
+    /**
+     * @brief True if a queue holds no alarm
+     */
+    bool empty(AlarmQueueId queue) const { return _sizes[queue] == 0; }
+
+private:
+    Alarm* _head[ALARM_QUEUE_COUNT][ALARM_PRIORITY_COUNT];   ///< Oldest alarm per list
+    Alarm* _tail[ALARM_QUEUE_COUNT][ALARM_PRIORITY_COUNT];   ///< Newest alarm per list
+    uint16_t _sizes[ALARM_QUEUE_COUNT];                      ///< Alarms per queue
+};
+
+#endif // ALARM_QUEUES_H
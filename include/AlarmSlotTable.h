@@ -0,0 +1,165 @@
+/**
+ * @file AlarmSlotTable.h
+ * @brief Per-point alarm index with one slot per AlarmType
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Replaces the linear scans of the configured alarm list (and the
+ *          "alarm_<point>_<type>" String comparisons) used to find the alarm
+ *          of a point. Slot (address, type) lives at address * ALARM_TYPE_COUNT
+ *          + type in one flat array sized to the point count, so lookups are a
+ *          multiply and a load. The table does not own the alarms; the
+ *          controller's configured alarm list still does and keeps its
+ *          priority order.
+ *
+ *          The array is in internal RAM (calloc, like PointHotStore): it is
+ *          read for every alarm on every alarm pass.
+ *
+ * @section dependencies Dependencies
+ * - Alarm.h for Alarm and AlarmType
+ */
+
+#ifndef ALARM_SLOT_TABLE_H
+#define ALARM_SLOT_TABLE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+#include "Alarm.h"
+
+constexpr uint8_t ALARM_TYPE_COUNT = 4;   ///< Number of AlarmType values
+
+/**
+ * @class AlarmSlotTable
+ * @brief [point][AlarmType] to Alarm* map
+ */
+class AlarmSlotTable {
+public:
+    AlarmSlotTable() : _slots(nullptr), _pointCount(0) {}
+    ~AlarmSlotTable() { free(_slots); }
+
+    AlarmSlotTable(const AlarmSlotTable&) = delete;
+    AlarmSlotTable& operator=(const AlarmSlotTable&) = delete;
+
+    /**
+     * @brief Size the table for a point count; all slots become empty
+     * @param[in] pointCount Number of measurement points
+     * @return false if out of memory (the previous table is kept)
+     */
+    bool allocate(uint16_t pointCount) {
+        Alarm** slots = static_cast<Alarm**>(
+            calloc((size_t)(pointCount ? pointCount : 1) * ALARM_TYPE_COUNT, sizeof(Alarm*)));
+        if (slots == nullptr) return false;
+        free(_slots);
+        _slots = slots;
+        _pointCount = pointCount;
+        return true;
+    }
+
+    /**
+     * @brief Exchange tables with another instance
+     * @param[in,out] other Table to swap with
+     */
+    void swap(AlarmSlotTable& other) {
+        std::swap(_slots, other._slots);
+        std::swap(_pointCount, other._pointCount);
+    }
+
+    /**
+     * @brief Empty all slots
+     */
+    void clear() {
+        for (uint32_t i = 0; i < (uint32_t)_pointCount * ALARM_TYPE_COUNT; ++i) _slots[i] = nullptr;
+    }
+
+    /**
+     * @brief Look up the alarm of a point
+     * @param[in] address Point address
+     * @param[in] type Alarm type
+     * @return Alarm* Alarm or nullptr
+     */
+    Alarm* get(uint8_t address, AlarmType type) const {
+        const uint8_t t = static_cast<uint8_t>(type);
+        if (address >= _pointCount || t >= ALARM_TYPE_COUNT) return nullptr;
+        return _slots[(uint32_t)address * ALARM_TYPE_COUNT + t];
+    }
+
+    /**
+     * @brief Store an alarm in the slot of its point and type
+     * @param[in] alarm Alarm with a source point
+     * @return false if the alarm has no point in range
+     */
+    bool set(Alarm* alarm) {
+        Alarm** slot = _slotOf(alarm);
+        if (slot == nullptr) return false;
+        *slot = alarm;
+        return true;
+    }
+
+    /**
+     * @brief Empty the slot of an alarm if it holds that alarm
+     * @param[in] alarm Alarm being removed
+     */
+    void erase(const Alarm* alarm) {
+        Alarm** slot = _slotOf(alarm);
+        if (slot != nullptr && *slot == alarm) *slot = nullptr;
+    }
+
+    /**
+     * @brief Number of points covered
+     * @return uint16_t Point count given to allocate()
+     */
+    uint16_t getPointCount() const { return _pointCount; }
+
+    /**
+     * @brief Parse an alarm config key without allocating
+     * @details Accepts both spellings in use: "alarm_<point>_<type number>"
+     *          (addAlarm, API, CSV import) and "P<point>_LOW_TEMP",
+     *          "P<point>_HIGH_TEMP", "P<point>_SENSOR_ERROR",
+     *          "P<point>_DISCONNECTED" (points configuration).
+     * @param[in] key Config key
+     * @param[out] address Point address
+     * @param[out] type Alarm type
+     * @return false if the key is in neither form
+     */
+    static bool parseConfigKey(const char* key, uint8_t& address, AlarmType& type) {
+        const char* p;
+        if (strncmp(key, "alarm_", 6) == 0) p = key + 6;
+        else if (key[0] == 'P') p = key + 1;
+        else return false;
+
+        uint16_t value = 0;
+        const char* digits = p;
+        while (*p >= '0' && *p <= '9' && value < 256) value = (uint16_t)(value * 10 + (*p++ - '0'));
+        if (p == digits || value > 255 || *p++ != '_') return false;
+        address = (uint8_t)value;
+
+        if (key[0] == 'a') {
+            if (p[0] < '0' || p[0] >= '0' + ALARM_TYPE_COUNT || p[1] != '\0') return false;
+            type = static_cast<AlarmType>(p[0] - '0');
+            return true;
+        }
+        static const char* const names[ALARM_TYPE_COUNT] = { "HIGH_TEMP", "LOW_TEMP", "SENSOR_ERROR", "DISCONNECTED" };
+        for (uint8_t t = 0; t < ALARM_TYPE_COUNT; ++t) {
+            if (strcmp(p, names[t]) == 0) {
+                type = static_cast<AlarmType>(t);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    Alarm** _slotOf(const Alarm* alarm) const {
+        if (alarm == nullptr || alarm->getSource() == nullptr) return nullptr;
+        const uint8_t address = alarm->getSource()->getAddress();
+        const uint8_t t = static_cast<uint8_t>(alarm->getType());
+        if (address >= _pointCount || t >= ALARM_TYPE_COUNT) return nullptr;
+        return &_slots[(uint32_t)address * ALARM_TYPE_COUNT + t];
+    }
+
+    Alarm** _slots;          ///< pointCount * ALARM_TYPE_COUNT entries, nullptr = empty
+    uint16_t _pointCount;    ///< Points covered
+};
+
+#endif // ALARM_SLOT_TABLE_H
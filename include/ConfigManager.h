@@ -11,6 +11,7 @@
  * - WebServer.h for HTTP API endpoints
  * - LittleFS.h for file system operations
  * - TemperatureController.h for device control
+ * - Trace.h for the runtime trace module mask
  * 
  * @section hardware Hardware Requirements
  * - ESP32 with WiFi capability
@@ -29,6 +30,7 @@
 #include "CSVConfigManager.h"
 #include "SettingsCSVManager.h"
 #include "LoggerManager.h" 
+#include "Trace.h"
 
 /// YAML configuration definition for ConfigAssist
 extern const char* VARIABLES_DEF_YAML;
@@ -105,6 +107,19 @@ private:
      */
     void downloadAPI();
 
+    /**
+     * @brief Read a point count setting
+     * @param[in] key Setting name
+     * @param[in] fallback Value when the setting is missing (older config files)
+     * @return uint8_t Count, clamped to POINT_REGISTRY_MAX_POINTS
+     */
+    uint8_t _pointCountSetting(const char* key, uint8_t fallback) {
+        String value = conf(key);
+        if (value.isEmpty()) return fallback;
+        long count = value.toInt();
+        return count < 0 ? 0 : count > POINT_REGISTRY_MAX_POINTS ? POINT_REGISTRY_MAX_POINTS : (uint8_t)count;
+    }
+
     
     // Save sensor configuration to file
     //void saveSensorConfig();
@@ -201,6 +216,61 @@ public:
      * @return uint16_t Measurement interval in seconds
      */
     uint16_t getMeasurementPeriod() { return conf("measurement_period").toInt(); }
+
+    /**
+     * @brief Get configured number of DS18B20 measurement points
+     * @return uint8_t Point count (applied at startup), default if unset
+     */
+    uint8_t getDS18B20PointCount() { return _pointCountSetting("ds_point_count", DEFAULT_DS18B20_POINTS); }
+
+    /**
+     * @brief Get configured number of PT1000 measurement points
+     * @return uint8_t Point count (applied at startup), default if unset
+     */
+    uint8_t getPT1000PointCount() { return _pointCountSetting("pt_point_count", DEFAULT_PT1000_POINTS); }
+    
+    /**
+     * @brief Check if adaptive per-sensor sampling is enabled
+     * @return bool True if stable sensors are read less often
+     */
+    bool isAdaptiveSampling() { return conf("adaptive_sampling").toInt() == 1; }
+
+    /**
+     * @brief Check if background hot-plug discovery is enabled
+     * @return bool True if DS18B20 buses are searched continuously
+     */
+    bool isBackgroundDiscovery() { return conf("background_discovery").toInt() == 1; }
+
+    /**
+     * @brief Check if DS18B20 hardware alarm screening is enabled
+     * @return bool True if TH/TL are written and alarm searches run between sweeps
+     */
+    bool isAlarmScreening() { return conf("alarm_screening").toInt() == 1; }
+
+    /**
+     * @brief Check if PT1000 continuous conversion is enabled
+     * @return bool True if MAX31865 channels auto-convert with bias on
+     */
+    bool isPT1000Continuous() { return conf("pt1000_continuous").toInt() == 1; }
+
+    /**
+     * @brief Get mains frequency for the MAX31865 noise filter
+     * @return uint8_t 50 or 60 Hz
+     */
+    uint8_t getMainsFrequency() { return conf("mains_frequency").toInt(); }
+    
+    /**
+     * @brief Get nominal resistance of the fitted RTD element
+     * @return float 100 for PT100, 1000 for PT1000
+     */
+    float getRtdNominal() { return conf("rtd_type") == "PT100" ? RTD_PT100_NOMINAL : RTD_PT1000_NOMINAL; }
+
+    /**
+     * @brief Get calibrated reference resistor of a MAX31865 channel
+     * @param[in] channel Channel index (0-3)
+     * @return float Reference resistance in ohms
+     */
+    float getRtdReference(uint8_t channel) { return conf("pt_rref_" + String(channel + 1)).toFloat(); }
     
     /**
      * @brief Check if Modbus is enabled
@@ -213,6 +283,16 @@ public:
      * @return uint8_t Configured Modbus device address
      */
     uint8_t getModbusAddress() { return conf("modbus_address").toInt(); }
+
+    /**
+     * @brief Get the serial trace modules selected in the settings
+     * @return uint32_t TraceModule bits; levels above LOGGER_LOG_LEVEL stay compiled out
+     */
+    uint32_t getTraceModules() {
+        return (conf("trace_alarm_transitions").toInt() == 1 ? TRACE_ALARM : 0) |
+               (conf("trace_alarm_checks").toInt() == 1 ? TRACE_ALARM_CHECK : 0) |
+               (conf("trace_alarm_passes").toInt() == 1 ? TRACE_ALARM_PASS : 0);
+    }
     
     /**
      * @brief Get Modbus baud rate
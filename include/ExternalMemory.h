@@ -0,0 +1,74 @@
+/**
+ * @file ExternalMemory.h
+ * @brief Allocation helpers for large tables that belong in PSRAM
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Point tables grow with the configured point count and are touched
+ *          once per sweep, so they go to external PSRAM (BOARD_HAS_PSRAM) and
+ *          leave internal RAM to stacks, DMA buffers and WiFi. When PSRAM is
+ *          absent or exhausted the allocation falls back to the normal heap.
+ *
+ * @section dependencies Dependencies
+ * - esp_heap_caps.h on the ESP32; <stdlib.h> elsewhere (host builds)
+ */
+
+#ifndef EXTERNAL_MEMORY_H
+#define EXTERNAL_MEMORY_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#if defined(ESP_PLATFORM) && defined(BOARD_HAS_PSRAM)
+#include <esp_heap_caps.h>
+#endif
+
+/**
+ * @brief Allocate zeroed memory, preferring PSRAM
+ * @param[in] bytes Size of the block
+ * @param[out] external Set to true if the block is in PSRAM (may be nullptr)
+ * @return void* Block or nullptr; release with externalFree()
+ */
+inline void* externalAlloc(size_t bytes, bool* external = nullptr) {
+#if defined(ESP_PLATFORM) && defined(BOARD_HAS_PSRAM)
+    void* block = heap_caps_calloc(1, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (external) *external = block != nullptr;
+    if (block) return block;
+#else
+    if (external) *external = false;
+#endif
+    return calloc(1, bytes);
+}
+
+/**
+ * @brief Check whether PSRAM is present and initialized
+ * @return true if externalAlloc() can place blocks in PSRAM
+ * @details False during static construction, before the core runs psramInit().
+ */
+inline bool externalMemoryAvailable() {
+#if defined(ESP_PLATFORM) && defined(BOARD_HAS_PSRAM)
+    return heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Release a block from externalAlloc()
+ * @param[in] block Block or nullptr
+ */
+inline void externalFree(void* block) {
+    free(block); // heap_caps blocks are released by free() as well
+}
+
+/**
+ * @brief ArduinoJson allocator that prefers PSRAM
+ * @details For API documents sized from the sensor or point count; use as
+ *          BasicJsonDocument<ExternalJsonAllocator>.
+ */
+struct ExternalJsonAllocator {
+    void* allocate(size_t bytes) { return externalAlloc(bytes); }
+    void deallocate(void* block) { externalFree(block); }
+    void* reallocate(void* block, size_t bytes) { return realloc(block, bytes); }
+};
+
+#endif // EXTERNAL_MEMORY_H
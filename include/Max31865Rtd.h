@@ -0,0 +1,76 @@
+/**
+ * @file Max31865Rtd.h
+ * @brief Hardware MAX31865 backend for PT100/PT1000 channels
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Wraps Adafruit_MAX31865 for configuration and one-shot reads, and
+ *          reads the RTD register directly over SPI in auto-convert mode:
+ *          the library keeps its register access private and always runs a
+ *          one-shot sequence around readRTD(). startOneShot() sets the
+ *          1-shot bit the same way, so the acquisition engine can split a
+ *          one-shot read into bias, start and collect steps.
+ *
+ * @section dependencies Dependencies
+ * - SensorBus.h for the interface
+ * - Adafruit_MAX31865 library
+ * - SPI for direct register reads
+ */
+
+#ifndef MAX31865_RTD_H
+#define MAX31865_RTD_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Adafruit_MAX31865.h>
+#include "SensorBus.h"
+
+constexpr uint32_t MAX31865_SPI_CLOCK = 1000000;   ///< MAX31865 SPI clock (mode 1)
+constexpr uint8_t MAX31865_REG_CONFIG = 0x00;      ///< Configuration register
+constexpr uint8_t MAX31865_REG_RTD_MSB = 0x01;     ///< RTD data register (MSB, LSB follows)
+constexpr uint8_t MAX31865_CONFIG_ONESHOT = 0x20;  ///< Configuration: start one conversion (self-clearing)
+constexpr uint8_t MAX31865_REG_FAULT = 0x07;       ///< Fault status register
+
+/**
+ * @class Max31865Rtd
+ * @brief One MAX31865 on a dedicated chip select
+ */
+class Max31865Rtd : public RtdInterface {
+public:
+    /**
+     * @brief Construct a converter driver
+     * @param[in] csPin SPI chip select pin
+     */
+    explicit Max31865Rtd(uint8_t csPin);
+
+    ~Max31865Rtd() override;
+
+    uint8_t getChipSelectPin() const override { return _csPin; }
+    bool begin() override;
+    void configure(bool continuous, bool filter50Hz) override;
+    void readLatest(uint16_t& raw, uint8_t& fault) override;
+    void readOneShot(uint16_t& raw, uint8_t& fault) override;
+    void setBias(bool on) override;
+    void startOneShot() override;
+    void clearFault() override;
+
+private:
+    /**
+     * @brief Read consecutive MAX31865 registers over raw SPI
+     * @param[in] reg Register address (read form, bit 7 clear)
+     * @param[out] buf Destination buffer
+     * @param[in] len Number of bytes to read
+     */
+    void _readRegisters(uint8_t reg, uint8_t* buf, uint8_t len);
+
+    /**
+     * @brief Write one MAX31865 register over raw SPI
+     * @param[in] reg Register address (read form, bit 7 clear)
+     * @param[in] value Value to write
+     */
+    void _writeRegister(uint8_t reg, uint8_t value);
+
+    uint8_t _csPin;                 ///< Chip select pin
+    Adafruit_MAX31865* _max31865;   ///< Library driver
+};
+
+#endif // MAX31865_RTD_H
@@ -9,6 +9,7 @@
  * @section dependencies Dependencies
  * - Sensor.h for physical sensor integration
  * - LoggerManager.h for event logging
+ * - PointHotStore.h for temperatures, thresholds and status bits
  * 
  * @section hardware Hardware Requirements
  * - Compatible with DS18B20 and PT1000 temperature sensors
@@ -20,29 +21,29 @@
 #include <Arduino.h>
 #include "Sensor.h"
 #include "LoggerManager.h"
+#include "PointHotStore.h"
 
 
 
 /**
  * @brief Logical measurement point for temperature monitoring
  * @details Represents a temperature measurement location with configurable alarm thresholds,
- *          min/max tracking, and optional sensor binding for direct hardware access
+ *          min/max tracking, and optional sensor binding for direct hardware access.
+ *          The object holds the cold data; temperatures, thresholds and status
+ *          bits live in the PointHotStore arrays at index getAddress().
  */
 class MeasurementPoint {
 public:
-    /**
-     * @brief Default constructor
-     * @details Initializes measurement point with default values and safe ranges
-     */
-    MeasurementPoint() : address(0), name(""), currentTemp(0), minTemp(32767), maxTemp(-32768),
-    lowAlarmThreshold(-10), highAlarmThreshold(50), alarmStatus(0), errorStatus(0), boundSensor(nullptr) {}
-    
     /**
      * @brief Constructor with address and name
-     * @param[in] address Unique address for this measurement point (0-255)
+     * @param[in] address Unique address for this measurement point, index into the hot store
      * @param[in] name Human-readable name for the measurement point
+     * @param[in] hot Hot field arrays shared by all points (outlives the point)
      */
-    MeasurementPoint(uint8_t address, const String& name);
+    MeasurementPoint(uint8_t address, const String& name, PointHotStore& hot);
+
+    MeasurementPoint(const MeasurementPoint&) = delete;
+    MeasurementPoint& operator=(const MeasurementPoint&) = delete;
 
     /**
      * @brief Destructor
@@ -95,7 +96,8 @@ public:
     
     /**
      * @brief Get alarm status bits
-     * @return uint8_t Bit field representing active alarms
+     * @return uint8_t POINT_ALARM_LOW / POINT_ALARM_HIGH from the threshold
+     *         kernel, hysteresis included; 0 while the point has an error
      */
     uint8_t getAlarmStatus() const;
     
@@ -124,6 +126,55 @@ public:
      */
     void setHighAlarmThreshold(int16_t threshold);
 
+    /**
+     * @brief Set the hysteresis of the low alarm band
+     * @param[in] hysteresis Degrees above the low threshold that keep a low alarm set
+     * @details Set by the LOW_TEMPERATURE alarm of the point
+     */
+    void setLowAlarmHysteresis(int16_t hysteresis);
+
+    /**
+     * @brief Set the hysteresis of the high alarm band
+     * @param[in] hysteresis Degrees below the high threshold that keep a high alarm set
+     * @details Set by the HIGH_TEMPERATURE alarm of the point
+     */
+    void setHighAlarmHysteresis(int16_t hysteresis);
+
+    /**
+     * @brief Set DS18B20 conversion resolution for this point
+     * @param[in] bits Resolution in bits (9-12)
+     * @details Applied to the bound DS18B20 immediately and on every bind.
+     *          Lower resolutions convert faster and are resampled more often.
+     */
+    void setResolution(uint8_t bits);
+
+    /**
+     * @brief Get DS18B20 conversion resolution for this point
+     * @return uint8_t Resolution in bits (9-12)
+     */
+    uint8_t getResolution() const { return resolution; }
+
+    /**
+     * @brief Set sampling interval limits for this point
+     * @param[in] minMs Shortest interval in ms (0 = SAMPLE_DEFAULT_MIN_PERIOD_MS)
+     * @param[in] maxMs Longest interval in ms (0 = SAMPLE_DEFAULT_MAX_PERIOD_MS)
+     * @details The bound sensor adapts its interval between these limits;
+     *          applied on every bind like the resolution.
+     */
+    void setSamplePeriodLimits(uint32_t minMs, uint32_t maxMs);
+
+    /**
+     * @brief Get configured minimum sampling interval
+     * @return uint32_t Interval in ms, 0 = default
+     */
+    uint32_t getMinSamplePeriod() const { return minSamplePeriodMs; }
+
+    /**
+     * @brief Get configured maximum sampling interval
+     * @return uint32_t Interval in ms, 0 = default
+     */
+    uint32_t getMaxSamplePeriod() const { return maxSamplePeriodMs; }
+
     // Sensor binding (optional)
     /**
      * @brief Bind a physical sensor to this measurement point
@@ -150,34 +201,32 @@ public:
      * @details Refreshes temperature reading and updates alarm/error status
      */
     void update();
-    
+
     /**
      * @brief Reset min/max temperature records
      * @details Sets min/max to current temperature value
      */
     void resetMinMaxTemp();
+
+    /**
+     * @brief Flag the point as changed for change-tracking consumers
+     * @details Setters do this themselves; alarms call it when their own
+     *          configuration changes so the alarm engine re-evaluates the point
+     */
+    void markChanged();
     // void setOneWireBus(uint8_t bus);
     // uint8_t getOneWireBus();
 
 private:
     uint8_t address;             ///< Unique measurement point address
     String name;                 ///< Human-readable measurement point name
+    PointHotStore& hot;          ///< Temperatures, thresholds and status bits
 
-    int16_t currentTemp;         ///< Latest temperature reading (°C)
-    int16_t minTemp;             ///< Minimum recorded temperature
-    int16_t maxTemp;             ///< Maximum recorded temperature
-    int16_t lowAlarmThreshold;   ///< Low temperature alarm threshold
-    int16_t highAlarmThreshold;  ///< High temperature alarm threshold
-    uint8_t alarmStatus;         ///< Bit field for alarm conditions
-    uint8_t errorStatus;         ///< Bit field for error conditions
+    uint8_t resolution;          ///< DS18B20 resolution in bits for the bound sensor
+    uint32_t minSamplePeriodMs;  ///< Shortest sampling interval, 0 = default
+    uint32_t maxSamplePeriodMs;  ///< Longest sampling interval, 0 = default
 
     Sensor* boundSensor;         ///< Pointer to bound physical sensor
-
-    /**
-     * @brief Update alarm status based on current temperature
-     * @details Internal method to evaluate alarm conditions and update status bits
-     */
-    void updateAlarmStatus();
 };
 
 
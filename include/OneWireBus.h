@@ -0,0 +1,71 @@
+/**
+ * @file OneWireBus.h
+ * @brief Hardware OneWire bus backend with bus-level locking
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Owns the single OneWire and DallasTemperature instance for one GPIO
+ *          and serializes every transaction on it. All DS18B20 sensors on the
+ *          bus reference this object (through OneWireInterface) instead of
+ *          creating their own drivers.
+ * 
+ * @section dependencies Dependencies
+ * - SensorBus.h for the interface
+ * - OneWire library for bus signalling
+ * - DallasTemperature for DS18B20 commands
+ * - FreeRTOS semaphores for bus arbitration
+ * 
+ * @section hardware Hardware Requirements
+ * - One GPIO per bus with external pull-up resistor
+ */
+
+#ifndef ONE_WIRE_BUS_H
+#define ONE_WIRE_BUS_H
+
+#include <Arduino.h>
+#include <OneWire.h>
+#include <DallasTemperature.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "SensorBus.h"
+
+/**
+ * @class OneWireBus
+ * @brief One physical OneWire bus shared by all sensors attached to it
+ * @details Callers must hold the bus lock for the duration of any transaction.
+ *          The lock is recursive so a sweep can hold it across several sensor
+ *          reads.
+ */
+class OneWireBus : public OneWireInterface {
+public:
+    /**
+     * @brief Construct a bus driver for a GPIO pin
+     * @param[in] pin GPIO pin of the bus
+     */
+    explicit OneWireBus(uint8_t pin);
+
+    /**
+     * @brief Destroy the bus driver and release its drivers and lock
+     */
+    ~OneWireBus() override;
+
+    uint8_t getPin() const override { return _pin; }
+    void lock() override;
+    void unlock() override;
+    bool begin() override;
+    bool convertAll() override;
+    bool convert(const uint8_t* rom) override;
+    bool readScratchPad(const uint8_t* rom, uint8_t* scratchPad) override;
+    bool writeScratchPad(const uint8_t* rom, const uint8_t* scratchPad) override;
+    bool setResolution(const uint8_t* rom, uint8_t bits) override;
+    bool isConnected(const uint8_t* rom) override;
+    void resetSearch() override;
+    bool search(uint8_t* rom, bool alarmOnly = false) override;
+
+private:
+    uint8_t _pin;                   ///< Bus GPIO pin
+    OneWire* _wire;                 ///< Shared OneWire driver
+    DallasTemperature* _dallas;     ///< Shared DallasTemperature driver
+    SemaphoreHandle_t _mutex;       ///< Recursive bus lock
+};
+
+#endif // ONE_WIRE_BUS_H
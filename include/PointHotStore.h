@@ -0,0 +1,236 @@
+/**
+ * @file PointHotStore.h
+ * @brief Structure-of-arrays storage for the per-cycle fields of measurement points
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Applying a sweep, refreshing the register map, writing the log row
+ *          and evaluating alarms touch only a few small fields per point. They
+ *          live here in parallel arrays indexed by point address, so those
+ *          loops stream through a few kilobytes of internal RAM instead of
+ *          striding over MeasurementPoint objects with their String names.
+ *          MeasurementPoint keeps the cold data (name, resolution, sampling
+ *          limits, bound sensor) and reads its hot fields from this store.
+ *
+ *          Change tracking: every change of a value, error state, threshold
+ *          or point configuration advances a global sequence number and
+ *          stamps the point with it. Consumers (register map, alarm engine,
+ *          web API) remember the sequence they last consumed and visit only
+ *          points with a newer stamp, so an unchanged sweep costs one
+ *          comparison per point.
+ *
+ *          Alarm bits come from the batch threshold kernel (ThresholdKernel.h)
+ *          run over the whole store whenever a value, threshold or hysteresis
+ *          changes; the low/high/error bitmasks are the single source for the
+ *          alarm engine, the register map and the web API.
+ *
+ * @section dependencies Dependencies
+ * - PointSnapshot.h for PointSample
+ * - ThresholdKernel.h for alarm evaluation
+ * - <stdlib.h>; no Arduino headers
+ */
+
+#ifndef POINT_HOT_STORE_H
+#define POINT_HOT_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "PointSnapshot.h"
+#include "ThresholdKernel.h"
+
+constexpr uint8_t POINT_ALARM_LOW = THRESHOLD_BIT_LOW;     ///< Alarm bit: at or below low threshold
+constexpr uint8_t POINT_ALARM_HIGH = THRESHOLD_BIT_HIGH;   ///< Alarm bit: at or above high threshold
+constexpr uint8_t POINT_ERROR_UNBOUND = 0x01;              ///< Error bits of a point without sensor
+constexpr int16_t POINT_DEFAULT_HYSTERESIS = 1;            ///< Alarm hysteresis until an alarm sets it
+
+/**
+ * @class PointHotStore
+ * @brief Parallel arrays of point temperatures, thresholds and status bits
+ * @details Arrays are public for batch loops; all have size() entries and
+ *          share one internal-RAM block.
+ */
+class PointHotStore {
+public:
+    int16_t* current = nullptr;         ///< Latest temperature (°C)
+    int16_t* minTemp = nullptr;         ///< Minimum since reset
+    int16_t* maxTemp = nullptr;         ///< Maximum since reset
+    int16_t* lowThreshold = nullptr;    ///< Low alarm threshold
+    int16_t* highThreshold = nullptr;   ///< High alarm threshold
+    int16_t* lowHysteresis = nullptr;   ///< Low alarm hysteresis
+    int16_t* highHysteresis = nullptr;  ///< High alarm hysteresis
+    uint8_t* errorBits = nullptr;       ///< Sensor error bits, POINT_ERROR_UNBOUND if unbound
+    uint8_t* bound = nullptr;           ///< 1 if a sensor is bound
+    uint32_t* changedAt = nullptr;      ///< Sequence number of the last change
+    ThresholdMasks masks = {};          ///< Kernel output, thresholdMaskWords(size()) words each
+
+    PointHotStore() {}
+    ~PointHotStore() { free(_block); }
+
+    PointHotStore(const PointHotStore&) = delete;
+    PointHotStore& operator=(const PointHotStore&) = delete;
+
+    /**
+     * @brief Allocate and reset all arrays
+     * @param[in] count Number of points
+     * @param[in] sequence Sequence to continue from; all points are stamped
+     *            sequence + 1 so every consumer sees them as changed
+     * @return false if memory ran out (the store is unchanged)
+     */
+    bool allocate(uint16_t count, uint32_t sequence = 0) {
+        const uint16_t maskWords = thresholdMaskWords(count);
+        const size_t stamps = sizeof(uint32_t) * (count + 3 * maskWords);
+        const size_t words = sizeof(int16_t) * count;
+        const size_t bytes = count;
+        uint8_t* block = static_cast<uint8_t*>(calloc(1, stamps + 7 * words + 2 * bytes + 1));
+        if (block == nullptr) return false;
+        free(_block);
+        _block = block;
+        _count = count;
+        changedAt = reinterpret_cast<uint32_t*>(block);
+        masks.low = changedAt + count;
+        masks.high = masks.low + maskWords;
+        masks.error = masks.high + maskWords;
+        current = reinterpret_cast<int16_t*>(block + stamps);
+        minTemp = current + count;
+        maxTemp = minTemp + count;
+        lowThreshold = maxTemp + count;
+        highThreshold = lowThreshold + count;
+        lowHysteresis = highThreshold + count;
+        highHysteresis = lowHysteresis + count;
+        errorBits = block + stamps + 7 * words;
+        bound = errorBits + count;
+        _sequence = sequence;
+        for (uint16_t i = 0; i < count; ++i) {
+            minTemp[i] = 32767;
+            maxTemp[i] = -32768;
+            lowThreshold[i] = -10;
+            highThreshold[i] = 50;
+            lowHysteresis[i] = POINT_DEFAULT_HYSTERESIS;
+            highHysteresis[i] = POINT_DEFAULT_HYSTERESIS;
+        }
+        evaluateAlarms();
+        markAllChanged();
+        return true;
+    }
+
+    /**
+     * @brief Exchange contents with another store
+     * @param[in,out] other Store to swap with
+     */
+    void swap(PointHotStore& other) {
+        PointHotStore tmp;
+        tmp._take(*this);
+        _take(other);
+        other._take(tmp);
+    }
+
+    /**
+     * @brief Number of points
+     * @return uint16_t Entries per array
+     */
+    uint16_t size() const { return _count; }
+
+    /**
+     * @brief Sequence number of the latest change
+     * @return uint32_t Advances by one per change event, 0 before the first
+     */
+    uint32_t getSequence() const { return _sequence; }
+
+    /**
+     * @brief Check whether a point changed after a consumed sequence
+     * @param[in] i Point address
+     * @param[in] since Sequence the consumer has already processed
+     * @return true if the point has a newer stamp
+     */
+    bool changedSince(uint16_t i, uint32_t since) const { return changedAt[i] > since; }
+
+    /**
+     * @brief Record a change of one point (threshold, binding, configuration)
+     * @param[in] i Point address
+     */
+    void markChanged(uint16_t i) { changedAt[i] = ++_sequence; }
+
+    /**
+     * @brief Record a change of every point
+     */
+    void markAllChanged() {
+        ++_sequence;
+        for (uint16_t i = 0; i < _count; ++i) changedAt[i] = _sequence;
+    }
+
+    /**
+     * @brief Recompute the alarm bitmasks of all points
+     * @details One pass of the threshold kernel; call after values,
+     *          thresholds or hysteresis changed.
+     */
+    void evaluateAlarms() {
+        if (_count == 0) return;
+        ThresholdArrays in = { current, lowThreshold, highThreshold,
+                               lowHysteresis, highHysteresis, errorBits, _count };
+        evaluateThresholds(in, masks);
+    }
+
+    /**
+     * @brief Alarm bits of one point from the last evaluation
+     * @param[in] i Point address
+     * @return uint8_t POINT_ALARM_* bits, 0 while the point has an error
+     */
+    uint8_t alarmStatus(uint16_t i) const { return thresholdMaskBits(masks, i); }
+
+    /**
+     * @brief Apply a published sweep to every point
+     * @param[in] samples size() samples from PointSnapshot::read()
+     * @return uint16_t Number of points whose value, error or binding changed;
+     *         they share one new sequence number
+     */
+    uint16_t applySamples(const PointSample* samples) {
+        uint16_t changed = 0;
+        for (uint16_t i = 0; i < _count; ++i) {
+            const PointSample& s = samples[i];
+            const uint8_t error = s.bound ? s.errorStatus : POINT_ERROR_UNBOUND;
+            const bool differs = bound[i] != s.bound || errorBits[i] != error ||
+                                 (s.bound && current[i] != s.currentTemp);
+            if (!differs) continue;
+            bound[i] = s.bound;
+            errorBits[i] = error;
+            if (s.bound) {
+                current[i] = s.currentTemp;
+                if (s.currentTemp < minTemp[i]) minTemp[i] = s.currentTemp;
+                if (s.currentTemp > maxTemp[i]) maxTemp[i] = s.currentTemp;
+            }
+            if (changed++ == 0) ++_sequence;
+            changedAt[i] = _sequence;
+        }
+        if (changed) evaluateAlarms();
+        return changed;
+    }
+
+    /**
+     * @brief Restart min/max tracking at the current values
+     */
+    void resetMinMax() {
+        for (uint16_t i = 0; i < _count; ++i) {
+            minTemp[i] = current[i];
+            maxTemp[i] = current[i];
+        }
+        markAllChanged();
+    }
+
+private:
+    void _take(PointHotStore& other) {
+        current = other.current; minTemp = other.minTemp; maxTemp = other.maxTemp;
+        lowThreshold = other.lowThreshold; highThreshold = other.highThreshold;
+        lowHysteresis = other.lowHysteresis; highHysteresis = other.highHysteresis;
+        errorBits = other.errorBits; bound = other.bound;
+        changedAt = other.changedAt; masks = other.masks;
+        _block = other._block; _count = other._count; _sequence = other._sequence;
+        other._block = nullptr;
+        other._count = 0;
+    }
+
+    uint8_t* _block = nullptr;  ///< Backing allocation of all arrays
+    uint16_t _count = 0;        ///< Entries per array
+    uint32_t _sequence = 0;     ///< Latest change sequence
+};
+
+#endif // POINT_HOT_STORE_H
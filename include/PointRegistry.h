@@ -0,0 +1,144 @@
+/**
+ * @file PointRegistry.h
+ * @brief Measurement point table sized at startup and held in PSRAM
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Replaces the fixed dsPoints[50] / ptPoints[10] arrays. The table is
+ *          one contiguous block: DS18B20 points take addresses 0..ds-1, PT1000
+ *          points follow at ds..ds+pt-1. With the default 50 + 10 layout every
+ *          address is the same as before.
+ *
+ *          Temperatures, thresholds and status bits of all points are kept
+ *          apart in a PointHotStore in internal RAM; the MeasurementPoint
+ *          table holds the cold data.
+ *
+ *          Addresses stay uint8_t (alarm keys, CSV import, web API), so a
+ *          registry holds at most POINT_REGISTRY_MAX_POINTS points.
+ *
+ * @section dependencies Dependencies
+ * - MeasurementPoint.h for the point class
+ * - PointHotStore.h for the hot field arrays
+ * - ExternalMemory.h for PSRAM allocation
+ */
+
+#ifndef POINT_REGISTRY_H
+#define POINT_REGISTRY_H
+
+#include <Arduino.h>
+#include "MeasurementPoint.h"
+
+constexpr uint16_t POINT_REGISTRY_MAX_POINTS = 250; ///< Upper bound for DS18B20 + PT1000 points
+constexpr uint8_t DEFAULT_DS18B20_POINTS = 50;      ///< DS18B20 points when none are configured
+constexpr uint8_t DEFAULT_PT1000_POINTS = 10;       ///< PT1000 points when none are configured
+
+/**
+ * @class PointRegistry
+ * @brief Owns the measurement points of the controller
+ */
+class PointRegistry {
+public:
+    PointRegistry();
+    ~PointRegistry();
+
+    PointRegistry(const PointRegistry&) = delete;
+    PointRegistry& operator=(const PointRegistry&) = delete;
+
+    /**
+     * @brief (Re)create the point table
+     * @param[in] dsCount Number of DS18B20 points
+     * @param[in] ptCount Number of PT1000 points
+     * @return false if the counts exceed POINT_REGISTRY_MAX_POINTS or memory ran out
+     *         (the previous table is kept)
+     * @note Existing points are destroyed; callers unbind sensors first.
+     */
+    bool allocate(uint8_t dsCount, uint8_t ptCount);
+
+    /**
+     * @brief Number of allocated points
+     * @return uint16_t DS18B20 + PT1000 points
+     */
+    uint16_t size() const { return _count; }
+
+    /**
+     * @brief Number of DS18B20 points
+     * @return uint8_t Count, also the first PT1000 address
+     */
+    uint8_t getDS18B20Count() const { return _dsCount; }
+
+    /**
+     * @brief Number of PT1000 points
+     * @return uint8_t Count
+     */
+    uint8_t getPT1000Count() const { return _ptCount; }
+
+    /**
+     * @brief Address of the first PT1000 point
+     * @return uint8_t Equal to getDS18B20Count()
+     */
+    uint8_t getPT1000Base() const { return _dsCount; }
+
+    /**
+     * @brief Check for a DS18B20 point address
+     * @param[in] address Point address
+     * @return true if 0 <= address < DS18B20 count
+     */
+    bool isDS18B20Address(uint8_t address) const { return address < _dsCount; }
+
+    /**
+     * @brief Check for a PT1000 point address
+     * @param[in] address Point address
+     * @return true if the address falls in the PT1000 range
+     */
+    bool isPT1000Address(uint8_t address) const { return address >= _dsCount && address < _count; }
+
+    /**
+     * @brief Look up a point
+     * @param[in] address Point address
+     * @return MeasurementPoint* Point or nullptr if not allocated
+     */
+    MeasurementPoint* get(uint8_t address) { return address < _count ? &_points[address] : nullptr; }
+
+    /**
+     * @brief Unchecked access by address
+     * @param[in] address Point address, < size()
+     * @return MeasurementPoint& Point
+     */
+    MeasurementPoint& operator[](uint16_t address) { return _points[address]; }
+    const MeasurementPoint& operator[](uint16_t address) const { return _points[address]; }
+
+    MeasurementPoint* begin() { return _points; }
+    MeasurementPoint* end() { return _points + _count; }
+    const MeasurementPoint* begin() const { return _points; }
+    const MeasurementPoint* end() const { return _points + _count; }
+
+    /**
+     * @brief Hot field arrays of all points
+     * @return PointHotStore& Arrays indexed by point address, size() entries
+     */
+    PointHotStore& hot() { return _hot; }
+    const PointHotStore& hot() const { return _hot; }
+
+    /**
+     * @brief Check where the table lives
+     * @return true if the table is in PSRAM
+     */
+    bool isExternal() const { return _external; }
+
+    /**
+     * @brief Size of the point table
+     * @return size_t Bytes, excluding heap-allocated names
+     */
+    size_t getBytes() const { return sizeof(MeasurementPoint) * _count; }
+
+private:
+    void _release();
+
+    PointHotStore _hot;         ///< Hot fields, indexed by address
+    MeasurementPoint* _points;  ///< Contiguous table, placement-constructed
+    uint8_t _dsCount;           ///< DS18B20 points
+    uint8_t _ptCount;           ///< PT1000 points
+    uint16_t _count;            ///< Total points
+    bool _external;             ///< Table is in PSRAM
+};
+
+#endif // POINT_REGISTRY_H
@@ -0,0 +1,136 @@
+/**
+ * @file PointSnapshot.h
+ * @brief Double-buffered measurement point snapshot
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Hands completed acquisition sweeps from the acquisition task to the
+ *          Arduino loop task without locks. The writer fills the back buffer
+ *          and publishes it by bumping a sequence counter; readers copy the
+ *          front buffer and retry if a publish happened during the copy.
+ *
+ *          Buffers are sized by allocate() to the configured point count and
+ *          placed in PSRAM when available.
+ *
+ * @section dependencies Dependencies
+ * - <atomic> for the publish sequence counter
+ * - ExternalMemory.h for the sample buffers
+ *
+ * @section usage Usage
+ * - allocate() before the acquisition task starts
+ * - Exactly one writer (acquisition task) calls beginWrite()/publish()
+ * - Any number of readers call read()
+ */
+
+#ifndef POINT_SNAPSHOT_H
+#define POINT_SNAPSHOT_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <utility>
+#include "ExternalMemory.h"
+
+/**
+ * @struct PointSample
+ * @brief Acquired state of one measurement point
+ */
+struct PointSample {
+    int16_t currentTemp;    ///< Temperature in °C (integer)
+    uint8_t errorStatus;    ///< Error bits of the bound sensor, 0x01 if unbound
+    uint8_t bound;          ///< 1 if a sensor was bound when the sweep was published
+};
+
+/**
+ * @class PointSnapshot
+ * @brief Single-writer, lock-free double buffer of point samples
+ */
+class PointSnapshot {
+public:
+    PointSnapshot() : _buffers{nullptr, nullptr}, _capacity(0), _sequence(0) {}
+
+    ~PointSnapshot() { externalFree(_buffers[0]); }
+
+    PointSnapshot(const PointSnapshot&) = delete;
+    PointSnapshot& operator=(const PointSnapshot&) = delete;
+
+    /**
+     * @brief Size both buffers and clear them
+     * @param[in] capacity Number of points per snapshot
+     * @return false if memory ran out (the previous buffers are kept)
+     * @note Not safe while a writer or reader is active.
+     */
+    bool allocate(uint16_t capacity) {
+        PointSample* block = static_cast<PointSample*>(
+            externalAlloc(sizeof(PointSample) * 2 * (capacity ? capacity : 1)));
+        if (block == nullptr) return false;
+        externalFree(_buffers[0]);
+        _buffers[0] = block;
+        _buffers[1] = block + capacity;
+        _capacity = capacity;
+        _sequence.store(0, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Exchange buffers with another snapshot; both restart at sequence 0
+     * @param[in,out] other Snapshot to swap with
+     * @note Not safe while a writer or reader is active.
+     */
+    void swap(PointSnapshot& other) {
+        std::swap(_buffers[0], other._buffers[0]);
+        std::swap(_buffers[1], other._buffers[1]);
+        std::swap(_capacity, other._capacity);
+        _sequence.store(0, std::memory_order_release);
+        other._sequence.store(0, std::memory_order_release);
+    }
+
+    /**
+     * @brief Number of points per snapshot
+     * @return uint16_t Capacity set by allocate()
+     */
+    uint16_t getCapacity() const { return _capacity; }
+
+    /**
+     * @brief Get the back buffer for the writer to fill
+     * @return PointSample* Array of getCapacity() samples
+     */
+    PointSample* beginWrite() {
+        return _buffers[(_sequence.load(std::memory_order_relaxed) + 1) & 1];
+    }
+
+    /**
+     * @brief Make the back buffer visible to readers
+     */
+    void publish() {
+        _sequence.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy the latest published snapshot
+     * @param[out] out Array of getCapacity() samples
+     * @return uint32_t Sequence number of the copied snapshot (0 = nothing published yet)
+     * @note Retries if the writer published during the copy; sweeps are seconds
+     *       apart so a retry is rare.
+     */
+    uint32_t read(PointSample* out) const {
+        for (;;) {
+            uint32_t before = _sequence.load(std::memory_order_acquire);
+            memcpy(out, _buffers[before & 1], sizeof(PointSample) * _capacity);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_sequence.load(std::memory_order_relaxed) == before) return before;
+        }
+    }
+
+    /**
+     * @brief Get sequence number of the latest published snapshot
+     * @return uint32_t Number of publishes since start
+     */
+    uint32_t getSequence() const { return _sequence.load(std::memory_order_acquire); }
+
+private:
+    PointSample* _buffers[2];           ///< Front/back sample buffers (one block)
+    uint16_t _capacity;                 ///< Samples per buffer
+    std::atomic<uint32_t> _sequence;    ///< Publish count; parity selects the front buffer
+};
+
+#endif // POINT_SNAPSHOT_H
@@ -12,7 +12,7 @@
  * 
  * @section hardware Hardware Requirements
  * - Modbus RTU/TCP communication interface
- * - Support for 60 total measurement points (50 DS18B20 + 10 PT1000)
+ * - Point count set at startup (default 50 DS18B20 + 10 PT1000, up to 250)
  * 
  * @section register_layout Register Layout
  * - 0-99: Device Information (ID, version, status)
@@ -27,6 +27,11 @@
  * - 860-869: Relay control
  * - 870-889: Hysteresis configuration
  * - 899: Command register
+ * - 1000 + field * 256 + address: every allocated point, field order as above
+ *   (current, min, max, alarm status, error status, low, high, alarm config)
+ *
+ * The 100-859 windows address points directly by point address and only
+ * reach the first 100 (alarm config: 60) points; the 1000+ block covers all.
  */
 
 #ifndef REGISTER_MAP_H
@@ -35,6 +40,22 @@
 #include <stdint.h>
 #include "MeasurementPoint.h"
 
+/**
+ * @enum PointRegisterField
+ * @brief Per-point register arrays, in extended block order
+ */
+enum PointRegisterField : uint8_t {
+    POINT_FIELD_CURRENT = 0,        ///< Current temperature
+    POINT_FIELD_MIN,                ///< Minimum temperature
+    POINT_FIELD_MAX,                ///< Maximum temperature
+    POINT_FIELD_ALARM_STATUS,       ///< Alarm status flags
+    POINT_FIELD_ERROR_STATUS,       ///< Error status flags
+    POINT_FIELD_LOW_ALARM,          ///< Low alarm threshold (writable)
+    POINT_FIELD_HIGH_ALARM,         ///< High alarm threshold (writable)
+    POINT_FIELD_ALARM_CONFIG,       ///< Alarm enable/priority bits (writable)
+    POINT_FIELD_COUNT               ///< Number of per-point fields
+};
+
 /**
  * @class RegisterMap
  * @brief Manages Modbus register mapping for temperature monitoring
@@ -52,19 +73,13 @@ private:
     uint16_t deviceStatus[7];             ///< Device status flags (registers 4-10)
     uint16_t relayStatus[3];              ///< Relay status (registers 11-13) bit0: commanded, bit1: actual
 
-    // Temperature Data Registers (100-599)
-    int16_t currentTemps[60];             ///< Current temperature values (registers 100-159)
-    int16_t minTemps[60];                 ///< Minimum temperature values (registers 200-259)
-    int16_t maxTemps[60];                 ///< Maximum temperature values (registers 300-359)
-    uint16_t alarmStatus[60];             ///< Alarm status flags (registers 400-459)
-    uint16_t errorStatus[60];             ///< Error status flags (registers 500-559)
-
-    // Configuration Registers (600-799)
-    int16_t lowAlarmThresholds[60];      ///< Low temperature alarm thresholds (registers 600-659)
-    int16_t highAlarmThresholds[60];     ///< High temperature alarm thresholds (registers 700-759)
+    // Per-point registers, one block of POINT_FIELD_COUNT arrays sized by allocatePoints()
+    uint16_t* pointRegisters;             ///< Field-major storage, in PSRAM when available
+    uint16_t pointCount;                  ///< Allocated points
+    uint16_t pointSequence;               ///< Change sequence of the last updateFromHotStore()
+    uint8_t pt1000Base;                   ///< Address of the first PT1000 point
 
     // Alarm Control Registers (800-899)
-    uint16_t alarmConfig[60];             ///< Alarm configuration (enable flags and priorities) (registers 800-859)
     uint16_t relayControl[6];             ///< Relay control and status (registers 860-865)
     uint16_t hysteresis[20];              ///< Hysteresis values (registers 870-889)
     uint16_t commandRegister;             ///< Command execution register (register 899)
@@ -85,12 +100,66 @@ private:
      */
     bool isReadOnlyRegister(uint16_t address);
 
+    /**
+     * @brief Map a register address to a per-point field
+     * @param[in] address Register address
+     * @param[out] field Point field
+     * @param[out] index Point address
+     * @return true if the address selects an allocated point
+     */
+    bool decodePointRegister(uint16_t address, uint8_t& field, uint16_t& index) const;
+
+    /**
+     * @brief Access one per-point register
+     * @param[in] field Point field
+     * @param[in] index Point address, < pointCount
+     * @return uint16_t& Register storage
+     */
+    uint16_t& pointRegister(uint8_t field, uint16_t index) const {
+        return pointRegisters[(uint32_t)field * pointCount + index];
+    }
+
 public:
     /**
      * @brief Construct a new Register Map object
      * @details Initializes all registers to default values
      */
     RegisterMap();
+    ~RegisterMap();
+
+    RegisterMap(const RegisterMap&) = delete;
+    RegisterMap& operator=(const RegisterMap&) = delete;
+
+    /**
+     * @brief Size the per-point registers and reset them to defaults
+     * @param[in] count Number of points
+     * @param[in] ptBase Address of the first PT1000 point
+     * @return false if memory ran out (the previous table is kept)
+     */
+    bool allocatePoints(uint16_t count, uint8_t ptBase);
+
+    /**
+     * @brief Allocate per-point register storage without installing it
+     * @param[in] count Number of points
+     * @return uint16_t* Block for adoptPoints() (release with externalFree()), nullptr if memory ran out
+     * @details Lets a caller stage every table of a new point layout before
+     *          replacing any of the current ones.
+     */
+    static uint16_t* allocatePointBlock(uint16_t count);
+
+    /**
+     * @brief Install a block from allocatePointBlock() and reset it to defaults
+     * @param[in] block Register block, owned by the map afterwards
+     * @param[in] count Number of points the block was allocated for
+     * @param[in] ptBase Address of the first PT1000 point
+     */
+    void adoptPoints(uint16_t* block, uint16_t count, uint8_t ptBase);
+
+    /**
+     * @brief Number of points covered by the map
+     * @return uint16_t Allocated points
+     */
+    uint16_t getPointCount() const { return pointCount; }
 
     // Register read/write
     /**
@@ -117,6 +186,15 @@ public:
      */
     void updateFromMeasurementPoint(const MeasurementPoint& point);
 
+    /**
+     * @brief Update the registers of changed points from the hot store
+     * @param[in] hot Hot field arrays of the controller
+     * @param[in] since Change sequence already copied (0 = copy every point)
+     * @details Same registers as updateFromMeasurementPoint(), for the first
+     *          min(pointCount, hot.size()) points stamped after @p since
+     */
+    void updateFromHotStore(const PointHotStore& hot, uint32_t since = 0);
+
     // Apply config (thresholds) to and from measurement points
     /**
      * @brief Apply configuration from registers to measurement point
@@ -177,6 +255,16 @@ public:
      */
     uint16_t getNumActivePT1000() const { return numActivePT1000; }
 
+    /**
+     * @brief Set a device status / diagnostics register
+     * @param[in] address Register address (DEVICE_STATUS_START_REG..DEVICE_STATUS_END_REG)
+     * @param[in] value Register value
+     */
+    void setDeviceStatus(uint16_t address, uint16_t value) {
+        if (address >= DEVICE_STATUS_START_REG && address <= DEVICE_STATUS_END_REG)
+            deviceStatus[address - DEVICE_STATUS_START_REG] = value;
+    }
+
     /**
      * @brief Check if a command is pending execution
      * @return true if command needs to be processed
@@ -196,7 +284,7 @@ public:
     
     /**
      * @brief Get alarm configuration for a point
-     * @param[in] pointIndex Point index (0-59)
+     * @param[in] pointIndex Point address
      * @return uint16_t Alarm configuration register value
      */
     uint16_t getAlarmConfig(uint8_t pointIndex) const;
@@ -250,8 +338,18 @@ public:
     static const uint16_t NUM_PT1000_REG = 3;            ///< Active PT1000 count register
     static const uint16_t DEVICE_STATUS_START_REG = 4;   ///< Device status start register
     static const uint16_t DEVICE_STATUS_END_REG = 10;    ///< Device status end register
+    static const uint16_t HEALTH_QUARANTINED_REG = 4;    ///< Sensors in quarantine
+    static const uint16_t HEALTH_SENSOR_ERRORS_REG = 5;  ///< Sensors with any error bit set
+    static const uint16_t HEALTH_CRC_ERRORS_REG = 6;     ///< Scratchpad CRC failures since boot (saturating)
+    static const uint16_t HEALTH_TIMEOUTS_REG = 7;       ///< Unanswered reads since boot (saturating)
+    static const uint16_t HEALTH_SWEEP_MS_REG = 8;       ///< Longest last bus sweep in ms
+    static const uint16_t HEALTH_READ_P95_US_REG = 9;    ///< 95th percentile read latency in µs (saturating)
+    static const uint16_t HEALTH_STALEST_S_REG = 10;     ///< Seconds since the stalest bound sensor read OK
     static const uint16_t RELAY_STATUS_REG_START = 11;   ///< Relay status registers start
     static const uint16_t RELAY_STATUS_REG_END = 13;     ///< Relay status registers end
+    static const uint16_t POINT_COUNT_REG = 14;          ///< Allocated measurement points
+    static const uint16_t PT1000_BASE_REG = 15;          ///< Address of the first PT1000 point
+    static const uint16_t POINT_SEQUENCE_REG = 16;       ///< Low 16 bits of the point change sequence
     
     // Current Temperature Registers (100-199)
     static const uint16_t CURRENT_TEMP_DS18B20_START_REG = 100;  ///< DS18B20 current temp start
@@ -312,6 +410,11 @@ public:
     
     // Command Register
     static const uint16_t COMMAND_REG = 899;                      ///< Command execution register
+
+    // Extended per-point block (1000 + field * 256 + point address)
+    static const uint16_t POINT_BLOCK_START_REG = 1000;           ///< First extended point register
+    static const uint16_t POINT_BLOCK_STRIDE = 256;               ///< Registers per field
+    static const uint16_t LEGACY_POINT_WINDOW = 100;              ///< Points reachable in the 100-799 windows
     
     // Alarm Configuration Bit Masks
     static const uint16_t ALARM_CONFIG_LOW_ENABLE_BIT = 0x0001;   ///< Bit 0: Low temp alarm enable
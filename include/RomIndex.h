@@ -0,0 +1,169 @@
+/**
+ * @file RomIndex.h
+ * @brief Fixed-size open-addressing index keyed by 64-bit OneWire ROM
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Replaces linear scans that compared 16-character ROM strings. The
+ *          8 ROM bytes are packed into one uint64_t key (byte 0, the family
+ *          code, in the low bits); slots are found by Fibonacci hashing and
+ *          linear probing, and removals shift followers back so no tombstones
+ *          accumulate. Storage is a fixed array: no heap use after construction.
+ *
+ * @section dependencies Dependencies
+ * - <stdint.h> only; the header builds on the host for tests
+ */
+
+#ifndef ROM_INDEX_H
+#define ROM_INDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @class RomIndex
+ * @brief ROM key to object pointer map
+ * @tparam V Value type (stored by pointer, not owned)
+ * @tparam N Slot count, a power of two; at most 3/4 of it can be filled
+ */
+template <typename V, size_t N>
+class RomIndex {
+    static_assert(N >= 4 && (N & (N - 1)) == 0, "RomIndex size must be a power of two");
+
+public:
+    RomIndex() { clear(); }
+
+    /**
+     * @brief Pack a ROM into a key
+     * @param[in] rom 8-byte ROM as read from the bus
+     * @return uint64_t Key, byte 0 in the low bits
+     */
+    static uint64_t romKey(const uint8_t* rom) {
+        uint64_t key = 0;
+        for (int i = 7; i >= 0; --i) key = (key << 8) | rom[i];
+        return key;
+    }
+
+    /**
+     * @brief Parse a 16-digit hex ROM string into a key
+     * @param[in] hex ROM as printed by Sensor::getDS18B20RomString()
+     * @param[out] key Packed key
+     * @return false if the string is not exactly 16 hex digits
+     */
+    static bool romKeyFromHex(const char* hex, uint64_t& key) {
+        uint8_t rom[8];
+        for (int i = 0; i < 16; ++i) {
+            char c = hex[i];
+            uint8_t nibble;
+            if (c >= '0' && c <= '9') nibble = c - '0';
+            else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
+            else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+            else return false;
+            rom[i / 2] = (i & 1) ? (uint8_t)((rom[i / 2] << 4) | nibble) : nibble;
+        }
+        if (hex[16] != '\0') return false;
+        key = romKey(rom);
+        return true;
+    }
+
+    /**
+     * @brief Insert or replace an entry
+     * @param[in] key ROM key
+     * @param[in] value Object pointer (non-null)
+     * @return false if the index is full (3/4 load) and the key is new
+     */
+    bool insert(uint64_t key, V* value) {
+        size_t slot = _home(key);
+        while (_values[slot] != nullptr) {
+            if (_keys[slot] == key) {
+                _values[slot] = value;
+                return true;
+            }
+            slot = (slot + 1) & (N - 1);
+        }
+        if (_count >= N - N / 4) return false;
+        _keys[slot] = key;
+        _values[slot] = value;
+        _count++;
+        return true;
+    }
+
+    /**
+     * @brief Look up an entry
+     * @param[in] key ROM key
+     * @return V* Stored pointer or nullptr
+     */
+    V* find(uint64_t key) const {
+        size_t slot = _home(key);
+        while (_values[slot] != nullptr) {
+            if (_keys[slot] == key) return _values[slot];
+            slot = (slot + 1) & (N - 1);
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Remove an entry
+     * @param[in] key ROM key
+     * @return false if the key was not present
+     */
+    bool erase(uint64_t key) {
+        size_t slot = _home(key);
+        while (_values[slot] != nullptr && _keys[slot] != key)
+            slot = (slot + 1) & (N - 1);
+        if (_values[slot] == nullptr) return false;
+
+        // Backward-shift: move later entries of the probe run into the hole
+        size_t hole = slot;
+        size_t next = (hole + 1) & (N - 1);
+        while (_values[next] != nullptr) {
+            size_t home = _home(_keys[next]);
+            // Entry may move only if its home is not cyclically in (hole, next]
+            bool movable = (hole <= next) ? (home <= hole || home > next)
+                                          : (home <= hole && home > next);
+            if (movable) {
+                _keys[hole] = _keys[next];
+                _values[hole] = _values[next];
+                hole = next;
+            }
+            next = (next + 1) & (N - 1);
+        }
+        _values[hole] = nullptr;
+        _count--;
+        return true;
+    }
+
+    /**
+     * @brief Remove all entries
+     */
+    void clear() {
+        for (size_t i = 0; i < N; ++i) {
+            _keys[i] = 0;
+            _values[i] = nullptr;
+        }
+        _count = 0;
+    }
+
+    /**
+     * @brief Number of entries
+     * @return size_t Stored keys
+     */
+    size_t size() const { return _count; }
+
+    /**
+     * @brief Largest number of entries accepted
+     * @return size_t 3/4 of the slot count
+     */
+    static constexpr size_t capacity() { return N - N / 4; }
+
+private:
+    static size_t _home(uint64_t key) {
+        // Fibonacci hashing; the ROM serial is random but the family byte is not
+        return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & (N - 1);
+    }
+
+    uint64_t _keys[N];   ///< Packed ROM per slot
+    V* _values[N];       ///< Object per slot, nullptr = empty
+    size_t _count;       ///< Occupied slots
+};
+
+#endif // ROM_INDEX_H
@@ -0,0 +1,141 @@
+/**
+ * @file RtdConversion.h
+ * @brief Fixed-point RTD-to-temperature conversion
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Maps the raw 15-bit MAX31865 RTD code straight to temperature
+ *          through a piecewise-linear table of the inverse Callendar-Van Dusen
+ *          curve. The table is indexed by the resistance ratio R/R0, so one
+ *          table serves PT100 and PT1000; the per-channel reference resistor
+ *          and the nominal resistance are folded into a single Q16 scale.
+ *
+ *          The table is generated by the compiler (constexpr, C++11 rules),
+ *          so nothing is computed at boot and no floating point is used per
+ *          read. Segments are 1/32 of R0 wide; results stay within 0.01 °C of
+ *          the floating-point solver over -40..200 °C
+ *          (test/rtd_conversion_test.cpp).
+ *
+ * @section dependencies Dependencies
+ * - <stdint.h> only; the header builds on the host for tests
+ *
+ * @section usage Usage
+ * - uint32_t scale = rtdScaleQ16(4300.0, 1000.0);   // once per channel
+ * - int32_t milliC = rtdRawToMilliC(raw, scale);    // per read
+ */
+
+#ifndef RTD_CONVERSION_H
+#define RTD_CONVERSION_H
+
+#include <stdint.h>
+
+constexpr double RTD_PT100_NOMINAL = 100.0;    ///< PT100 resistance at 0°C in ohms
+constexpr double RTD_PT1000_NOMINAL = 1000.0;  ///< PT1000 resistance at 0°C in ohms
+
+constexpr double RTD_CVD_A = 3.9083e-3;        ///< Callendar-Van Dusen A (IEC 60751)
+constexpr double RTD_CVD_B = -5.775e-7;        ///< Callendar-Van Dusen B (IEC 60751)
+constexpr double RTD_CVD_C = -4.183e-12;       ///< Callendar-Van Dusen C, below 0°C only
+
+constexpr uint8_t RTD_RATIO_FRAC_BITS = 16;    ///< R/R0 is carried in Q16
+constexpr uint8_t RTD_SEGMENT_SHIFT = 11;      ///< Segment width 2^11 in Q16 = R0/32
+constexpr uint16_t RTD_FIRST_SEGMENT = 25;     ///< Table starts at R/R0 = 25/32 (about -55°C)
+constexpr uint16_t RTD_SEGMENTS = 35;          ///< Table ends at R/R0 = 60/32 (about 230°C)
+constexpr double RTD_MAX_REF_RATIO = 128.0;    ///< Largest RREF/R0; keeps the Q16 scale within 23 bits
+
+/**
+ * @brief Resistance ratio R/R0 for a temperature (forward CVD)
+ * @param[in] t Temperature in °C
+ * @return double R/R0
+ */
+constexpr double rtdCvdRatio(double t) {
+    return 1.0 + RTD_CVD_A * t + RTD_CVD_B * t * t +
+           (t < 0.0 ? RTD_CVD_C * (t - 100.0) * t * t * t : 0.0);
+}
+
+/**
+ * @brief Slope d(R/R0)/dT of the forward CVD
+ * @param[in] t Temperature in °C
+ * @return double Derivative at t
+ */
+constexpr double rtdCvdSlope(double t) {
+    return RTD_CVD_A + 2.0 * RTD_CVD_B * t +
+           (t < 0.0 ? RTD_CVD_C * (4.0 * t * t * t - 300.0 * t * t) : 0.0);
+}
+
+/**
+ * @brief Invert the CVD for a resistance ratio by Newton iteration
+ * @param[in] ratio R/R0
+ * @param[in] t Current estimate in °C
+ * @param[in] steps Remaining iterations
+ * @return double Temperature in °C
+ */
+constexpr double rtdCvdInverse(double ratio, double t, int steps) {
+    return steps == 0 ? t
+        : rtdCvdInverse(ratio, t - (rtdCvdRatio(t) - ratio) / rtdCvdSlope(t), steps - 1);
+}
+
+/**
+ * @brief Table breakpoint in millidegrees
+ * @param[in] i Breakpoint index (0..RTD_SEGMENTS)
+ * @return int32_t Temperature at R/R0 = (RTD_FIRST_SEGMENT + i) / 32, in m°C
+ */
+constexpr int32_t rtdTableEntry(uint16_t i) {
+    return (int32_t)(rtdCvdInverse((RTD_FIRST_SEGMENT + i) / 32.0,
+                                   ((RTD_FIRST_SEGMENT + i) / 32.0 - 1.0) / RTD_CVD_A, 6) * 1000.0
+                     + (((RTD_FIRST_SEGMENT + i) >= 32) ? 0.5 : -0.5));
+}
+
+/**
+ * @brief Compile-time generated breakpoints of the inverse CVD curve
+ */
+struct RtdTable {
+    int32_t milliC[RTD_SEGMENTS + 1]; ///< Temperature at each breakpoint in m°C
+};
+
+/// @cond INTERNAL
+template <uint16_t... I> struct RtdIndexList {};
+template <uint16_t N, uint16_t... I> struct RtdMakeIndex : RtdMakeIndex<N - 1, N - 1, I...> {};
+template <uint16_t... I> struct RtdMakeIndex<0, I...> { typedef RtdIndexList<I...> type; };
+
+template <uint16_t... I>
+constexpr RtdTable rtdMakeTable(RtdIndexList<I...>) {
+    return RtdTable{{ rtdTableEntry(I)... }};
+}
+/// @endcond
+
+/// Breakpoint table, built by the compiler
+constexpr RtdTable RTD_TABLE = rtdMakeTable(RtdMakeIndex<RTD_SEGMENTS + 1>::type());
+
+/**
+ * @brief Per-channel scale from reference and nominal resistance
+ * @param[in] refResistor Calibrated MAX31865 reference resistor in ohms
+ * @param[in] nominal RTD resistance at 0°C (RTD_PT100_NOMINAL or RTD_PT1000_NOMINAL)
+ * @return uint32_t RREF/R0 in Q16
+ */
+constexpr uint32_t rtdScaleQ16(double refResistor, double nominal) {
+    return (uint32_t)(refResistor / nominal * 65536.0 + 0.5);
+}
+
+/**
+ * @brief Convert a raw RTD code to temperature
+ * @param[in] raw 15-bit RTD code (register value >> 1)
+ * @param[in] scaleQ16 Channel scale from rtdScaleQ16()
+ * @return int32_t Temperature in m°C, clamped to the table ends (about -55..230°C)
+ * @details R/R0 = raw / 2^15 * RREF / R0, computed in Q16, then one table
+ *          lookup and a linear interpolation within the segment.
+ */
+inline int32_t rtdRawToMilliC(uint16_t raw, uint32_t scaleQ16) {
+    // raw (15 bits) * scale (Q16, up to 23 bits) needs 64 bits
+    uint32_t ratio = (uint32_t)(((uint64_t)raw * scaleQ16) >> (15 + 16 - RTD_RATIO_FRAC_BITS));
+
+    uint32_t segment = ratio >> RTD_SEGMENT_SHIFT;
+    if (segment < RTD_FIRST_SEGMENT) return RTD_TABLE.milliC[0];
+    segment -= RTD_FIRST_SEGMENT;
+    if (segment >= RTD_SEGMENTS) return RTD_TABLE.milliC[RTD_SEGMENTS];
+
+    int32_t t0 = RTD_TABLE.milliC[segment];
+    int32_t t1 = RTD_TABLE.milliC[segment + 1];
+    int32_t frac = (int32_t)(ratio & ((1u << RTD_SEGMENT_SHIFT) - 1));
+    return t0 + (((t1 - t0) * frac) >> RTD_SEGMENT_SHIFT);
+}
+
+#endif // RTD_CONVERSION_H
@@ -0,0 +1,155 @@
+/**
+ * @file SampleScheduler.h
+ * @brief Adaptive, deadband-driven sampling interval for one sensor
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Gives every sensor its own sampling interval instead of reading
+ *          all of them on every sweep. After each sample the interval is
+ *          recomputed from the last two values:
+ *          - change within the deadband: the interval doubles (up to max)
+ *          - change beyond the deadband: the interval halves (down to min) and
+ *            is capped to half the projected time to reach the threshold the
+ *            value is heading for
+ *          - within SAMPLE_NEAR_THRESHOLD_C of a threshold, or in error: min
+ *
+ *          Bus time therefore follows process activity: a flat sensor costs
+ *          one scratchpad read per max period.
+ *
+ * @section dependencies Dependencies
+ * - <stdint.h> only; the header builds on the host for tests
+ */
+
+#ifndef SAMPLE_SCHEDULER_H
+#define SAMPLE_SCHEDULER_H
+
+#include <stdint.h>
+
+constexpr uint32_t SAMPLE_DEFAULT_MIN_PERIOD_MS = 1000;  ///< Fastest interval when a point sets none
+constexpr uint32_t SAMPLE_DEFAULT_MAX_PERIOD_MS = 30000; ///< Slowest interval when a point sets none
+constexpr int16_t SAMPLE_DEADBAND_C = 1;                 ///< Change (°C) that counts as activity
+constexpr int16_t SAMPLE_NEAR_THRESHOLD_C = 2;           ///< Margin (°C) to a threshold sampled at min period
+
+/**
+ * @class SampleScheduler
+ * @brief Per-sensor sampling interval state
+ * @note Timestamps are millis() values; wrap-around is handled by signed differences.
+ */
+class SampleScheduler {
+public:
+    SampleScheduler()
+        : _minPeriodMs(0), _maxPeriodMs(0), _intervalMs(SAMPLE_DEFAULT_MIN_PERIOD_MS),
+          _lastSampleMs(0), _lastTemp(0), _primed(false) {}
+
+    /**
+     * @brief Set the interval limits
+     * @param[in] minMs Shortest interval in ms (0 = SAMPLE_DEFAULT_MIN_PERIOD_MS)
+     * @param[in] maxMs Longest interval in ms (0 = SAMPLE_DEFAULT_MAX_PERIOD_MS)
+     * @details The current interval is clamped into the new range; a max below
+     *          min is raised to min.
+     */
+    void setPeriodLimits(uint32_t minMs, uint32_t maxMs) {
+        _minPeriodMs = minMs;
+        _maxPeriodMs = maxMs;
+        _intervalMs = _clamp(_intervalMs);
+    }
+
+    /**
+     * @brief Get effective minimum interval
+     * @return uint32_t Interval in ms
+     */
+    uint32_t getMinPeriod() const { return _minPeriodMs ? _minPeriodMs : SAMPLE_DEFAULT_MIN_PERIOD_MS; }
+
+    /**
+     * @brief Get effective maximum interval
+     * @return uint32_t Interval in ms, never below getMinPeriod()
+     */
+    uint32_t getMaxPeriod() const {
+        uint32_t maxMs = _maxPeriodMs ? _maxPeriodMs : SAMPLE_DEFAULT_MAX_PERIOD_MS;
+        return maxMs < getMinPeriod() ? getMinPeriod() : maxMs;
+    }
+
+    /**
+     * @brief Get current interval
+     * @return uint32_t Interval in ms until the next sample is due
+     */
+    uint32_t getInterval() const { return _intervalMs; }
+
+    /**
+     * @brief Time the next sample is due
+     * @return uint32_t millis() timestamp
+     */
+    uint32_t dueAt() const { return _lastSampleMs + _intervalMs; }
+
+    /**
+     * @brief Check if a sample is due
+     * @param[in] now Current millis()
+     * @return true if never sampled or the interval has elapsed
+     */
+    bool isDue(uint32_t now) const { return !_primed || (int32_t)(now - dueAt()) >= 0; }
+
+    /**
+     * @brief Forget history so the next sample is taken immediately
+     */
+    void reset() {
+        _primed = false;
+        _intervalMs = getMinPeriod();
+    }
+
+    /**
+     * @brief Record a sample and compute the next interval
+     * @param[in] now millis() of the sample
+     * @param[in] temp Sampled temperature in °C
+     * @param[in] low Low alarm threshold in °C
+     * @param[in] high High alarm threshold in °C
+     * @param[in] error true if the sensor reported an error
+     * @return uint32_t New interval in ms
+     */
+    uint32_t onSample(uint32_t now, int16_t temp, int16_t low, int16_t high, bool error) {
+        uint32_t interval;
+        if (error || !_primed) {
+            interval = getMinPeriod();
+        } else {
+            int32_t delta = (int32_t)temp - _lastTemp;
+            int32_t absDelta = delta < 0 ? -delta : delta;
+            if (absDelta >= SAMPLE_DEADBAND_C) {
+                interval = _intervalMs / 2;
+                // Keep at least two samples before the threshold being approached
+                int32_t margin = delta > 0 ? (int32_t)high - temp : (int32_t)temp - low;
+                if (margin > 0) {
+                    uint32_t elapsed = now - _lastSampleMs;
+                    uint32_t reachMs = (uint32_t)(((uint64_t)margin * elapsed) / (uint32_t)absDelta);
+                    if (reachMs / 2 < interval) interval = reachMs / 2;
+                }
+            } else {
+                interval = _intervalMs * 2;
+            }
+
+            int32_t lowMargin = (int32_t)temp - low;
+            int32_t highMargin = (int32_t)high - temp;
+            if (lowMargin <= SAMPLE_NEAR_THRESHOLD_C || highMargin <= SAMPLE_NEAR_THRESHOLD_C)
+                interval = getMinPeriod();
+        }
+
+        _intervalMs = _clamp(interval);
+        _lastSampleMs = now;
+        _lastTemp = temp;
+        _primed = true;
+        return _intervalMs;
+    }
+
+private:
+    uint32_t _clamp(uint32_t interval) const {
+        if (interval < getMinPeriod()) return getMinPeriod();
+        if (interval > getMaxPeriod()) return getMaxPeriod();
+        return interval;
+    }
+
+    uint32_t _minPeriodMs;   ///< Configured minimum interval, 0 = default
+    uint32_t _maxPeriodMs;   ///< Configured maximum interval, 0 = default
+    uint32_t _intervalMs;    ///< Current interval
+    uint32_t _lastSampleMs;  ///< millis() of the last sample
+    int16_t _lastTemp;       ///< Value of the last sample
+    bool _primed;            ///< At least one sample recorded
+};
+
+#endif // SAMPLE_SCHEDULER_H
@@ -8,9 +8,7 @@
  *          temperature tracking capabilities.
  * 
  * @section dependencies Dependencies
- * - OneWire library for DS18B20 communication
- * - DallasTemperature for DS18B20 interface
- * - Adafruit_MAX31865 for PT1000 RTD interface
+ * - SensorBus.h for the OneWire (DS18B20) and MAX31865 (PT1000) backends
  * 
  * @section hardware Hardware Requirements
  * - DS18B20: OneWire digital temperature sensors
@@ -21,9 +19,11 @@
 #define SENSOR_H
 
 #include <Arduino.h>
-#include <OneWire.h>
-#include <DallasTemperature.h>
-#include <Adafruit_MAX31865.h>
+#include "SensorBus.h"
+#include "RtdConversion.h"
+#include "SampleScheduler.h"
+#include "AcquisitionStats.h"
+#include "ThresholdKernel.h"
 
 /**
  * @enum SensorType
@@ -42,17 +42,59 @@ enum class SensorType {
 constexpr uint8_t ERROR_COMMUNICATION = 0x01;  ///< Communication error with sensor
 constexpr uint8_t ERROR_OUT_OF_RANGE  = 0x02;  ///< Temperature reading out of valid range
 constexpr uint8_t ERROR_DISCONNECTED  = 0x04;  ///< Sensor physically disconnected
+constexpr uint8_t ERROR_QUARANTINED   = 0x08;  ///< Repeated failures, sampled only by backoff re-probes
 /** @} */
 
+/**
+ * @name Quarantine
+ * @brief Backoff schedule for sensors that keep failing
+ * @details After QUARANTINE_FAILURE_THRESHOLD consecutive failed reads a sensor
+ *          leaves the normal sampling schedule. It is re-probed after
+ *          QUARANTINE_INITIAL_BACKOFF_MS, the delay doubling on every further
+ *          failure up to QUARANTINE_MAX_BACKOFF_MS; one good read releases it.
+ * @{
+ */
+constexpr uint8_t QUARANTINE_FAILURE_THRESHOLD = 3;        ///< Consecutive failures before quarantine
+constexpr uint32_t QUARANTINE_INITIAL_BACKOFF_MS = 5000;   ///< First re-probe delay
+constexpr uint32_t QUARANTINE_MAX_BACKOFF_MS = 300000;     ///< Longest re-probe delay
+/** @} */
+
+constexpr uint32_t SENSOR_LINK_ERROR_LOG_MS = 60000; ///< Shortest gap between communication error logs per sensor
+
 /**
  * @name Alarm Status Bitmasks
  * @brief Bit flags for temperature alarm conditions
  * @{
  */
-constexpr uint8_t ALARM_LOW_TEMP  = 0x01;      ///< Temperature below low threshold
-constexpr uint8_t ALARM_HIGH_TEMP = 0x02;      ///< Temperature above high threshold
+constexpr uint8_t ALARM_LOW_TEMP  = THRESHOLD_BIT_LOW;    ///< Temperature at or below low threshold
+constexpr uint8_t ALARM_HIGH_TEMP = THRESHOLD_BIT_HIGH;   ///< Temperature at or above high threshold
 /** @} */
 
+constexpr uint8_t DS18B20_DEFAULT_RESOLUTION = 12; ///< DS18B20 conversion resolution in bits
+constexpr uint8_t DS18B20_CRC_RETRIES = 2;         ///< Extra scratchpad reads after a CRC failure
+constexpr uint8_t DS18B20_MIN_RESOLUTION = 9;      ///< Lowest DS18B20 resolution in bits
+constexpr uint8_t DS18B20_MAX_RESOLUTION = 12;     ///< Highest DS18B20 resolution in bits
+
+constexpr float PT1000_REF_RESISTOR = 4300.0f;     ///< Default MAX31865 reference resistor in ohms
+
+/**
+ * @brief Progress of a split PT1000 one-shot read
+ */
+enum class RtdOneShotStage : uint8_t {
+    IDLE,           ///< No conversion pending, bias off
+    BIASING,        ///< Bias on, waiting RTD_BIAS_SETTLE_MS before the 1-shot start
+    CONVERTING      ///< 1-shot started, result ready RTD_ONESHOT_CONVERSION_MS later
+};
+
+/**
+ * @brief Outcome of Sensor::collectRtdOneShot()
+ */
+enum class RtdCollectResult : uint8_t {
+    READ,           ///< Reading taken and applied
+    FAILED,         ///< Reading attempted but failed (or not a PT1000)
+    PENDING         ///< Split read not finished; retry at getRtdOneShotStepAt()
+};
+
 /**
  * @class Sensor
  * @brief Abstract temperature sensor interface
@@ -79,10 +121,10 @@ public:
     // Setup methods for each sensor type
     /**
      * @brief Configure sensor as DS18B20
-     * @param[in] pin OneWire bus pin number
+     * @param[in] bus Shared OneWire bus the sensor is attached to
      * @param[in] deviceAddress 8-byte ROM address of DS18B20
      */
-    void setupDS18B20(uint8_t pin, const uint8_t* deviceAddress);
+    void setupDS18B20(OneWireInterface* bus, const uint8_t* deviceAddress);
     
     /**
      * @brief Configure sensor as PT1000
@@ -91,6 +133,13 @@ public:
      */
     void setupPT1000(uint8_t csPin, uint8_t maxAddress);
 
+    /**
+     * @brief Attach a MAX31865 backend before initialize()
+     * @param[in] frontend Converter for this sensor's chip select (ownership taken)
+     * @details Without one, initialize() creates createRtdFrontend(csPin).
+     */
+    void setRtdFrontend(RtdInterface* frontend);
+
     /**
      * @brief Initialize sensor hardware
      * @return true if initialization successful
@@ -106,6 +155,269 @@ public:
      */
     bool readTemperature();
 
+    /**
+     * @brief Read a DS18B20 result converted by a bus-wide Convert-T
+     * @return true if reading successful
+     * @return false if scratchpad could not be read or sensor is not DS18B20
+     * @details Does not start a conversion; the caller must have issued a
+     *          Skip-ROM Convert-T on the bus and waited for it to complete.
+     *          Costs one Match-ROM + Read-Scratchpad; the read is repeated
+     *          (up to DS18B20_CRC_RETRIES times) only when the CRC8 fails.
+     */
+    bool readConvertedTemperature();
+
+    /**
+     * @brief Start a conversion on this DS18B20 only (Match-ROM Convert-T)
+     * @return true if the command was sent
+     * @details Used to resample fast sensors while slower ones on the same
+     *          bus are still converting.
+     */
+    bool startConversion();
+
+    /**
+     * @brief Begin a split one-shot PT1000 read: switch the bias on
+     * @param[in] now Current millis()
+     * @return true if a one-shot read is now pending (PT1000 in one-shot mode)
+     * @details The acquisition engine calls this, then startRtdOneShot() once
+     *          the bias has settled and collectRtdOneShot() when the result is
+     *          ready, so no step waits for the ~75 ms conversion.
+     */
+    bool beginRtdOneShot(unsigned long now);
+
+    /**
+     * @brief Start the pending one-shot conversion once the bias has settled
+     * @param[in] now Current millis()
+     * @return true if the conversion was started by this call
+     */
+    bool startRtdOneShot(unsigned long now);
+
+    /**
+     * @brief Advance a split one-shot read and collect it once converted
+     * @param[in] now Current millis()
+     * @return READ or FAILED once a reading was taken, PENDING while the bias
+     *         is settling or the conversion is still running
+     * @details Never waits: a step that is not yet due returns PENDING, and a
+     *          one-shot channel without a pending read begins one. The bias is
+     *          switched off after the result is read. Continuous channels
+     *          return their latest conversion immediately.
+     */
+    RtdCollectResult collectRtdOneShot(unsigned long now);
+
+    /**
+     * @brief millis() at which the pending one-shot step is due
+     */
+    unsigned long getRtdOneShotStepAt() const { return ptOneShotStepAt; }
+
+    /**
+     * @brief Write the alarm thresholds into the DS18B20 TH/TL registers
+     * @return true if the device holds the limits (written or already equal)
+     * @details TH = high and TL = low, clamped to -55..125: the device flags
+     *          T >= TH or T <= TL, the same inclusive rule the points use, so
+     *          the alarm search finds a reading exactly at a limit. Reads the
+     *          scratchpad first and writes (and copies to EEPROM) only when a
+     *          value differs.
+     */
+    bool writeAlarmLimits();
+
+    /**
+     * @brief Check if thresholds changed since the last TH/TL write
+     * @return true if writeAlarmLimits() should be called
+     */
+    bool isAlarmLimitsPending() const { return alarmLimitsPending; }
+
+    /**
+     * @brief Make the sensor due at the next sweep
+     * @details Used when a hardware alarm search or ROM search reports this
+     *          device; a quarantined sensor is re-probed immediately.
+     */
+    void requestSample();
+
+    /**
+     * @brief Check if the sensor is quarantined after repeated failures
+     * @return true while only backoff re-probes are scheduled
+     */
+    bool isQuarantined() const { return quarantined; }
+
+    /**
+     * @brief Get consecutive failed reads
+     * @return uint8_t Failures since the last good read (saturates at 255)
+     */
+    uint8_t getConsecutiveFailures() const { return consecutiveFailures; }
+
+    /**
+     * @brief Get current quarantine re-probe delay
+     * @return uint32_t Backoff in ms, 0 if not quarantined
+     */
+    uint32_t getQuarantineBackoff() const { return quarantined ? quarantineBackoffMs : 0; }
+
+    /**
+     * @brief Take error bits raised or cleared since the last call
+     * @param[out] cleared Error bits that cleared
+     * @return uint8_t Error bits newly raised
+     * @details Drives edge-triggered error logging; call from the loop task only.
+     */
+    uint8_t takeErrorChanges(uint8_t& cleared) {
+        uint8_t current = errorStatus;
+        uint8_t raised = current & ~reportedErrors;
+        cleared = reportedErrors & ~current;
+        reportedErrors = current;
+        return raised;
+    }
+
+    /**
+     * @brief Claim a log entry for a communication / disconnect error onset
+     * @param[in] now millis()
+     * @return true at most once per SENSOR_LINK_ERROR_LOG_MS
+     * @details A flapping bus raises the error on every failed read; the rate
+     *          limit keeps one line per minute. Loop task only.
+     */
+    bool claimLinkErrorLog(unsigned long now) {
+        if (linkErrorLogged && now - linkErrorLoggedAt < SENSOR_LINK_ERROR_LOG_MS) return false;
+        linkErrorLogged = true;
+        linkErrorReported = true;
+        linkErrorLoggedAt = now;
+        return true;
+    }
+
+    /**
+     * @brief Check whether the onset of the link error that just cleared was logged
+     * @return true if the recovery should be logged too; starts a new episode
+     */
+    bool takeLinkErrorRecovery() {
+        bool logged = linkErrorReported;
+        linkErrorReported = false;
+        return logged;
+    }
+
+    /**
+     * @brief Start a background ROM search pass over this sensor's bus
+     */
+    void beginSearchPass() { searchSeen = false; }
+
+    /**
+     * @brief Record that a ROM search found this sensor
+     * @return uint8_t Consecutive passes it had been missing before
+     */
+    uint8_t markSearchSeen() {
+        uint8_t missed = missedSearches;
+        searchSeen = true;
+        missedSearches = 0;
+        return missed;
+    }
+
+    /**
+     * @brief Close a ROM search pass over this sensor's bus
+     * @return uint8_t Consecutive passes the sensor has been missing
+     */
+    uint8_t endSearchPass() {
+        if (!searchSeen && missedSearches < 255) missedSearches++;
+        return missedSearches;
+    }
+
+    /**
+     * @brief Get consecutive background ROM searches that missed this sensor
+     * @return uint8_t Missed passes, 0 if seen in the last one
+     */
+    uint8_t getMissedSearches() const { return missedSearches; }
+
+    /**
+     * @brief Set DS18B20 conversion resolution
+     * @param[in] bits Resolution in bits, clamped to 9-12
+     * @return true if the device accepted the setting (or is not set up yet)
+     * @details Writes the configuration register only when the value changes.
+     */
+    bool setResolution(uint8_t bits);
+
+    /**
+     * @brief Get DS18B20 conversion resolution
+     * @return uint8_t Resolution in bits (9-12)
+     */
+    uint8_t getResolution() const { return resolution; }
+
+    /**
+     * @brief Select PT1000 continuous-conversion mode
+     * @param[in] enabled true: auto-convert with bias always on; false: one-shot reads
+     * @param[in] filter50Hz true for a 50 Hz mains notch filter, false for 60 Hz
+     * @return true if applied (or stored for initialize()), false if not PT1000
+     * @details In continuous mode the MAX31865 converts every 16.7/20 ms on its
+     *          own and readTemperature() is a single 3-byte SPI transaction of
+     *          the RTD register instead of a ~75 ms one-shot conversion.
+     */
+    bool setPT1000ContinuousMode(bool enabled, bool filter50Hz = true);
+
+    /**
+     * @brief Set RTD element and calibrated reference resistor
+     * @param[in] nominal RTD resistance at 0°C (RTD_PT1000_NOMINAL or RTD_PT100_NOMINAL)
+     * @param[in] refResistor Measured MAX31865 reference resistor in ohms
+     * @return true if applied, false if not PT1000 or values out of range
+     * @details Both are folded into the Q16 scale used by rtdRawToMilliC().
+     */
+    bool setRtdCalibration(float nominal, float refResistor);
+
+    /**
+     * @brief Get RTD nominal resistance
+     * @return float Resistance at 0°C in ohms
+     */
+    float getRtdNominal() const { return ptNominal; }
+
+    /**
+     * @brief Get calibrated reference resistor
+     * @return float Reference resistance in ohms
+     */
+    float getRtdReference() const { return ptRefResistor; }
+
+    /**
+     * @brief Check if the adaptive scheduler wants a new sample
+     * @param[in] now Current millis()
+     * @return true if the sampling interval (or quarantine backoff) has elapsed
+     */
+    bool isSampleDue(uint32_t now) const {
+        return quarantined ? (int32_t)(now - nextProbeMs) >= 0 : scheduler.isDue(now);
+    }
+
+    /**
+     * @brief Get time the next sample is due
+     * @return uint32_t millis() timestamp
+     */
+    uint32_t getSampleDueAt() const { return quarantined ? nextProbeMs : scheduler.dueAt(); }
+
+    /**
+     * @brief Get current adaptive sampling interval
+     * @return uint32_t Interval in ms
+     */
+    uint32_t getSampleInterval() const { return scheduler.getInterval(); }
+
+    /**
+     * @brief Set sampling interval limits
+     * @param[in] minMs Shortest interval in ms (0 = default)
+     * @param[in] maxMs Longest interval in ms (0 = default)
+     */
+    void setSamplePeriodLimits(uint32_t minMs, uint32_t maxMs) { scheduler.setPeriodLimits(minMs, maxMs); }
+
+    /**
+     * @brief Check if the PT1000 runs in continuous-conversion mode
+     * @return true if the MAX31865 auto-converts
+     */
+    bool isPT1000ContinuousMode() const { return ptContinuous; }
+
+    /**
+     * @brief Get number of scratchpad reads that failed CRC8
+     * @return uint32_t CRC error count since boot
+     */
+    uint32_t getCrcErrorCount() const { return health.crcErrors; }
+
+    /**
+     * @brief Get number of scratchpad re-reads after CRC failures
+     * @return uint32_t Retry count since boot
+     */
+    uint32_t getRetryCount() const { return health.retries; }
+
+    /**
+     * @brief Get read statistics
+     * @return const HealthCounters& Latency histogram, failure, timeout and quarantine counts
+     */
+    const HealthCounters& getHealth() const { return health; }
+
     // Accessors
     /**
      * @brief Get sensor type
@@ -213,7 +525,11 @@ public:
 
     /**
      * @brief Update alarm status based on current temperature
-     * @details Call after reading temperature or changing thresholds
+     * @details Call after reading temperature or changing thresholds. Uses the
+     *          point kernel's thresholdBits(): inclusive limits (low at
+     *          temp <= low, high at temp >= high, as the DS18B20 TH/TL compare),
+     *          no hysteresis, and no temperature bits while an error is set.
+     *          Strict comparisons were used before the kernel was introduced.
      */
     void updateAlarmStatus();
     
@@ -235,6 +551,12 @@ public:
      */
     uint8_t getOneWirePin() {return connection.ds18b20.oneWirePin;}
 
+    /**
+     * @brief Get shared OneWire bus of a DS18B20
+     * @return OneWireInterface* Bus driver, nullptr for PT1000 or before setup
+     */
+    OneWireInterface* getOneWireBus() const { return oneWireBus; }
+
 private:
     uint8_t address;                    ///< Logical sensor address
     String name;                        ///< Human-readable sensor name
@@ -247,11 +569,31 @@ private:
     int16_t highAlarmThreshold;         ///< High temperature alarm threshold
     uint8_t alarmStatus;                ///< Current alarm status flags
     uint8_t errorStatus;                ///< Current error status flags
+    HealthCounters health;              ///< Read latency and failure statistics
+    uint8_t resolution;                 ///< DS18B20 conversion resolution in bits
+    bool ptContinuous;                  ///< MAX31865 in auto-convert mode with bias on
+    bool ptFilter50Hz;                  ///< MAX31865 mains filter: true 50 Hz, false 60 Hz
+    float ptNominal;                    ///< RTD resistance at 0°C in ohms
+    float ptRefResistor;                ///< Calibrated MAX31865 reference resistor in ohms
+    uint32_t ptScaleQ16;                ///< ptRefResistor / ptNominal in Q16 for the RTD table
+    RtdOneShotStage ptOneShotStage;     ///< Split one-shot read progress
+    unsigned long ptOneShotStepAt;      ///< millis() when the next one-shot step is due
+    SampleScheduler scheduler;          ///< Adaptive sampling interval
+    bool alarmLimitsPending;            ///< Thresholds not yet written to TH/TL
+    bool searchSeen;                    ///< Found by the current background ROM search pass
+    uint8_t missedSearches;             ///< Consecutive ROM search passes without this device
+    uint8_t consecutiveFailures;        ///< Failed reads since the last good one
+    bool quarantined;                   ///< Sampled only at nextProbeMs
+    uint32_t quarantineBackoffMs;       ///< Current re-probe delay
+    uint32_t nextProbeMs;               ///< millis() of the next quarantine re-probe
+    uint8_t reportedErrors;             ///< Error bits already logged (loop task only)
+    bool linkErrorLogged;               ///< linkErrorLoggedAt is valid (loop task only)
+    bool linkErrorReported;             ///< Onset of the current link error was logged (loop task only)
+    unsigned long linkErrorLoggedAt;    ///< millis() of the last communication error log
 
     // Hardware-specific members
-    OneWire* oneWire;                   ///< OneWire interface for DS18B20
-    DallasTemperature* dallasTemperature; ///< Dallas temperature library instance
-    Adafruit_MAX31865* max31865;        ///< MAX31865 interface for PT1000
+    OneWireInterface* oneWireBus;       ///< Shared OneWire bus for DS18B20 (not owned)
+    RtdInterface* rtd;                  ///< MAX31865 backend for PT1000 (owned)
 
     /**
      * @brief Union for sensor-specific connection details
@@ -273,6 +615,28 @@ private:
             uint8_t maxAddress;         ///< MAX31865 I2C address
         } pt1000;
     } connection;                       ///< Sensor connection details
+
+    /**
+     * @brief Track consecutive failures and the quarantine backoff
+     * @param[in] healthy true if the sensor answered (a value out of range still counts)
+     */
+    void _updateQuarantine(bool healthy);
+
+    /**
+     * @brief Store a reading and refresh min/max, alarm status and sampling interval
+     * @param[in] success Whether the hardware returned a value
+     * @param[in] tempC Temperature in degrees Celsius
+     */
+    void _applyReading(bool success, float tempC);
+
+    /**
+     * @brief Convert an RTD code, record health and store the reading
+     * @param[in] raw 15-bit RTD code
+     * @param[in] fault MAX31865 fault status
+     * @param[in] readStart micros() when the SPI read started
+     * @return true if the reading is valid
+     */
+    bool _applyRtdReading(uint16_t raw, uint8_t fault, uint32_t readStart);
 };
 
 #endif // SENSOR_H
@@ -0,0 +1,265 @@
+/**
+ * @file SensorBus.h
+ * @brief Hardware abstraction for OneWire (DS18B20) buses and MAX31865 RTD front ends
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Sensor and TemperatureController talk to temperature hardware only
+ *          through these interfaces. Two backends implement them:
+ *          - OneWireBus / Max31865Rtd: OneWire, DallasTemperature and
+ *            Adafruit_MAX31865 on the ESP32
+ *          - SimulatedOneWireBus / SimulatedRtd: software models that build on
+ *            a Linux host as well as on the target
+ *
+ *          createOneWireBus() and createRtdFrontend() pick the backend; define
+ *          SENSOR_BUS_SIMULATED to select the simulation on the target.
+ *
+ * @section dependencies Dependencies
+ * - <stdint.h> only; the header builds on the host for tests
+ */
+
+#ifndef SENSOR_BUS_H
+#define SENSOR_BUS_H
+
+#include <stdint.h>
+
+/**
+ * @name DS18B20 scratchpad layout
+ * @{
+ */
+constexpr uint8_t DS18B20_SCRATCHPAD_SIZE = 9;   ///< Bytes returned by Read Scratchpad
+constexpr uint8_t DS18B20_SP_TEMP_LSB = 0;       ///< Temperature LSB (1/16 °C)
+constexpr uint8_t DS18B20_SP_TEMP_MSB = 1;       ///< Temperature MSB
+constexpr uint8_t DS18B20_SP_TH = 2;             ///< High alarm limit / user byte 1
+constexpr uint8_t DS18B20_SP_TL = 3;             ///< Low alarm limit / user byte 2
+constexpr uint8_t DS18B20_SP_CONFIG = 4;         ///< Configuration (resolution in bits 5-6)
+constexpr uint8_t DS18B20_SP_CRC = 8;            ///< CRC8 over bytes 0-7
+/** @} */
+
+/**
+ * @brief DS18B20 conversion time for a resolution
+ * @param[in] bits Resolution in bits (9-12)
+ * @return uint16_t Maximum conversion time in milliseconds (94/188/375/750)
+ */
+inline uint16_t ds18b20ConversionTimeMs(uint8_t bits) {
+    return bits >= 12 ? 750 : bits == 11 ? 375 : bits == 10 ? 188 : 94;
+}
+
+/**
+ * @name MAX31865 fault status bits
+ * @{
+ */
+constexpr uint8_t RTD_FAULT_HIGHTHRESH = 0x80;   ///< RTD above high threshold register
+constexpr uint8_t RTD_FAULT_LOWTHRESH = 0x40;    ///< RTD below low threshold register
+constexpr uint8_t RTD_FAULT_REFINLOW = 0x20;     ///< REFIN- > 0.85 x Vbias
+constexpr uint8_t RTD_FAULT_REFINHIGH = 0x10;    ///< REFIN- < 0.85 x Vbias, FORCE- open
+constexpr uint8_t RTD_FAULT_RTDINLOW = 0x08;     ///< RTDIN- < 0.85 x Vbias, FORCE- open
+constexpr uint8_t RTD_FAULT_OVUV = 0x04;         ///< Over/under voltage
+constexpr uint8_t RTD_FAULT_SERIOUS = RTD_FAULT_REFINLOW | RTD_FAULT_REFINHIGH |
+                                      RTD_FAULT_RTDINLOW | RTD_FAULT_OVUV; ///< Faults that void the reading
+/** @} */
+
+constexpr uint16_t RTD_BIAS_SETTLE_MS = 10;        ///< Bias on to 1-shot start (input filter settling)
+constexpr uint16_t RTD_ONESHOT_CONVERSION_MS = 65; ///< 1-shot start to result, 50 Hz filter
+
+/**
+ * @brief Dallas/Maxim CRC8 (polynomial x^8 + x^5 + x^4 + 1)
+ * @param[in] data Bytes to check
+ * @param[in] len Number of bytes
+ * @return uint8_t CRC; equals the byte following data when intact
+ */
+inline uint8_t oneWireCrc8(const uint8_t* data, uint8_t len) {
+    uint8_t crc = 0;
+    while (len--) {
+        uint8_t in = *data++;
+        for (uint8_t i = 0; i < 8; ++i) {
+            uint8_t mix = (crc ^ in) & 0x01;
+            crc >>= 1;
+            if (mix) crc ^= 0x8C;
+            in >>= 1;
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Check if a ROM family code is a supported temperature sensor
+ * @param[in] rom 8-byte ROM
+ * @return true for DS18S20, DS18B20, DS1822, DS1825 and MAX31850
+ */
+inline bool oneWireValidFamily(const uint8_t* rom) {
+    switch (rom[0]) {
+        case 0x10: case 0x28: case 0x22: case 0x3B: case 0x42: return true;
+        default: return false;
+    }
+}
+
+/**
+ * @class OneWireInterface
+ * @brief DS18B20 command set on one OneWire bus
+ * @details Callers hold lock() across a transaction; the lock is recursive so
+ *          a sweep can hold it over several sensor reads. No call waits for a
+ *          conversion: the caller schedules conversion time itself.
+ */
+class OneWireInterface {
+public:
+    virtual ~OneWireInterface() {}
+
+    /**
+     * @brief Get bus GPIO pin
+     * @return uint8_t Pin number
+     */
+    virtual uint8_t getPin() const = 0;
+
+    /**
+     * @brief Acquire exclusive access to the bus
+     */
+    virtual void lock() = 0;
+
+    /**
+     * @brief Release the bus
+     */
+    virtual void unlock() = 0;
+
+    /**
+     * @brief Probe the bus power mode (Read Power Supply)
+     * @return true if any device is parasite powered
+     * @details A parasite-powered bus keeps the strong pull-up during Convert-T.
+     *          Enumerates the bus, so call it only while no ROM search is in
+     *          progress and again when a device is attached.
+     */
+    virtual bool begin() = 0;
+
+    /**
+     * @brief Start a conversion on every device (Skip-ROM + Convert-T)
+     * @return true if the command was sent
+     */
+    virtual bool convertAll() = 0;
+
+    /**
+     * @brief Start a conversion on one device (Match-ROM + Convert-T)
+     * @param[in] rom 8-byte ROM
+     * @return true if the command was sent
+     */
+    virtual bool convert(const uint8_t* rom) = 0;
+
+    /**
+     * @brief Read the scratchpad of one device
+     * @param[in] rom 8-byte ROM
+     * @param[out] scratchPad DS18B20_SCRATCHPAD_SIZE bytes, CRC not checked
+     * @return false if no device answered the reset
+     */
+    virtual bool readScratchPad(const uint8_t* rom, uint8_t* scratchPad) = 0;
+
+    /**
+     * @brief Write TH, TL and configuration and copy them to EEPROM
+     * @param[in] rom 8-byte ROM
+     * @param[in] scratchPad Scratchpad whose bytes 2-4 are written
+     * @return true if the command was sent
+     */
+    virtual bool writeScratchPad(const uint8_t* rom, const uint8_t* scratchPad) = 0;
+
+    /**
+     * @brief Set conversion resolution of one device
+     * @param[in] rom 8-byte ROM
+     * @param[in] bits Resolution, 9-12
+     * @return true if the device holds the setting
+     */
+    virtual bool setResolution(const uint8_t* rom, uint8_t bits) = 0;
+
+    /**
+     * @brief Check if a device answers with a valid scratchpad
+     * @param[in] rom 8-byte ROM
+     * @return true if present
+     */
+    virtual bool isConnected(const uint8_t* rom) = 0;
+
+    /**
+     * @brief Restart ROM enumeration
+     */
+    virtual void resetSearch() = 0;
+
+    /**
+     * @brief Find the next device
+     * @param[out] rom 8-byte ROM of the device found
+     * @param[in] alarmOnly true for Alarm Search (0xEC): only flagged devices answer
+     * @return false when enumeration is complete
+     */
+    virtual bool search(uint8_t* rom, bool alarmOnly = false) = 0;
+};
+
+/**
+ * @class RtdInterface
+ * @brief MAX31865 RTD-to-digital converter on one chip select
+ * @details Raw codes are the 15-bit ADC value (RTD / Rref x 32768).
+ */
+class RtdInterface {
+public:
+    virtual ~RtdInterface() {}
+
+    /**
+     * @brief Get chip select pin
+     * @return uint8_t Pin number
+     */
+    virtual uint8_t getChipSelectPin() const = 0;
+
+    /**
+     * @brief Initialize the converter (3-wire)
+     * @return true if the device accepted the configuration
+     */
+    virtual bool begin() = 0;
+
+    /**
+     * @brief Select conversion mode
+     * @param[in] continuous true for auto-convert with bias on, false for one-shot
+     * @param[in] filter50Hz true for the 50 Hz notch, false for 60 Hz
+     */
+    virtual void configure(bool continuous, bool filter50Hz) = 0;
+
+    /**
+     * @brief Read the latest auto-converted result without triggering one
+     * @param[out] raw 15-bit RTD code
+     * @param[out] fault Fault status (0 unless the result carries the fault bit)
+     */
+    virtual void readLatest(uint16_t& raw, uint8_t& fault) = 0;
+
+    /**
+     * @brief Run a one-shot conversion (blocks for the conversion time)
+     * @param[out] raw 15-bit RTD code
+     * @param[out] fault Fault status read before the conversion
+     */
+    virtual void readOneShot(uint16_t& raw, uint8_t& fault) = 0;
+
+    /**
+     * @brief Switch the bias voltage (one-shot mode)
+     * @param[in] on true to power the RTD, false to stop self-heating between reads
+     */
+    virtual void setBias(bool on) = 0;
+
+    /**
+     * @brief Start a one-shot conversion without waiting for it
+     * @details Bias must have been on for RTD_BIAS_SETTLE_MS. The result is
+     *          read with readLatest() RTD_ONESHOT_CONVERSION_MS later.
+     */
+    virtual void startOneShot() = 0;
+
+    /**
+     * @brief Clear latched faults, keeping the conversion mode
+     */
+    virtual void clearFault() = 0;
+};
+
+/**
+ * @brief Create the OneWire backend for a bus
+ * @param[in] pin GPIO pin of the bus
+ * @return OneWireInterface* Hardware bus, or a simulated one with SENSOR_BUS_SIMULATED
+ */
+OneWireInterface* createOneWireBus(uint8_t pin);
+
+/**
+ * @brief Create the MAX31865 backend for a chip select
+ * @param[in] csPin SPI chip select pin
+ * @return RtdInterface* Hardware converter, or a simulated one with SENSOR_BUS_SIMULATED
+ */
+RtdInterface* createRtdFrontend(uint8_t csPin);
+
+#endif // SENSOR_BUS_H
@@ -0,0 +1,228 @@
+/**
+ * @file SimulatedSensorBus.h
+ * @brief Simulated OneWire and MAX31865 backends for host builds and benchmarks
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Models DS18B20 devices on a bus and a PT1000 behind a MAX31865 well
+ *          enough to drive the acquisition engine without hardware:
+ *          - configurable device count, temperature spread, noise and drift
+ *          - per-resolution conversion time: a scratchpad read before the
+ *            conversion finished returns the previous result (85 °C at power-up)
+ *          - random dropouts (no presence / open RTD) and scratchpad CRC errors
+ *          - TH/TL alarm flags answering Alarm Search
+ *          - optional busy time per read to mimic bus latency
+ *
+ *          Randomness comes from a seeded xorshift generator, so runs repeat.
+ *          Time comes from simulationMillis(): millis() on the target, a
+ *          steady clock on the host, or a caller-supplied clock for tests.
+ *
+ * @section dependencies Dependencies
+ * - SensorBus.h for the interfaces
+ * - RtdConversion.h for the Callendar-Van Dusen curve
+ * - <mutex> and <vector>; no Arduino headers
+ */
+
+#ifndef SIMULATED_SENSOR_BUS_H
+#define SIMULATED_SENSOR_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <mutex>
+#include <vector>
+#include "SensorBus.h"
+#include "RtdConversion.h"
+
+/**
+ * @struct SimulationProfile
+ * @brief Behaviour shared by all simulated devices of one backend
+ */
+struct SimulationProfile {
+    uint16_t devicesPerBus = 8;         ///< DS18B20 devices created per simulated bus
+    float baseTempC = 22.0f;            ///< Mean temperature
+    float spreadC = 10.0f;              ///< Device offsets are spread over ±spreadC/2
+    float noiseC = 0.2f;                ///< Uniform noise amplitude per conversion
+    float driftCPerMin = 0.0f;          ///< Linear ramp applied to every device
+    uint16_t dropoutPerMille = 0;       ///< Reads that find no device, per 1000
+    uint16_t crcErrorPerMille = 0;      ///< Scratchpad reads corrupted in transit, per 1000
+    uint32_t readLatencyUs = 0;         ///< Busy time per scratchpad or RTD read
+    uint32_t seed = 1;                  ///< Random generator seed
+};
+
+/**
+ * @brief Current simulation time
+ * @return uint32_t Milliseconds (millis() on the target, steady clock on the host)
+ */
+uint32_t simulationMillis();
+
+/**
+ * @brief Replace the simulation clock
+ * @param[in] clock Function returning milliseconds, nullptr restores the default
+ */
+void setSimulationClock(uint32_t (*clock)());
+
+/**
+ * @class SimulationRandom
+ * @brief xorshift32 generator used for noise and fault injection
+ */
+class SimulationRandom {
+public:
+    explicit SimulationRandom(uint32_t seed) : _state(seed ? seed : 0x9E3779B9u) {}
+
+    /**
+     * @brief Next raw value
+     * @return uint32_t Uniform 32-bit value
+     */
+    uint32_t next() {
+        _state ^= _state << 13;
+        _state ^= _state >> 17;
+        _state ^= _state << 5;
+        return _state;
+    }
+
+    /**
+     * @brief Uniform value in [-1, 1]
+     * @return float Sample
+     */
+    float symmetric() { return (float)(next() & 0xFFFF) / 32767.5f - 1.0f; }
+
+    /**
+     * @brief Bernoulli trial
+     * @param[in] perMille Probability per 1000
+     * @return true with the given probability
+     */
+    bool chance(uint16_t perMille) { return perMille && (next() % 1000) < perMille; }
+
+private:
+    uint32_t _state;    ///< Generator state, never 0
+};
+
+/**
+ * @class SimulatedOneWireBus
+ * @brief A bus of simulated DS18B20 devices
+ */
+class SimulatedOneWireBus : public OneWireInterface {
+public:
+    /**
+     * @brief Create a bus with profile.devicesPerBus devices
+     * @param[in] pin Nominal GPIO pin (also salts the generated ROMs)
+     * @param[in] profile Device behaviour
+     */
+    SimulatedOneWireBus(uint8_t pin, const SimulationProfile& profile);
+
+    uint8_t getPin() const override { return _pin; }
+    void lock() override { _mutex.lock(); }
+    void unlock() override { _mutex.unlock(); }
+    bool begin() override { return false; } // Simulated devices are externally powered
+    bool convertAll() override;
+    bool convert(const uint8_t* rom) override;
+    bool readScratchPad(const uint8_t* rom, uint8_t* scratchPad) override;
+    bool writeScratchPad(const uint8_t* rom, const uint8_t* scratchPad) override;
+    bool setResolution(const uint8_t* rom, uint8_t bits) override;
+    bool isConnected(const uint8_t* rom) override;
+    void resetSearch() override { _searchIndex = 0; }
+    bool search(uint8_t* rom, bool alarmOnly = false) override;
+
+    /**
+     * @brief Number of simulated devices (present or not)
+     * @return size_t Device count
+     */
+    size_t getDeviceCount() const { return _devices.size(); }
+
+    /**
+     * @brief ROM of a simulated device
+     * @param[in] index Device index
+     * @return const uint8_t* 8-byte ROM
+     */
+    const uint8_t* getDeviceRom(size_t index) const { return _devices[index].rom; }
+
+    /**
+     * @brief Attach or detach a device (hot-plug)
+     * @param[in] index Device index
+     * @param[in] present false makes the device silent on the bus
+     */
+    void setPresent(size_t index, bool present) { _devices[index].present = present; }
+
+    /**
+     * @brief Set the offset of one device from the profile base temperature
+     * @param[in] index Device index
+     * @param[in] offsetC Offset in °C
+     */
+    void setOffset(size_t index, float offsetC) { _devices[index].offsetC = offsetC; }
+
+private:
+    /**
+     * @struct Device
+     * @brief State of one simulated DS18B20
+     */
+    struct Device {
+        uint8_t rom[8];             ///< ROM, CRC in byte 7
+        float offsetC;              ///< Offset from the base temperature
+        bool present;               ///< Answers on the bus
+        uint8_t resolution;         ///< Conversion resolution in bits
+        int8_t th;                  ///< High alarm limit
+        int8_t tl;                  ///< Low alarm limit
+        int16_t rawTemp;            ///< Last completed conversion, 1/16 °C
+        int16_t pendingRaw;         ///< Result of the running conversion
+        bool converting;            ///< A conversion is running
+        uint32_t convertStartMs;    ///< Start of the running conversion
+    };
+
+    Device* _find(const uint8_t* rom);
+    void _startConversion(Device& device, uint32_t now);
+    void _settle(Device& device, uint32_t now);
+    void _busy() const;
+
+    uint8_t _pin;                       ///< Nominal GPIO pin
+    SimulationProfile _profile;         ///< Device behaviour
+    SimulationRandom _random;           ///< Noise and fault source
+    std::vector<Device> _devices;       ///< Simulated devices
+    size_t _searchIndex;                ///< Next device returned by search()
+    uint32_t _startMs;                  ///< Creation time, origin of the drift ramp
+    std::recursive_mutex _mutex;        ///< Bus lock
+};
+
+/**
+ * @class SimulatedRtd
+ * @brief A simulated PT100/PT1000 behind a MAX31865
+ */
+class SimulatedRtd : public RtdInterface {
+public:
+    /**
+     * @brief Create a simulated channel
+     * @param[in] csPin Nominal chip select pin (also salts the temperature offset)
+     * @param[in] profile Device behaviour
+     * @param[in] nominal RTD resistance at 0 °C in ohms
+     * @param[in] refResistor Reference resistor in ohms
+     */
+    SimulatedRtd(uint8_t csPin, const SimulationProfile& profile,
+                 double nominal = RTD_PT1000_NOMINAL, double refResistor = 4300.0);
+
+    uint8_t getChipSelectPin() const override { return _csPin; }
+    bool begin() override { return true; }
+    void configure(bool continuous, bool filter50Hz) override { _continuous = continuous; (void)filter50Hz; }
+    void readLatest(uint16_t& raw, uint8_t& fault) override { _read(raw, fault); }
+    void readOneShot(uint16_t& raw, uint8_t& fault) override { _read(raw, fault); }
+    void setBias(bool on) override { (void)on; }
+    void startOneShot() override {}
+    void clearFault() override {}
+
+    /**
+     * @brief Set the simulated temperature offset from the profile base
+     * @param[in] offsetC Offset in °C
+     */
+    void setOffset(float offsetC) { _offsetC = offsetC; }
+
+private:
+    void _read(uint16_t& raw, uint8_t& fault);
+
+    uint8_t _csPin;                 ///< Nominal chip select pin
+    SimulationProfile _profile;     ///< Device behaviour
+    SimulationRandom _random;       ///< Noise and fault source
+    double _nominal;                ///< R0 in ohms
+    double _refResistor;            ///< Reference resistor in ohms
+    float _offsetC;                 ///< Offset from the base temperature
+    bool _continuous;               ///< Auto-convert selected
+    uint32_t _startMs;              ///< Creation time, origin of the drift ramp
+};
+
+#endif // SIMULATED_SENSOR_BUS_H
@@ -0,0 +1,210 @@
+/**
+ * @file SpscRing.h
+ * @brief Lock-free single-producer, single-consumer ring buffer
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Passes small records from the acquisition task to the Arduino loop
+ *          task without a mutex. The producer only writes the head index and
+ *          the consumer only writes the tail index; a full ring rejects the
+ *          push and counts the drop instead of blocking the producer.
+ *
+ *          SpscHeapRing is the same queue with its capacity chosen at run
+ *          time, for rings sized by the configuration.
+ *
+ * @section dependencies Dependencies
+ * - <atomic> for the head/tail indices
+ * - ExternalMemory.h for SpscHeapRing storage
+ *
+ * @section usage Usage
+ * - Exactly one task calls push(), exactly one task calls pop()
+ * - Capacity must be a power of two (SpscHeapRing rounds it up)
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <utility>
+#include "ExternalMemory.h"
+
+/**
+ * @class SpscRing
+ * @brief Fixed-capacity SPSC queue of trivially copyable records
+ * @tparam T Record type
+ * @tparam N Capacity, a power of two
+ */
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    SpscRing() : _head(0), _tail(0), _dropped(0) {}
+
+    /**
+     * @brief Append a record (producer side)
+     * @param[in] item Record to copy into the ring
+     * @return false if the ring was full and the record was dropped
+     */
+    bool push(const T& item) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= N) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        _items[head & (N - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest record (consumer side)
+     * @param[out] item Destination for the record
+     * @return false if the ring was empty
+     */
+    bool pop(T& item) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) return false;
+        item = _items[tail & (N - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Number of records waiting
+     * @return size_t Records pushed but not yet popped
+     */
+    size_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Number of records rejected because the ring was full
+     * @return uint32_t Drops since start
+     */
+    uint32_t getDropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Ring capacity
+     * @return size_t N
+     */
+    static constexpr size_t capacity() { return N; }
+
+private:
+    T _items[N];                      ///< Record storage
+    std::atomic<uint32_t> _head;      ///< Next slot to write (producer only)
+    std::atomic<uint32_t> _tail;      ///< Next slot to read (consumer only)
+    std::atomic<uint32_t> _dropped;   ///< Pushes rejected on a full ring
+};
+
+/**
+ * @class SpscHeapRing
+ * @brief SPSC queue of trivially copyable records with run-time capacity
+ * @tparam T Record type
+ * @details Storage comes from externalAlloc() (PSRAM when available). Until
+ *          allocate() succeeds the capacity is 0 and every push is dropped.
+ */
+template <typename T>
+class SpscHeapRing {
+public:
+    SpscHeapRing() : _items(nullptr), _capacity(0), _head(0), _tail(0), _dropped(0) {}
+
+    ~SpscHeapRing() { externalFree(_items); }
+
+    SpscHeapRing(const SpscHeapRing&) = delete;
+    SpscHeapRing& operator=(const SpscHeapRing&) = delete;
+
+    /**
+     * @brief Size the ring and empty it
+     * @param[in] records Minimum capacity, rounded up to a power of two
+     * @return false if memory ran out (the previous storage is kept)
+     * @note Not safe while a producer or consumer is active.
+     */
+    bool allocate(size_t records) {
+        size_t capacity = 2;
+        while (capacity < records) capacity <<= 1;
+        T* items = static_cast<T*>(externalAlloc(sizeof(T) * capacity));
+        if (items == nullptr) return false;
+        externalFree(_items);
+        _items = items;
+        _capacity = capacity;
+        _head.store(0, std::memory_order_relaxed);
+        _tail.store(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Exchange storage and queued records with another ring
+     * @param[in,out] other Ring to swap with; drop counters stay in place
+     * @note Not safe while a producer or consumer is active.
+     */
+    void swap(SpscHeapRing& other) {
+        std::swap(_items, other._items);
+        std::swap(_capacity, other._capacity);
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        _head.store(other._head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        _tail.store(other._tail.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other._head.store(head, std::memory_order_relaxed);
+        other._tail.store(tail, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Append a record (producer side)
+     * @param[in] item Record to copy into the ring
+     * @return false if the ring was full and the record was dropped
+     */
+    bool push(const T& item) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= _capacity) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        _items[head & (_capacity - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest record (consumer side)
+     * @param[out] item Destination for the record
+     * @return false if the ring was empty
+     */
+    bool pop(T& item) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) return false;
+        item = _items[tail & (_capacity - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Number of records waiting
+     * @return size_t Records pushed but not yet popped
+     */
+    size_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Number of records rejected because the ring was full
+     * @return uint32_t Drops since start
+     */
+    uint32_t getDropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Ring capacity
+     * @return size_t Records the ring holds, 0 before allocate()
+     */
+    size_t capacity() const { return _capacity; }
+
+private:
+    T* _items;                        ///< Record storage (externalAlloc)
+    size_t _capacity;                 ///< Number of slots, a power of two
+    std::atomic<uint32_t> _head;      ///< Next slot to write (producer only)
+    std::atomic<uint32_t> _tail;      ///< Next slot to read (consumer only)
+    std::atomic<uint32_t> _dropped;   ///< Pushes rejected on a full ring
+};
+
+#endif // SPSC_RING_H
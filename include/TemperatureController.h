@@ -12,13 +12,13 @@
  * - OneWire library for DS18B20 sensors
  * - DallasTemperature for DS18B20 communication
  * - ArduinoJson for JSON serialization
- * - Custom classes: Sensor, MeasurementPoint, RegisterMap, IndicatorInterface, Alarm
+ * - Custom classes: Sensor, MeasurementPoint, RegisterMap, IndicatorInterface, Alarm, AlarmSlotTable, AlarmCounters, AlarmQueues
  * 
  * @section hardware Hardware Requirements
  * - Up to 4 OneWire buses for DS18B20 sensors
  * - Up to 4 SPI chip select pins for PT1000 sensors
- * - Support for up to 50 DS18B20 sensors
- * - Support for up to 10 PT1000 sensors
+ * - Measurement point count set at startup (default 50 DS18B20 + 10 PT1000,
+ *   up to POINT_REGISTRY_MAX_POINTS), point tables in PSRAM
  * - LED indicators and relay outputs for alarm signaling
  */
 
@@ -28,13 +28,117 @@
 #include <vector>
 #include "Sensor.h"
 #include "MeasurementPoint.h"
+#include "PointRegistry.h"
 #include "RegisterMap.h"
 #include "IndicatorInterface.h"
 #include "Alarm.h"
-#include <OneWire.h>
-#include <DallasTemperature.h>
+#include "AlarmSlotTable.h"
+#include "AlarmCounters.h"
+#include "AlarmQueues.h"
+#include "PointSnapshot.h"
+#include "SpscRing.h"
+#include "RomIndex.h"
+#include "SensorBus.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
 #include <ArduinoJson.h>
 #include <algorithm>
+#include "ExternalMemory.h"
+
+/**
+ * @enum AcquisitionMode
+ * @brief Strategy used to collect DS18B20 readings
+ */
+enum class AcquisitionMode {
+    PER_SENSOR,     ///< Convert and read each sensor individually (one conversion wait per sensor)
+    BUS_SWEEP       ///< One Skip-ROM Convert-T per bus, single wait, then read every scratchpad
+};
+
+constexpr long ACQ_IDLE_POLL_MS = 100;  ///< Longest acquisition task sleep while no sensor is due
+constexpr unsigned long FORCED_SWEEP_TIMEOUT_MS = 5000; ///< Longest updateAllSensors() wait on the acquisition task
+constexpr unsigned long ALARM_SCREEN_INTERVAL_MS = 1000; ///< Period of the DS18B20 hardware alarm search
+
+constexpr unsigned long DISCOVERY_PASS_INTERVAL_MS = 5000; ///< Pause between background ROM search passes
+constexpr uint8_t DISCOVERY_MISSES_TO_VANISH = 3;          ///< Missed passes before a sensor is reported gone
+constexpr uint8_t DISCOVERY_FAILED_ROM_SLOTS = 8;          ///< Hot-plugged ROMs remembered after a failed initialize()
+constexpr uint8_t ALARM_EVENTS_PER_UPDATE = 4;             ///< Alarm transition records logged per update()
+constexpr size_t SENSOR_ROM_INDEX_SLOTS = 128; ///< ROM index slots; holds up to 96 DS18B20 sensors
+constexpr uint8_t SENSOR_CS_INDEX_SIZE = 40;   ///< Chip-select index size, covers every ESP32 GPIO
+
+using SensorRomIndex = RomIndex<Sensor, SENSOR_ROM_INDEX_SLOTS>; ///< DS18B20 lookup by packed ROM
+using ExternalJsonDocument = BasicJsonDocument<ExternalJsonAllocator>; ///< API document, in PSRAM when present
+
+/**
+ * @enum DiscoveryEventType
+ * @brief Hot-plug change found by the background ROM search
+ */
+enum class DiscoveryEventType : uint8_t {
+    ADDED,          ///< ROM not known to the controller appeared on a bus
+    VANISHED,       ///< Known sensor missing for DISCOVERY_MISSES_TO_VANISH passes
+    REAPPEARED      ///< Vanished sensor answers the search again
+};
+
+/**
+ * @struct DiscoveryEvent
+ * @brief Hot-plug event passed from the acquisition task to the loop task
+ */
+struct DiscoveryEvent {
+    DiscoveryEventType type;  ///< What changed
+    uint8_t bus;              ///< OneWire bus index (0-3)
+    uint8_t rom[8];           ///< Device ROM
+};
+
+/**
+ * @enum AcquisitionPhase
+ * @brief State of the cooperative BUS_SWEEP acquisition engine
+ */
+enum class AcquisitionPhase {
+    IDLE,           ///< No sweep in progress; next step issues Convert-T once a sensor is due
+    CONVERTING,     ///< Conversions running, waiting for the deadline
+    READING,        ///< Reading scratchpads, a bounded slice per step
+    PUBLISH,        ///< Sweep complete, results handed to consumers
+    SCREENING       ///< Between sweeps: conversion for a hardware alarm search running
+};
+
+/**
+ * @struct BusTiming
+ * @brief Timing of the last acquisition sweep on one OneWire bus
+ */
+struct BusTiming {
+    unsigned long lastSweepStart = 0;  ///< millis() when Convert-T was issued
+    uint16_t conversionMs = 0;         ///< Time between Convert-T and first scratchpad read
+    uint16_t readMs = 0;               ///< Time spent reading all scratchpads on the bus
+    uint16_t sweepMs = 0;              ///< Total sweep duration for the bus
+    uint8_t sensorCount = 0;           ///< DS18B20 sensors due at the start of the last sweep
+    LogHistogram<HEALTH_SWEEP_BASE_MS> sweepHistogram; ///< Sweep durations in ms since boot
+};
+
+/**
+ * @enum ConversionGroupState
+ * @brief Progress of one resolution group within a sweep
+ */
+enum class ConversionGroupState {
+    IDLE,           ///< No sensors at this resolution in the current sweep
+    CONVERTING,     ///< Conversion running until the group deadline
+    READING,        ///< Scratchpads of the group are being read
+    DONE            ///< Group finished for this sweep
+};
+
+/**
+ * @struct ConversionGroup
+ * @brief DS18B20 sensors sharing one resolution (and conversion time)
+ * @details The slowest group is converted once per sweep. Faster groups are
+ *          re-converted with Match-ROM Convert-T as long as another conversion
+ *          completes before the slowest group does.
+ */
+struct ConversionGroup {
+    ConversionGroupState state = ConversionGroupState::IDLE; ///< Progress in the current sweep
+    unsigned long deadline = 0;        ///< millis() when the running conversion completes
+    size_t readIndex = 0;              ///< Next _sweepSensors index to check while reading
+    uint8_t sensorCount = 0;           ///< DS18B20 sensors at this resolution
+    uint16_t passes = 0;               ///< Conversions read during the current/last sweep
+};
 
 /**
  * @class TemperatureController
@@ -70,24 +174,92 @@ public:
     // Measurement point management
     /**
      * @brief Get measurement point by address
-     * @param[in] address Point address (0-49 for DS18B20, 50-59 for PT1000)
+     * @param[in] address Point address (DS18B20 first, then PT1000 from getPT1000Base())
      * @return MeasurementPoint* Pointer to measurement point or nullptr if invalid address
      */
     MeasurementPoint* getMeasurementPoint(uint8_t address);
     
     /**
      * @brief Get DS18B20 measurement point by index
-     * @param[in] idx Index in DS18B20 array (0-49)
+     * @param[in] idx Index among DS18B20 points (0 to getDS18B20PointCount()-1)
      * @return MeasurementPoint* Pointer to DS18B20 point or nullptr if invalid index
      */
     MeasurementPoint* getDS18B20Point(uint8_t idx);
     
     /**
      * @brief Get PT1000 measurement point by index
-     * @param[in] idx Index in PT1000 array (0-9)
+     * @param[in] idx Index among PT1000 points (0 to getPT1000PointCount()-1)
      * @return MeasurementPoint* Pointer to PT1000 point or nullptr if invalid index
      */
     MeasurementPoint* getPT1000Point(uint8_t idx);
+
+    /**
+     * @brief Resize the measurement point registry
+     * @param[in] dsCount Number of DS18B20 points
+     * @param[in] ptCount Number of PT1000 points
+     * @return false if the acquisition task is running, the total exceeds
+     *         POINT_REGISTRY_MAX_POINTS or memory ran out (layout unchanged)
+     * @details Call at startup before points are loaded and sensors bound:
+     *          points, register map and snapshot buffers are recreated.
+     */
+    bool allocatePoints(uint8_t dsCount, uint8_t ptCount);
+
+    /**
+     * @brief Get number of allocated measurement points
+     * @return uint16_t DS18B20 + PT1000 points
+     */
+    uint16_t getPointCount() const { return _points.size(); }
+
+    /**
+     * @brief Get the hot field arrays of all measurement points
+     * @return const PointHotStore& Current/min/max, thresholds and status bits by address
+     */
+    const PointHotStore& getHotStore() const { return _points.hot(); }
+
+    /**
+     * @brief Get the sequence number of the latest point change
+     * @return uint32_t Pass to getPointsJson() to fetch only later changes
+     */
+    uint32_t getPointSequence() const { return _points.hot().getSequence(); }
+
+    /**
+     * @brief Get the epoch the point sequence belongs to
+     * @return uint32_t Random value chosen at boot; a client holding a sequence
+     *         from another epoch must reload the full point list
+     */
+    uint32_t getPointEpoch() const { return _pointEpoch; }
+
+    /**
+     * @brief Get number of DS18B20 measurement points
+     * @return uint8_t Count
+     */
+    uint8_t getDS18B20PointCount() const { return _points.getDS18B20Count(); }
+
+    /**
+     * @brief Get number of PT1000 measurement points
+     * @return uint8_t Count
+     */
+    uint8_t getPT1000PointCount() const { return _points.getPT1000Count(); }
+
+    /**
+     * @brief Get address of the first PT1000 point
+     * @return uint8_t Address (equals the DS18B20 point count)
+     */
+    uint8_t getPT1000Base() const { return _points.getPT1000Base(); }
+
+    /**
+     * @brief Check if address is for DS18B20 sensor
+     * @param[in] address Point address to check
+     * @return true if DS18B20 address
+     */
+    bool isDS18B20Address(uint8_t address) const { return _points.isDS18B20Address(address); }
+    
+    /**
+     * @brief Check if address is for PT1000 sensor
+     * @param[in] address Point address to check
+     * @return true if PT1000 address
+     */
+    bool isPT1000Address(uint8_t address) const { return _points.isPT1000Address(address); }
     
     // Sensor management
     /**
@@ -112,6 +284,13 @@ public:
      * @return Sensor* Pointer to sensor or nullptr if not found
      */
     Sensor* findSensorByRom(const String& romString);
+
+    /**
+     * @brief Find sensor by ROM address bytes
+     * @param[in] rom 8-byte ROM address
+     * @return Sensor* Pointer to sensor or nullptr if not found
+     */
+    Sensor* findSensorByRom(const uint8_t* rom);
     
     /**
      * @brief Find PT1000 sensor by chip select pin
@@ -132,6 +311,13 @@ public:
      * @return Sensor* Pointer to sensor or nullptr if invalid index
      */
     Sensor* getSensorByIndex(int idx);
+
+    /**
+     * @brief Get DS18B20 sensors attached to one OneWire bus
+     * @param[in] bus Bus index (0-3)
+     * @return const std::vector<Sensor*>& Sensors on the bus, in discovery order
+     */
+    const std::vector<Sensor*>& getBusSensors(uint8_t bus) const { return _busSensors[bus & 3]; }
     
     // Sensor binding
     /**
@@ -178,16 +364,20 @@ public:
     // Main update and measurement
     /**
      * @brief Main update function - must be called in loop()
-     * @details Reads sensors, updates alarms, handles display and outputs
+     * @details Advances sensor acquisition by one bounded slice, updates alarms,
+     *          handles display and outputs. Never blocks on a DS18B20 conversion
+     *          in BUS_SWEEP mode.
      * @note Call this regularly for proper system operation
      */
     void update();
     
     /**
      * @brief Read temperature from all configured measurement points
-     * @details Updates temperature values for all points with bound sensors
+     * @return true if a new acquisition snapshot was applied
+     * @details Updates all points from the latest published acquisition
+     *          snapshot; does not touch the sensors themselves.
      */
-    void readAllPoints();
+    bool readAllPoints();
     
     /**
      * @brief Update register map with current values from measurement points
@@ -227,17 +417,25 @@ public:
     // JSON output
     /**
      * @brief Get JSON representation of all sensors
-     * @return String JSON array of sensor objects
-     * @details Includes sensor type, ROM/CS, binding status, and current value
+     * @return String JSON array of sensor objects, empty if the document overflowed
+     * @details Includes sensor type, ROM/CS, binding status, and current value.
+     *          The document is sized from the sensor count and allocated in PSRAM
+     *          when available.
      */
     String getSensorsJson();
     
     /**
-     * @brief Get JSON representation of all measurement points
-     * @return String JSON array of measurement point objects
-     * @details Includes point address, name, value, limits, and alarm status
+     * @brief Get JSON representation of measurement points
+     * @param[in] since Change sequence the client already has (0 = all points)
+     * @return String JSON array of measurement point objects, empty if the document overflowed
+     * @details Includes point address, name, value, limits, and alarm status.
+     *          With @p since only points changed afterwards are listed; "sequence"
+     *          is the value to pass next time and "full" marks a complete list
+     *          (also sent when @p since is ahead of the device). "epoch" changes
+     *          on every boot; a client must discard a delta whose epoch differs
+     *          from the one its sequence came from and reload with since=0.
      */
-    String getPointsJson();
+    String getPointsJson(uint32_t since = 0);
     
     /**
      * @brief Get JSON representation of system status
@@ -309,6 +507,13 @@ public:
      * @return uint8_t GPIO pin number or 0xFF if invalid bus
      */
     uint8_t getOneWirePin(size_t bus);
+
+    /**
+     * @brief Get shared driver of a OneWire bus
+     * @param[in] bus Bus index (0-3)
+     * @return OneWireInterface* Bus driver, nullptr if index is invalid
+     */
+    OneWireInterface* getOneWireBus(size_t bus) { return bus < 4 ? oneWireBuses[bus] : nullptr; }
     
     // Statistics
     /**
@@ -325,9 +530,171 @@ public:
     
     /**
      * @brief Update temperature readings for all sensors
-     * @details Forces immediate temperature reading from all sensors
+     * @details Forces immediate temperature reading from all sensors and
+     *          blocks until the resulting snapshot is published. In BUS_SWEEP
+     *          mode a running acquisition task is asked for the sweep (waiting
+     *          at most FORCED_SWEEP_TIMEOUT_MS); without the task the engine is
+     *          driven here, after any sweep already in flight has finished.
+     *          update() does not use it in BUS_SWEEP mode.
      */
     void updateAllSensors();
+
+    /**
+     * @brief Select how DS18B20 sensors are acquired
+     * @param[in] mode PER_SENSOR or BUS_SWEEP
+     */
+    void setAcquisitionMode(AcquisitionMode mode) { acquisitionMode = mode; }
+
+    /**
+     * @brief Get current DS18B20 acquisition mode
+     * @return AcquisitionMode Active acquisition strategy
+     */
+    AcquisitionMode getAcquisitionMode() const { return acquisitionMode; }
+
+    /**
+     * @brief Select PT1000 conversion mode for all MAX31865 channels
+     * @param[in] continuous true: auto-convert with bias on, reads fetch the RTD register
+     * @param[in] filter50Hz true for 50 Hz mains filter, false for 60 Hz
+     * @details Applied to discovered PT1000 sensors immediately and to sensors
+     *          found by later discoveries.
+     */
+    void setPT1000ContinuousMode(bool continuous, bool filter50Hz = true);
+
+    /**
+     * @brief Enable per-sensor adaptive sampling intervals
+     * @param[in] enabled true: a sweep reads only sensors whose interval has
+     *            elapsed; false: every sweep reads every sensor
+     */
+    void setAdaptiveSampling(bool enabled);
+
+    /**
+     * @brief Check if adaptive sampling is enabled
+     * @return true if sensors are read on their own intervals
+     */
+    bool isAdaptiveSampling() const { return _adaptiveSampling; }
+
+    /**
+     * @brief Enable DS18B20 hardware alarm screening
+     * @param[in] enabled true: thresholds are written to TH/TL and an Alarm
+     *            Search (0xEC) runs on every bus between sweeps
+     * @details A device found by the search is read at the next sweep
+     *          regardless of its sampling interval, so threshold excursions
+     *          are caught with one bus operation instead of reading every
+     *          sensor.
+     */
+    void setHardwareAlarmScreening(bool enabled);
+
+    /**
+     * @brief Check if DS18B20 hardware alarm screening is enabled
+     * @return true if alarm searches run between sweeps
+     */
+    bool isHardwareAlarmScreening() const { return _alarmScreening; }
+
+    /**
+     * @brief Get number of devices reported by alarm searches
+     * @return uint32_t Alarm search hits since boot
+     */
+    uint32_t getAlarmScreenHits() const { return _alarmScreenHits; }
+
+    /**
+     * @brief Enable continuous background ROM discovery
+     * @param[in] enabled true: the acquisition engine searches one device per
+     *            slice and reports added/vanished DS18B20 sensors
+     * @details Events are applied on the loop task by update(): new sensors
+     *          are initialized and added, vanished unbound sensors removed.
+     */
+    void setBackgroundDiscovery(bool enabled);
+
+    /**
+     * @brief Check if background ROM discovery is enabled
+     * @return true if hot-plug detection runs
+     */
+    bool isBackgroundDiscovery() const { return _discoveryEnabled; }
+
+    /**
+     * @brief Get number of completed background ROM search passes
+     * @return uint32_t Passes over all four buses since boot
+     */
+    uint32_t getDiscoveryPasses() const { return _discoveryPasses; }
+
+    /**
+     * @brief Select the RTD element fitted on all MAX31865 channels
+     * @param[in] nominal Resistance at 0°C (RTD_PT1000_NOMINAL or RTD_PT100_NOMINAL)
+     * @return false if a fitted channel rejected the element with its reference resistor
+     */
+    bool setRtdNominal(float nominal);
+
+    /**
+     * @brief Set the calibrated reference resistor of one MAX31865 channel
+     * @param[in] channel Channel index (0-3, same order as the chip select pins)
+     * @param[in] refResistor Measured reference resistance in ohms
+     * @return false if the channel is invalid or its sensor rejected the calibration
+     *         (RREF must be between R0 and RTD_MAX_REF_RATIO x R0)
+     */
+    bool setRtdReference(size_t channel, float refResistor);
+
+    /**
+     * @brief Check if PT1000 channels run in continuous-conversion mode
+     * @return true if MAX31865 auto-convert is selected
+     */
+    bool isPT1000ContinuousMode() const { return _ptContinuous; }
+
+    /**
+     * @brief Get timing of the last sweep on a OneWire bus
+     * @param[in] bus Bus index (0-3)
+     * @return const BusTiming& Timing record for the bus
+     */
+    const BusTiming& getBusTiming(size_t bus) const { return busTiming[bus < 4 ? bus : 0]; }
+
+    /**
+     * @brief Get read statistics of one OneWire bus
+     * @param[in] bus Bus index (0-3)
+     * @return HealthCounters Sum over the DS18B20 sensors currently on the bus
+     */
+    HealthCounters getBusHealth(uint8_t bus) const;
+
+    /**
+     * @brief Get read statistics of one MAX31865 chip select
+     * @param[in] channel Channel index (0-3)
+     * @return HealthCounters Statistics of the PT1000 on that chip select (empty if none)
+     */
+    HealthCounters getChipSelectHealth(uint8_t channel) const;
+
+    /**
+     * @brief Get current phase of the cooperative acquisition engine
+     * @return AcquisitionPhase Current phase
+     */
+    AcquisitionPhase getAcquisitionPhase() const { return _acqPhase; }
+
+    /**
+     * @brief Set the time budget for one READING slice
+     * @param[in] budgetUs Microseconds after which update() stops reading scratchpads
+     * @note At least one sensor is read per slice regardless of the budget
+     */
+    void setAcquisitionSliceBudget(uint32_t budgetUs) { _acqSliceBudgetUs = budgetUs; }
+
+    /**
+     * @brief Start the dedicated sensor acquisition task
+     * @param[in] core CPU core to pin the task to (default 1, WiFi runs on core 0)
+     * @param[in] priority FreeRTOS task priority
+     * @return true if the task is running
+     * @details Once started, update() no longer touches the sensor buses; the
+     *          task runs the acquisition engine and publishes each completed
+     *          sweep into the point snapshot.
+     */
+    bool startAcquisitionTask(BaseType_t core = 1, UBaseType_t priority = 2);
+
+    /**
+     * @brief Check if the acquisition task is running
+     * @return true if sensors are acquired by the dedicated task
+     */
+    bool isAcquisitionTaskRunning() const { return _acqTask != nullptr; }
+
+    /**
+     * @brief Get sequence number of the latest published sweep
+     * @return uint32_t Number of sweeps published since start
+     */
+    uint32_t getSnapshotSequence() const { return _pointSnapshot.getSequence(); }
     
     /**
      * @brief Get bus number for a sensor
@@ -339,7 +706,11 @@ public:
     // New Alarm Management
     /**
      * @brief Update alarm states for all measurement points
-     * @details Checks alarm conditions and updates alarm states
+     * @details Event driven: returns at once unless a point changed since the
+     *          last pass or an alarm deadline (acknowledgment delay, settling
+     *          NEW/CLEARED alarm) expired; then only the affected alarms are
+     *          updated: the slots of changed points, the settling alarms and
+     *          the acknowledged queue. Cheap enough to call on every loop iteration.
      */
     void updateAlarms();
     
@@ -452,10 +823,18 @@ public:
     
     /**
      * @brief Find alarm by configuration key
-     * @param[in] configKey Alarm configuration key
+     * @param[in] configKey "alarm_<point>_<type>" or "P<point>_<TYPE>"; both name the same slot
      * @return Alarm* Pointer to alarm or nullptr if not found
      */
     Alarm* findAlarm(const String& configKey);
+
+    /**
+     * @brief Find the alarm of a point
+     * @param[in] pointAddress Measurement point address
+     * @param[in] type Alarm type
+     * @return Alarm* Pointer to alarm or nullptr if not configured
+     */
+    Alarm* findAlarm(uint8_t pointAddress, AlarmType type) const { return _alarmSlots.get(pointAddress, type); }
     
     /**
      * @brief Get alarm by index
@@ -605,20 +984,21 @@ public:
     void applyAcknowledgedDelaysToAlarms();
 
     /**
-     * @brief Get count of alarms by priority
+     * @brief Get count of enabled alarms by priority
      * @param[in] priority Priority level to count
-     * @param[in] comparison Comparison operator ("==", ">=", "<=", ">", "<")
+     * @param[in] comparison Applied as (alarm priority) op (priority)
      * @return int Number of alarms matching criteria
+     * @details O(1), read from the priority/stage counters
      */
-    int getAlarmCount(AlarmPriority priority, const String& comparison = "==") const;
+    int getAlarmCount(AlarmPriority priority, AlarmCompare comparison = AlarmCompare::EQ) const;
     
     /**
-     * @brief Get count of alarms by stage
+     * @brief Get count of enabled alarms by stage
      * @param[in] stage Alarm stage to count
-     * @param[in] comparison Comparison operator ("==", "!=")
+     * @param[in] comparison Applied as (alarm stage) op (stage), stages in enum order
      * @return int Number of alarms matching criteria
      */
-    int getAlarmCount(AlarmStage stage, const String& comparison = "==") const;
+    int getAlarmCount(AlarmStage stage, AlarmCompare comparison = AlarmCompare::EQ) const;
     
     /**
      * @brief Get count of alarms by priority and stage
@@ -628,7 +1008,21 @@ public:
      * @param[in] stageComparison Stage comparison operator
      * @return int Number of alarms matching both criteria
      */
-    int getAlarmCount(AlarmPriority priority, AlarmStage stage, const String& priorityComparison = "==", const String& stageComparison = "==") const;
+    int getAlarmCount(AlarmPriority priority, AlarmStage stage,
+                      AlarmCompare priorityComparison = AlarmCompare::EQ,
+                      AlarmCompare stageComparison = AlarmCompare::EQ) const;
+
+    /**
+     * @brief Get the number of alarm transitions waiting to be logged
+     */
+    uint16_t getPendingAlarmEvents() const { return (uint16_t)_alarmEvents.size(); }
+
+    /**
+     * @brief Get the number of alarm transitions dropped on a full event ring
+     * @details The ring holds one record per configurable alarm, so drops
+     *          need alarms flapping faster than update() logs them.
+     */
+    uint32_t getDroppedAlarmEvents() const { return _alarmEvents.getDropped(); }
 
 
 
@@ -638,12 +1032,11 @@ public:
 private:
     // Hardware components
     IndicatorInterface& indicator;              ///< Reference to indicator interface for display/LED control
-    OneWire* oneWireBuses[4];                  ///< Array of OneWire bus objects
-    DallasTemperature* dallasSensors[4];       ///< Array of Dallas temperature sensor objects
+    OneWireInterface* oneWireBuses[4];         ///< Shared OneWire bus backends, one per GPIO
     
     // Measurement points and sensors
-    MeasurementPoint dsPoints[50];             ///< Array of DS18B20 measurement points
-    MeasurementPoint ptPoints[10];             ///< Array of PT1000 measurement points
+    PointRegistry _points;                     ///< DS18B20 then PT1000 measurement points (PSRAM)
+    uint32_t _pointEpoch;                      ///< Random per boot; point sequences are only comparable within one epoch
     std::vector<Sensor*> sensors;              ///< Vector of all discovered sensors
     
     // System configuration
@@ -655,11 +1048,61 @@ private:
     bool systemInitialized;                    ///< System initialization flag
     uint8_t oneWireBusPin[4];                 ///< GPIO pins for OneWire buses
     uint8_t chipSelectPin[4];                 ///< Chip select pins for PT1000 sensors
+    AcquisitionMode acquisitionMode;           ///< DS18B20 acquisition strategy
+    BusTiming busTiming[4];                    ///< Timing of the last sweep per OneWire bus
+    AcquisitionPhase _acqPhase;                ///< Current acquisition engine phase
+    unsigned long _acqDeadline;                ///< millis() when running conversions complete
+    ConversionGroup _groups[4];                ///< Resolution groups, index = resolution - 9
+    int8_t _activeGroup;                       ///< Group being read, -1 if none
+    int8_t _slowestGroup;                      ///< Group that ends the sweep
+    std::vector<Sensor*> _sweepSensors;        ///< Sensors due when the sweep started (nullptr = removed)
+    bool _rtdStartPending;                     ///< PT1000 one-shots biased, 1-shot start not yet sent
+    unsigned long _rtdStartAt;                 ///< millis() when the biased one-shots may start
+    uint32_t _acqSliceBudgetUs;                ///< Time budget of one READING slice
+    bool _busReadStarted[4];                   ///< First scratchpad of the sweep read on bus
+    bool _busParasite[4];                      ///< Bus has parasite-powered devices (OneWireInterface::begin())
+    int8_t _busReadGroup[4];                   ///< Only group reading a parasite bus this sweep, -1 = by resolution
+    PointSnapshot _pointSnapshot;              ///< Double-buffered results of the last sweep
+    PointSample* _appliedSamples;              ///< Loop-task copy of the snapshot (PSRAM)
+    uint32_t _appliedSnapshotSequence;         ///< Snapshot sequence last applied to points
+    uint32_t _registerMapSequence;             ///< Point change sequence last copied to the register map
+    TaskHandle_t _acqTask;                     ///< Acquisition task handle (nullptr = run from update())
+    SemaphoreHandle_t _sensorsMutex;           ///< Guards sensor list changes against the acquisition task
+    bool _ptContinuous;                        ///< MAX31865 auto-convert mode for PT1000 sensors
+    bool _ptFilter50Hz;                        ///< MAX31865 mains filter: true 50 Hz, false 60 Hz
+    float _rtdNominal;                         ///< RTD resistance at 0°C for all channels
+    float _ptRefResistor[4];                   ///< Calibrated reference resistor per MAX31865 channel
+    bool _adaptiveSampling;                    ///< Read only sensors whose sampling interval elapsed
+    bool _sampleAll;                           ///< Forced full sweep (updateAllSensors) in progress
+    bool _sampleAllRequested;                  ///< Forced sweep asked of the task, started at the next IDLE step
+    bool _alarmScreening;                      ///< DS18B20 TH/TL alarm search between sweeps
+    unsigned long _lastAlarmScreen;            ///< millis() of the last alarm search conversion
+    uint32_t _alarmScreenHits;                 ///< Devices reported by alarm searches
+    bool _discoveryEnabled;                    ///< Background ROM search for hot-plug detection
+    bool _discoveryActive;                     ///< A background search pass is in progress
+    uint8_t _discoveryBus;                     ///< Bus searched by the current pass
+    bool _discoveryBusStarted;                 ///< Search state of _discoveryBus has been reset
+    unsigned long _discoveryNextPass;          ///< millis() when the next pass may start
+    uint32_t _discoveryPasses;                 ///< Completed background search passes
+    SpscRing<DiscoveryEvent, 16> _discoveryEvents; ///< Hot-plug events for the loop task
+    DiscoveryEvent _failedRoms[DISCOVERY_FAILED_ROM_SLOTS]; ///< ROMs whose initialize() failed, warned once (loop task)
+    uint8_t _failedRomCount;                   ///< Valid entries in _failedRoms
+    uint8_t _failedRomNext;                    ///< Entry overwritten when _failedRoms is full
+    SensorRomIndex _romIndex;                  ///< DS18B20 sensors by packed ROM
+    Sensor* _csIndex[SENSOR_CS_INDEX_SIZE];    ///< PT1000 sensors by chip-select GPIO
+    std::vector<Sensor*> _busSensors[4];       ///< DS18B20 sensors per OneWire bus
     
     // Alarm system
     std::vector<Alarm*> _configuredAlarms;         ///< Vector of configured alarm objects
-    unsigned long _lastAlarmCheck;                 ///< Timestamp of last alarm check
-    const unsigned long _alarmCheckInterval = 1000; ///< Alarm check interval in milliseconds
+    AlarmSlotTable _alarmSlots;                    ///< Configured alarms by point and type
+    AlarmCounters _alarmCounters;                  ///< Enabled alarms by priority and stage
+    AlarmQueues _alarmQueues;                      ///< Active/acknowledged alarms by priority, oldest first
+    uint32_t _alarmSequence;                       ///< Point change sequence last evaluated by the alarms
+    unsigned long _alarmWakeAt;                    ///< Earliest pending alarm deadline (millis)
+    bool _alarmTimerArmed;                         ///< _alarmWakeAt is valid
+    std::vector<uint16_t> _alarmsSettling;         ///< Slot keys (address * ALARM_TYPE_COUNT + type) of NEW/CLEARED alarms
+    AlarmEventRing _alarmEvents;                   ///< Stage transitions waiting to be logged
+    uint32_t _alarmEventsDropReported;             ///< Ring drops already reported in the log
     bool _lastButtonState;                         ///< Previous button state for edge detection
     unsigned long _lastButtonPressTime;            ///< Timestamp of last button press
     const unsigned long _buttonDebounceDelay = 200; ///< Button debounce delay in milliseconds
@@ -678,18 +1121,186 @@ private:
     
     // Internal methods
     /**
-     * @brief Check if address is for DS18B20 sensor
-     * @param[in] address Point address to check
-     * @return true if DS18B20 address (0-49)
+     * @brief Run one bounded slice of the acquisition state machine
+     * @return true if a sweep was published during this call
+     * @details IDLE -> CONVERTING -> READING -> PUBLISH -> IDLE. Never waits
+     *          for a conversion; READING stops once the slice budget is spent.
      */
-    bool isDS18B20Address(uint8_t address) const { return address < 50; }
-    
+    bool _stepAcquisition();
+
     /**
-     * @brief Check if address is for PT1000 sensor
-     * @param[in] address Point address to check
-     * @return true if PT1000 address (50-59)
+     * @brief Issue Skip-ROM Convert-T on every bus with a sensor due
+     * @return false if no sensor is due (or none is configured); _acqDeadline is
+     *         then the earliest due time and the engine stays IDLE
+     * @details Every DS18B20 converts at its own resolution; resets per-bus
+     *          timing and sets one deadline per resolution group. The due
+     *          sensors are captured in _sweepSensors for the rest of the sweep.
+     */
+    bool _startConversions();
+
+    /**
+     * @brief Write thresholds of one DS18B20 with pending TH/TL changes
+     * @details One device per call to keep acquisition slices short.
+     */
+    void _writePendingAlarmLimits();
+
+    /**
+     * @brief Issue Skip-ROM Convert-T for an alarm search
+     * @return true if a conversion was started (phase becomes SCREENING)
+     */
+    bool _startAlarmScreen();
+
+    /**
+     * @brief Run Alarm Search (0xEC) on every bus and mark reported sensors due
+     */
+    void _finishAlarmScreen();
+
+    /**
+     * @brief Advance the background ROM search by one device
+     * @return true if bus time was used in this step
+     * @details Walks buses 0-3 with OneWireInterface::search(); at the end of each bus
+     *          sensors not found are counted as missed. Changes are queued as
+     *          DiscoveryEvent; the sensor list itself is only modified on the
+     *          loop task.
+     */
+    bool _discoveryStep();
+
+    /**
+     * @brief Apply queued hot-plug events (loop task)
+     * @details A ROM that keeps failing initialize() is retried on every pass but
+     *          warned about only once, until it initializes or moves to another bus.
+     */
+    void _processDiscoveryEvents();
+
+    /**
+     * @brief Record a failed hot-plug initialization
+     * @param[in] event ADDED event of the failing device
+     * @return true if this ROM/bus was not already recorded (warn now)
+     */
+    bool _rememberFailedRom(const DiscoveryEvent& event);
+
+    /**
+     * @brief Drop a ROM from the failed-initialization list
+     * @param[in] rom Device ROM
+     */
+    void _forgetFailedRom(const uint8_t* rom);
+
+    /**
+     * @brief Check if a sensor should be read in the current sweep
+     * @param[in] sensor Sensor to check
+     * @param[in] now millis() to evaluate the sampling interval at
+     * @return true if adaptive sampling is off, a full sweep is forced, or the interval elapsed
+     */
+    bool _isSampleDue(Sensor* sensor, unsigned long now) const;
+
+    /**
+     * @brief Find a resolution group whose conversion is complete
+     * @return int Group index, or -1 if none is due yet
+     * @details Also updates _acqDeadline to the earliest pending deadline.
+     */
+    int _nextDueGroup();
+
+    /**
+     * @brief Read the next sensor of a resolution group
+     * @param[in] group Group index (resolution - 9)
+     * @return false when every sensor of the group has been read, or when a
+     *         PT1000 one-shot is not finished; the group is then put back to
+     *         CONVERTING until the one-shot's next step and resumes there
+     * @details Only sensors captured in _sweepSensors are read, so a sensor
+     *          that falls due mid-sweep waits for the next sweep. PT1000
+     *          channels are read once per sweep with the slowest group. A
+     *          parasite bus is read only by its _busReadGroup, once its
+     *          slowest conversion is done, so no traffic drops the strong
+     *          pull-up of a device still converting.
+     */
+    bool _readNextSensor(int group);
+
+    /**
+     * @brief Send the 1-shot start to PT1000 channels biased by _startConversions()
+     * @details One-shot PT1000 reads are split into bias (sweep start), start
+     *          (RTD_BIAS_SETTLE_MS later, here) and collect (with the slowest
+     *          group, whose deadline covers the conversion), so no slice waits
+     *          for the ~75 ms MAX31865 conversion.
+     */
+    void _startRtdOneShots();
+
+    /**
+     * @brief Complete one pass of a resolution group
+     * @param[in] group Group index (resolution - 9)
+     * @details Publishes intermediate results and re-converts the group if
+     *          another pass fits before the slowest group completes. Sensors
+     *          on parasite buses are never re-converted mid-sweep.
+     */
+    void _finishGroup(int group);
+
+    /**
+     * @brief Finish a sweep and hand results to consumers
+     * @details Copies bound sensor readings into the back buffer of the point
+     *          snapshot and publishes it.
+     */
+    void _publishSweep();
+
+    /**
+     * @brief Log sensor quarantine and out-of-range transitions
+     * @details Runs on the loop task after a new snapshot is applied. Each
+     *          error is logged once when raised; quarantine release is logged
+     *          too, so a dead sensor no longer repeats every few minutes.
+     */
+    void _logSensorErrors();
+
+    /**
+     * @brief Refresh the acquisition health registers (4-10)
+     * @details Runs on the loop task after a new snapshot is applied.
+     */
+    void _updateHealthRegisters();
+
+    /**
+     * @brief Write a health record into a JSON object
+     * @param[out] obj Destination object
+     * @param[in] health Statistics to serialize
+     */
+    static void _addHealthJson(JsonObject obj, const HealthCounters& health);
+
+    /**
+     * @brief Push RTD calibration of a channel to its sensor
+     * @param[in] channel Channel index (0-3)
+     * @return false if the sensor rejected the calibration (error logged)
+     */
+    bool _applyRtdCalibration(size_t channel);
+
+    /**
+     * @brief Append a sensor to the list and the ROM, chip-select and bus indices
+     * @param[in] sensor Sensor to register (caller holds the sensor lock)
+     * @return false if the sensor is a duplicate or the ROM index is full
+     */
+    bool _registerSensor(Sensor* sensor);
+
+    /**
+     * @brief Remove a sensor from the list and all indices (does not delete it)
+     * @param[in] sensor Sensor to unregister (caller holds the sensor lock)
+     */
+    void _unregisterSensor(Sensor* sensor);
+
+    /**
+     * @brief FreeRTOS entry point of the acquisition task
+     * @param[in] arg Pointer to the owning TemperatureController
+     */
+    static void _acquisitionTaskEntry(void* arg);
+
+    /**
+     * @brief Acquisition task body; never returns
      */
-    bool isPT1000Address(uint8_t address) const { return address >= 50 && address < 60; }
+    void _acquisitionTaskLoop();
+
+    /**
+     * @brief Take the sensor list mutex (recursive)
+     */
+    void _lockSensors();
+
+    /**
+     * @brief Release the sensor list mutex
+     */
+    void _unlockSensors();
     
     // Alarm helper methods
     /**
@@ -705,6 +1316,52 @@ private:
      * @return true if alarm exists for this point/type combination
      */
     bool _hasAlarmForPoint(MeasurementPoint* point, AlarmType type);
+
+    /**
+     * @brief Take ownership of a new alarm and index it
+     * @param[in] alarm Alarm to add to the list, the slot table and the counters
+     */
+    void _registerAlarm(Alarm* alarm);
+
+    /**
+     * @brief Log queued alarm transitions, at most ALARM_EVENTS_PER_UPDATE per call
+     * @details The alarm engine only pushes AlarmEvent records; the event and
+     *          alarm state log files are written here, so SD latency never
+     *          stalls evaluation. A backlog is worked off over later loops;
+     *          records dropped on a full ring are reported once per burst.
+     */
+    void _processAlarmEvents();
+
+    /**
+     * @brief Write one alarm transition to the event and alarm state logs
+     * @param[in] event Transition record
+     */
+    void _logAlarmEvent(const AlarmEvent& event);
+
+    /**
+     * @brief Check if a point has an enabled, active sensor error or disconnect alarm
+     * @param[in] address Measurement point address
+     * @return true if temperature alarms of the point are to be held resolved
+     */
+    bool _hasSensorFault(uint8_t address) const;
+
+    /**
+     * @brief Update one alarm during an alarm pass
+     * @param[in] alarm Alarm from the slot table (nullptr or disabled is ignored)
+     * @param[in] now millis() of the pass
+     * @param[in] pointChanged true if the alarm's point changed since the last pass
+     * @details Without a point change the alarm is only updated once its
+     *          pending deadline has passed. Alarms left NEW or CLEARED are
+     *          remembered in _alarmsSettling for the next pass.
+     */
+    void _updateAlarm(Alarm* alarm, unsigned long now, bool pointChanged);
+
+    /**
+     * @brief Arm the alarm timer for the earliest pending deadline
+     * @details Scans the settling alarms (dropping those that settled) and the
+     *          acknowledged queue; no other alarm has a deadline.
+     */
+    void _armAlarmTimer();
     
     /**
      * @brief Check for button press and handle acknowledgment
@@ -739,23 +1396,6 @@ private:
     RelayControlMode _relay2Mode = RelayControlMode::AUTO;  ///< Control mode for relay 2
     RelayControlMode _relay3Mode = RelayControlMode::AUTO;  ///< Control mode for relay 3
 
-    /**
-     * @brief Compare alarm priority with comparison operator
-     * @param[in] alarmPriority Priority to compare
-     * @param[in] targetPriority Target priority
-     * @param[in] comparison Comparison operator string
-     * @return true if comparison matches
-     */
-    bool _comparePriority(AlarmPriority alarmPriority, AlarmPriority targetPriority, const String& comparison) const;
-    
-    /**
-     * @brief Compare alarm stage with comparison operator
-     * @param[in] alarmStage Stage to compare
-     * @param[in] targetStage Target stage
-     * @param[in] comparison Comparison operator string
-     * @return true if comparison matches
-     */
-    bool _compareStage(AlarmStage alarmStage, AlarmStage targetStage, const String& comparison) const;
 
     // Blinking control for low priority alarms
     bool _lowPriorityBlinkState = false;           ///< Current blink state for low priority alarms
@@ -769,8 +1409,6 @@ private:
     void _handleLowPriorityBlinking();
 
     // Display management for alarms
-    std::vector<Alarm*> _activeAlarmsQueue;        ///< Queue of active alarms for display rotation
-    std::vector<Alarm*> _acknowledgedAlarmsQueue;  ///< Queue of acknowledged alarms for display
     int _currentActiveAlarmIndex;                  ///< Current index in active alarms queue
     int _currentAcknowledgedAlarmIndex;            ///< Current index in acknowledged alarms queue
     unsigned long _lastAlarmDisplayTime;           ///< Last alarm display update timestamp
@@ -778,11 +1416,6 @@ private:
     bool _displayingActiveAlarm;                   ///< Flag indicating if displaying active alarm
     
     // Helper methods for alarm display
-    /**
-     * @brief Update alarm display queues
-     */
-    void _updateAlarmQueues();
-    
     /**
      * @brief Display next active alarm in rotation
      */
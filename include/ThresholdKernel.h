@@ -0,0 +1,139 @@
+/**
+ * @file ThresholdKernel.h
+ * @brief Batch low/high/error evaluation over the point temperature arrays
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details One definition of "below low / above high threshold" for the whole
+ *          firmware. evaluateThresholds() runs over the contiguous int16 arrays
+ *          of PointHotStore and writes three bitmasks (bit i = point i):
+ *
+ *          - high: temp >= high threshold
+ *          - low:  temp <= low threshold
+ *          - error: error bits != 0; low and high are cleared for such points
+ *
+ *          Hysteresis: a point whose bit is already set keeps it until the
+ *          temperature leaves the band, i.e. high stays set while
+ *          temp >= high - highHysteresis and low while temp <= low + lowHysteresis.
+ *          The previous masks are the latch, so they are read before being
+ *          overwritten and the kernel is idempotent for unchanged inputs.
+ *
+ *          The lane logic is branch-free. Host builds with SSE2 evaluate eight
+ *          points per instruction (evaluateThresholdsSse2); the ESP32 uses the
+ *          portable word loop. Both give identical masks
+ *          (test/threshold_kernel_test.cpp).
+ *
+ * @section dependencies Dependencies
+ * - <stdint.h> only; the kernel builds on the host for tests
+ */
+
+#ifndef THRESHOLD_KERNEL_H
+#define THRESHOLD_KERNEL_H
+
+#include <stdint.h>
+
+#if defined(__SSE2__) && !defined(THRESHOLD_KERNEL_NO_SIMD)
+#define THRESHOLD_KERNEL_SSE2 1
+#else
+#define THRESHOLD_KERNEL_SSE2 0
+#endif
+
+constexpr uint8_t THRESHOLD_BIT_LOW = 0x01;    ///< At or below the low threshold
+constexpr uint8_t THRESHOLD_BIT_HIGH = 0x02;   ///< At or above the high threshold
+
+/**
+ * @brief Number of 32-bit mask words for a point count
+ * @param[in] count Number of points
+ * @return uint16_t Words per mask
+ */
+constexpr uint16_t thresholdMaskWords(uint16_t count) { return (uint16_t)((count + 31u) / 32u); }
+
+/**
+ * @brief Evaluate one point
+ * @param[in] temp Temperature
+ * @param[in] low Low threshold
+ * @param[in] high High threshold
+ * @param[in] error Error bits; any bit suppresses the result
+ * @param[in] lowHysteresis Band kept while the low bit is latched
+ * @param[in] highHysteresis Band kept while the high bit is latched
+ * @param[in] latched THRESHOLD_BIT_* bits of the previous evaluation
+ * @return uint8_t THRESHOLD_BIT_* bits
+ */
+inline uint8_t thresholdBits(int16_t temp, int16_t low, int16_t high, uint8_t error,
+                             int16_t lowHysteresis = 0, int16_t highHysteresis = 0,
+                             uint8_t latched = 0) {
+    const int32_t latchedLow = latched & THRESHOLD_BIT_LOW;
+    const int32_t latchedHigh = (latched & THRESHOLD_BIT_HIGH) >> 1;
+    const uint32_t isLow = temp <= (int32_t)low + (lowHysteresis & -latchedLow);
+    const uint32_t isHigh = temp >= (int32_t)high - (highHysteresis & -latchedHigh);
+    const uint32_t ok = error == 0;
+    return (uint8_t)((isLow & ok) | ((isHigh & ok) << 1));
+}
+
+/**
+ * @struct ThresholdArrays
+ * @brief Kernel inputs, all with count entries
+ */
+struct ThresholdArrays {
+    const int16_t* temp;             ///< Temperatures
+    const int16_t* low;              ///< Low thresholds
+    const int16_t* high;             ///< High thresholds
+    const int16_t* lowHysteresis;    ///< Low alarm hysteresis
+    const int16_t* highHysteresis;   ///< High alarm hysteresis
+    const uint8_t* error;            ///< Error bits
+    uint16_t count;                  ///< Number of points
+};
+
+/**
+ * @struct ThresholdMasks
+ * @brief Kernel outputs, thresholdMaskWords(count) words each
+ * @details low and high are read as the hysteresis latch before being
+ *          rewritten. Bits past count are written as zero.
+ */
+struct ThresholdMasks {
+    uint32_t* low;     ///< Points at or below the low threshold
+    uint32_t* high;    ///< Points at or above the high threshold
+    uint32_t* error;   ///< Points with error bits
+};
+
+/**
+ * @brief Portable branch-free kernel
+ * @param[in] in Input arrays
+ * @param[in,out] masks Previous masks in, new masks out
+ */
+void evaluateThresholdsPortable(const ThresholdArrays& in, ThresholdMasks& masks);
+
+#if THRESHOLD_KERNEL_SSE2
+/**
+ * @brief SSE2 kernel, eight points per step
+ * @param[in] in Input arrays
+ * @param[in,out] masks Previous masks in, new masks out
+ */
+void evaluateThresholdsSse2(const ThresholdArrays& in, ThresholdMasks& masks);
+#endif
+
+/**
+ * @brief Evaluate all points with the best kernel for the target
+ * @param[in] in Input arrays
+ * @param[in,out] masks Previous masks in, new masks out
+ */
+inline void evaluateThresholds(const ThresholdArrays& in, ThresholdMasks& masks) {
+#if THRESHOLD_KERNEL_SSE2
+    evaluateThresholdsSse2(in, masks);
+#else
+    evaluateThresholdsPortable(in, masks);
+#endif
+}
+
+/**
+ * @brief Read the THRESHOLD_BIT_* bits of one point from the masks
+ * @param[in] masks Kernel output
+ * @param[in] i Point index
+ * @return uint8_t THRESHOLD_BIT_* bits
+ */
+inline uint8_t thresholdMaskBits(const ThresholdMasks& masks, uint16_t i) {
+    const uint16_t w = i >> 5;
+    const uint8_t b = i & 31;
+    return (uint8_t)(((masks.low[w] >> b) & 1u) | (((masks.high[w] >> b) & 1u) << 1));
+}
+
+#endif // THRESHOLD_KERNEL_H
@@ -0,0 +1,107 @@
+/**
+ * @file Trace.h
+ * @brief Compile-time gated serial tracing with runtime module masks
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Replaces unconditional Serial.printf in hot paths. A trace point
+ *          has a level and a module:
+ *
+ *              TRACE_D(TRACE_ALARM_CHECK, "Point %d: %d\n", addr, temp);
+ *
+ *          Levels follow LOGGER_LOG_LEVEL from platformio.ini (the scale
+ *          ConfigAssist uses: 1 error, 2 warning, 3 info, 4 debug, 5 verbose).
+ *          Trace points above that level expand to an empty statement, so
+ *          their arguments are never evaluated and no code is emitted.
+ *          Enabled trace points test the runtime module mask first and only
+ *          then format their arguments.
+ *
+ *          Wrap trace-only loops in TRACE_ENABLED() so they compile out too.
+ *
+ * @section dependencies Dependencies
+ * - Arduino.h for Serial (TRACE_PRINTF can be redefined before inclusion)
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+
+#ifndef LOGGER_LOG_LEVEL
+#define LOGGER_LOG_LEVEL 3
+#endif
+
+#ifndef TRACE_PRINTF
+#define TRACE_PRINTF Serial.printf
+#endif
+
+#define TRACE_LEVEL_ERROR 1     ///< Failures
+#define TRACE_LEVEL_WARNING 2   ///< Recoverable problems
+#define TRACE_LEVEL_INFO 3      ///< State changes
+#define TRACE_LEVEL_DEBUG 4     ///< Per-cycle detail
+#define TRACE_LEVEL_VERBOSE 5   ///< Everything
+
+/**
+ * @brief Trace modules, one bit each in the runtime mask
+ */
+enum TraceModule : uint32_t {
+    TRACE_ALARM = 1u << 0,          ///< Alarm stage transitions
+    TRACE_ALARM_CHECK = 1u << 1,    ///< Per-alarm condition evaluation
+    TRACE_ALARM_PASS = 1u << 2,     ///< Alarm engine passes: changed points, alarm list
+    TRACE_ALL_MODULES = 0xFFFFFFFFu ///< Every module
+};
+
+extern volatile uint32_t traceModuleMask;   ///< Enabled TraceModule bits
+
+/**
+ * @brief Enable or disable a trace module at runtime
+ * @param[in] module TraceModule bit(s)
+ * @param[in] enabled New state
+ */
+inline void setTraceModule(uint32_t module, bool enabled) {
+    if (enabled) traceModuleMask |= module;
+    else traceModuleMask &= ~module;
+}
+
+/**
+ * @brief True if trace points of this level and module produce output
+ * @details Constant false above LOGGER_LOG_LEVEL, so guarded code compiles out.
+ */
+#define TRACE_ENABLED(level, module) \
+    (LOGGER_LOG_LEVEL >= (level) && (traceModuleMask & (module)) != 0)
+
+#define TRACE_EMIT(module, ...) \
+    do { if (traceModuleMask & (module)) TRACE_PRINTF(__VA_ARGS__); } while (0)
+
+#define TRACE_NONE() do { } while (0)
+
+#if LOGGER_LOG_LEVEL >= TRACE_LEVEL_ERROR
+#define TRACE_E(module, ...) TRACE_EMIT(module, __VA_ARGS__)
+#else
+#define TRACE_E(module, ...) TRACE_NONE()
+#endif
+
+#if LOGGER_LOG_LEVEL >= TRACE_LEVEL_WARNING
+#define TRACE_W(module, ...) TRACE_EMIT(module, __VA_ARGS__)
+#else
+#define TRACE_W(module, ...) TRACE_NONE()
+#endif
+
+#if LOGGER_LOG_LEVEL >= TRACE_LEVEL_INFO
+#define TRACE_I(module, ...) TRACE_EMIT(module, __VA_ARGS__)
+#else
+#define TRACE_I(module, ...) TRACE_NONE()
+#endif
+
+#if LOGGER_LOG_LEVEL >= TRACE_LEVEL_DEBUG
+#define TRACE_D(module, ...) TRACE_EMIT(module, __VA_ARGS__)
+#else
+#define TRACE_D(module, ...) TRACE_NONE()
+#endif
+
+#if LOGGER_LOG_LEVEL >= TRACE_LEVEL_VERBOSE
+#define TRACE_V(module, ...) TRACE_EMIT(module, __VA_ARGS__)
+#else
+#define TRACE_V(module, ...) TRACE_NONE()
+#endif
+
+#endif // TRACE_H
@@ -9,6 +9,9 @@
  * @section dependencies Dependencies
  * - Alarm.h for class definitions
  * - LoggerManager.h for event logging
+ * - Trace.h for the serial trace points
+ * - AlarmCounters.h for the priority/stage counters
+ * - AlarmQueues.h for the active/acknowledged queues
  * 
  * @section hardware Hardware Requirements
  * - Temperature sensors for alarm condition monitoring
@@ -16,6 +19,9 @@
 
 #include "Alarm.h"
 #include "LoggerManager.h" 
+#include "Trace.h"
+#include "AlarmCounters.h"
+#include "AlarmQueues.h"
 
 // Alarm::Alarm(AlarmType type, MeasurementPoint* source, AlarmPriority priority)
 //     : _type(type), _stage(AlarmStage::NEW), _priority(priority), _source(source),
@@ -48,13 +54,20 @@ Alarm::Alarm(AlarmType type, MeasurementPoint* source, AlarmPriority priority)
       _timestamp(millis()), _acknowledgedTime(0), _clearedTime(0),
       _acknowledgedDelay(10 * 60 * 1000), // Default 10 minutes acknowledged delay
       _delayTime(5 * 60 * 1000),          // Default 5 minutes auto-resolve delay
-      _enabled(true), _hysteresis(1)      // Default 1 degree hysteresis
+      _enabled(true), _hysteresis(1),     // Default 1 degree hysteresis
+      _counters(nullptr), _queues(nullptr), _events(nullptr), _queuePrev(nullptr),
+      _queueNext(nullptr), _queueList(ALARM_QUEUE_NONE)
 {
     // Generate unique configuration key for this alarm
     if (_source) {
         _configKey = "alarm_" + String(_source->getAddress()) + "_" + String(static_cast<int>(_type));
     }
 
+    // The threshold kernel applies the band of this alarm; the alarm engine
+    // picks the new alarm up with the next change of its point
+    _applyHysteresis();
+    if (_source) _source->markChanged();
+
     // Generate initial display message
     _updateMessage();
     
@@ -86,6 +99,8 @@ Alarm::Alarm(AlarmType type, MeasurementPoint* source, AlarmPriority priority)
  * @details Logs alarm destruction event and outputs debug information
  */
 Alarm::~Alarm() {
+    attachIndexes(nullptr, nullptr);
+
     // Log alarm destruction event
     String source_ = "ALARM_" + String(_source ? _source->getAddress() : -1);
     String description = "Alarm destroyed: " + getTypeString() + 
@@ -102,32 +117,14 @@ Alarm::~Alarm() {
 /**
  * @brief Acknowledge the alarm
  * @details Transitions alarm from NEW or ACTIVE stage to ACKNOWLEDGED stage.
- *          Records acknowledgment timestamp and logs the event.
+ *          Records acknowledgment timestamp; the transition goes to the event ring.
  */
 void Alarm::acknowledge() {
     if (_stage == AlarmStage::NEW || _stage == AlarmStage::ACTIVE) {
-        String oldStage = getStageString();
-        _stage = AlarmStage::ACKNOWLEDGED;
+        _setStage(AlarmStage::ACKNOWLEDGED);
         _acknowledgedTime = millis();
         _updateMessage();
-        
-        // Log acknowledgment event
-        String source_ = "ALARM_" + String(_source ? _source->getAddress() : -1);
-        String description = "Alarm acknowledged: " + getTypeString() + 
-                            " for point " + String(_source ? _source->getAddress() : -1) + 
-                            " (" + (_source ? _source->getName() : "Unknown") + ")";
-        LoggerManager::info(source_, description);
-        
-        // LOG: Alarm state change
-        if (_source) {
-            int16_t currentTemp = _source->getCurrentTemp();
-            int16_t threshold = (_type == AlarmType::HIGH_TEMPERATURE) ? 
-                               _source->getHighAlarmThreshold() : _source->getLowAlarmThreshold();
-            
-            LoggerManager::logAlarmStateChange(_source->getAddress(), _source->getName(),
-                                             getTypeString(), _getPriorityString(),
-                                             oldStage, "ACKNOWLEDGED", currentTemp, threshold);
-        }
+        if (_source) _source->markChanged(); // arm the acknowledgment timer
         
         Serial.printf("Alarm acknowledged: %s for point %d\n", 
                       getTypeString().c_str(), 
@@ -139,53 +136,30 @@ void Alarm::acknowledge() {
 
 void Alarm::clear() {
     if (_stage == AlarmStage::ACTIVE || _stage == AlarmStage::ACKNOWLEDGED) {
-        _stage = AlarmStage::CLEARED;
+        _setStage(AlarmStage::CLEARED);
         _clearedTime = millis();
         _updateMessage();
         
-        // LOG: Alarm cleared
-        String source_ = "ALARM_" + String(_source ? _source->getAddress() : -1);
-        String description = "Alarm cleared: " + getTypeString() + 
-                            " for point " + String(_source ? _source->getAddress() : -1) + 
-                            " (" + (_source ? _source->getName() : "Unknown") + ")";
-        LoggerManager::info(source_, description);
-        
-        Serial.printf("Alarm cleared: %s for point %d\n", 
-                      getTypeString().c_str(), 
-                      _source ? _source->getAddress() : -1);
+        TRACE_I(TRACE_ALARM, "Alarm cleared: %s for point %d\n",
+                getTypeName(), _source ? _source->getAddress() : -1);
     }
 }
 
 void Alarm::resolve() {
-    _stage = AlarmStage::RESOLVED;
+    _setStage(AlarmStage::RESOLVED);
     _updateMessage();
     
-    // LOG: Alarm resolved
-    String source_ = "ALARM_" + String(_source ? _source->getAddress() : -1);
-    String description = "Alarm resolved: " + getTypeString() + 
-                        " for point " + String(_source ? _source->getAddress() : -1) + 
-                        " (" + (_source ? _source->getName() : "Unknown") + ")";
-    LoggerManager::info(source_, description);
-    
-    Serial.printf("Alarm resolved: %s for point %d\n", 
-                  getTypeString().c_str(), 
-                  _source ? _source->getAddress() : -1);
+    TRACE_I(TRACE_ALARM, "Alarm resolved: %s for point %d\n",
+            getTypeName(), _source ? _source->getAddress() : -1);
 }
 
 
 void Alarm::reactivate() {
     if (_stage == AlarmStage::CLEARED) {
-        _stage = _acknowledgedTime > 0 ? AlarmStage::ACKNOWLEDGED : AlarmStage::ACTIVE;
+        _setStage(_acknowledgedTime > 0 ? AlarmStage::ACKNOWLEDGED : AlarmStage::ACTIVE);
         _clearedTime = 0;
         _updateMessage();
         
-        // LOG: Alarm reactivated
-        String source_ = "ALARM_" + String(_source ? _source->getAddress() : -1);
-        String description = "Alarm reactivated: " + getTypeString() + 
-                            " for point " + String(_source ? _source->getAddress() : -1) + 
-                            " (" + (_source ? _source->getName() : "Unknown") + ")";
-        LoggerManager::warning(source_, description);
-        
         Serial.printf("Alarm reactivated: %s for point %d\n", 
                       getTypeString().c_str(), 
                       _source ? _source->getAddress() : -1);
@@ -194,62 +168,45 @@ void Alarm::reactivate() {
 
 bool Alarm::_checkCondition() {
     if (!_source) {
-        Serial.println("Alarm: No source point");
+        TRACE_E(TRACE_ALARM_CHECK, "Alarm: No source point\n");
         return false;
     }
     
-    int16_t currentTemp = _source->getCurrentTemp();
     bool condition = false;
     
     switch (_type) {
+        // Threshold and hysteresis are evaluated for all points at once by the
+        // threshold kernel; the alarm reads its bit
         case AlarmType::HIGH_TEMPERATURE:
-            {
-                int16_t threshold = _source->getHighAlarmThreshold();
-                if (_stage == AlarmStage::CLEARED || _stage == AlarmStage::ACKNOWLEDGED || _stage == AlarmStage::ACTIVE) {
-                    // When cleared, need temperature to go below threshold - hysteresis
-                    condition = currentTemp >= (threshold - _hysteresis);
-                } else {
-                    // Normal check
-                    condition = currentTemp >= threshold;
-                }
-                Serial.printf("HIGH_TEMP check: Point %d, Temp=%d, Threshold=%d, Hysteresis=%d, Stage=%s, Condition=%s\n",
-                             _source->getAddress(), currentTemp, threshold, _hysteresis,
-                             getStageString().c_str(), condition ? "TRUE" : "FALSE");
-            }
+            condition = (_source->getAlarmStatus() & POINT_ALARM_HIGH) != 0;
+            TRACE_D(TRACE_ALARM_CHECK, "HIGH_TEMP check: Point %d, Temp=%d, Threshold=%d, Hysteresis=%d, Stage=%s, Condition=%s\n",
+                    _source->getAddress(), _source->getCurrentTemp(), _source->getHighAlarmThreshold(),
+                    _hysteresis, getStageName(), condition ? "TRUE" : "FALSE");
             break;
             
         case AlarmType::LOW_TEMPERATURE:
-            {
-                int16_t threshold = _source->getLowAlarmThreshold();
-                if (_stage == AlarmStage::CLEARED || _stage == AlarmStage::ACKNOWLEDGED || _stage == AlarmStage::ACTIVE) {
-                    // When cleared, need temperature to go above threshold + hysteresis
-                    condition = currentTemp <= (threshold + _hysteresis);
-                } else {
-                    // Normal check
-                    condition = currentTemp <= threshold;
-                }
-                Serial.printf("LOW_TEMP check: Point %d, Temp=%d, Threshold=%d, Hysteresis=%d, Stage=%s, Condition=%s\n",
-                             _source->getAddress(), currentTemp, threshold, _hysteresis,
-                             getStageString().c_str(), condition ? "TRUE" : "FALSE");
-            }
+            condition = (_source->getAlarmStatus() & POINT_ALARM_LOW) != 0;
+            TRACE_D(TRACE_ALARM_CHECK, "LOW_TEMP check: Point %d, Temp=%d, Threshold=%d, Hysteresis=%d, Stage=%s, Condition=%s\n",
+                    _source->getAddress(), _source->getCurrentTemp(), _source->getLowAlarmThreshold(),
+                    _hysteresis, getStageName(), condition ? "TRUE" : "FALSE");
             break;
             
         case AlarmType::SENSOR_ERROR:
             condition = _source->getErrorStatus() != 0;
-            Serial.printf("SENSOR_ERROR check: Point %d, Error=%d, Condition=%s\n",
-                         _source->getAddress(), _source->getErrorStatus(), 
-                         condition ? "TRUE" : "FALSE");
+            TRACE_D(TRACE_ALARM_CHECK, "SENSOR_ERROR check: Point %d, Error=%d, Condition=%s\n",
+                    _source->getAddress(), _source->getErrorStatus(),
+                    condition ? "TRUE" : "FALSE");
             break;
             
         case AlarmType::SENSOR_DISCONNECTED:
             condition = _source->getBoundSensor() == nullptr;
-            Serial.printf("DISCONNECTED check: Point %d, Sensor=%p, Condition=%s\n",
-                         _source->getAddress(), _source->getBoundSensor(), 
-                         condition ? "TRUE" : "FALSE");
+            TRACE_D(TRACE_ALARM_CHECK, "DISCONNECTED check: Point %d, Sensor=%p, Condition=%s\n",
+                    _source->getAddress(), _source->getBoundSensor(),
+                    condition ? "TRUE" : "FALSE");
             break;
             
         default:
-            Serial.println("Unknown alarm type");
+            TRACE_E(TRACE_ALARM_CHECK, "Unknown alarm type\n");
             return false;
     }
     
@@ -373,8 +330,16 @@ void Alarm::_updateMessage() {
     _message = getDisplayText();
 }
 
-String Alarm::getTypeString() const {
-    switch (_type) {
+const char* Alarm::getTypeName() const {
+    return typeName(_type);
+}
+
+const char* Alarm::getStageName() const {
+    return stageName(_stage);
+}
+
+const char* Alarm::typeName(AlarmType type) {
+    switch (type) {
         case AlarmType::HIGH_TEMPERATURE: return "HIGH_TEMP";
         case AlarmType::LOW_TEMPERATURE: return "LOW_TEMP";
         case AlarmType::SENSOR_ERROR: return "SENSOR_ERROR";
@@ -383,8 +348,8 @@ String Alarm::getTypeString() const {
     }
 }
 
-String Alarm::getStageString() const {
-    switch (_stage) {
+const char* Alarm::stageName(AlarmStage stage) {
+    switch (stage) {
         case AlarmStage::NEW: return "NEW";
         case AlarmStage::ACTIVE: return "ACTIVE";
         case AlarmStage::ACKNOWLEDGED: return "ACKNOWLEDGED";
@@ -394,8 +359,16 @@ String Alarm::getStageString() const {
     }
 }
 
-String Alarm::_getPriorityString() const {
-    switch (_priority) {
+String Alarm::getTypeString() const {
+    return String(getTypeName());
+}
+
+String Alarm::getStageString() const {
+    return String(getStageName());
+}
+
+const char* Alarm::priorityName(AlarmPriority priority) {
+    switch (priority) {
         case AlarmPriority::PRIORITY_LOW: return "LOW";
         case AlarmPriority::PRIORITY_MEDIUM: return "MEDIUM";
         case AlarmPriority::PRIORITY_HIGH: return "HIGH";
@@ -404,6 +377,10 @@ String Alarm::_getPriorityString() const {
     }
 }
 
+String Alarm::_getPriorityString() const {
+    return String(priorityName(_priority));
+}
+
 bool Alarm::operator<(const Alarm& other) const {
     // Sort by priority first (higher priority first), then by timestamp (older first)
     if (_priority != other._priority) {
@@ -431,7 +408,10 @@ void Alarm::setConfigKey(const String& key) {
 void Alarm::setPriority(AlarmPriority priority) {
     if (_priority != priority) {
         AlarmPriority oldPriority = _priority;
+        _leaveIndexes();
         _priority = priority;
+        _enterIndexes();
+        if (_source) _source->markChanged(); // re-evaluate on the next alarm pass
         
         // LOG: Priority change
         String source_ = "CONFIG_" + String(_source ? _source->getAddress() : -1);
@@ -446,6 +426,7 @@ void Alarm::setHysteresis(int16_t hysteresis) {
     if (_hysteresis != hysteresis) {
         int16_t oldHysteresis = _hysteresis;
         _hysteresis = hysteresis;
+        _applyHysteresis();
         
         // LOG: Hysteresis change
         String source_ = "CONFIG_" + String(_source ? _source->getAddress() : -1);
@@ -456,9 +437,18 @@ void Alarm::setHysteresis(int16_t hysteresis) {
     }
 }
 
+void Alarm::_applyHysteresis() {
+    if (!_source) return;
+    if (_type == AlarmType::HIGH_TEMPERATURE) _source->setHighAlarmHysteresis(_hysteresis);
+    else if (_type == AlarmType::LOW_TEMPERATURE) _source->setLowAlarmHysteresis(_hysteresis);
+}
+
 void Alarm::setEnabled(bool enabled) {
     if (_enabled != enabled) {
+        _leaveIndexes();
         _enabled = enabled;
+        _enterIndexes();
+        if (_source) _source->markChanged();
         
         // LOG: Enable/disable change
         String source_ = "CONFIG_" + String(_source ? _source->getAddress() : -1);
@@ -470,68 +460,81 @@ void Alarm::setEnabled(bool enabled) {
 
 
 void Alarm::setStage(AlarmStage stage){
-    _stage = stage;
+    _setStage(stage);
+    if (_source) _source->markChanged();
 };
 
+void Alarm::_setStage(AlarmStage stage) {
+    if (stage == _stage) return;
+    const AlarmStage fromStage = _stage;
+    _leaveIndexes();
+    _stage = stage;
+    _enterIndexes();
+    _emitTransition(fromStage);
+}
+
+void Alarm::_emitTransition(AlarmStage fromStage) {
+    if (!_events) return;
+    AlarmEvent event;
+    event.timeMs = millis();
+    event.pointAddress = getPointAddress();
+    event.type = _type;
+    event.priority = _priority;
+    event.fromStage = fromStage;
+    event.toStage = _stage;
+    event.temperature = _source ? _source->getCurrentTemp() : 0;
+    event.threshold = 0;
+    if (_source && _type == AlarmType::HIGH_TEMPERATURE) event.threshold = _source->getHighAlarmThreshold();
+    else if (_source && _type == AlarmType::LOW_TEMPERATURE) event.threshold = _source->getLowAlarmThreshold();
+    _events->push(event);   // a full ring counts the drop, evaluation never waits
+}
+
+void Alarm::attachIndexes(AlarmCounters* counters, AlarmQueues* queues) {
+    if (counters == _counters && queues == _queues) return;
+    _leaveIndexes();
+    _counters = counters;
+    _queues = queues;
+    _enterIndexes();
+}
+
+void Alarm::_leaveIndexes() {
+    if (!_enabled) return;
+    if (_counters) _counters->remove(static_cast<uint8_t>(_priority), static_cast<uint8_t>(_stage));
+    if (_queues) _queues->remove(this);
+}
+
+void Alarm::_enterIndexes() {
+    if (!_enabled) return;
+    if (_counters) _counters->add(static_cast<uint8_t>(_priority), static_cast<uint8_t>(_stage));
+    if (_queues) _queues->insert(this);
+}
+
 // Modify the updateCondition method to handle acknowledged timeout
 bool Alarm::updateCondition() {
     if (!_source) {
-        Serial.println("Alarm updateCondition: No source");
+        TRACE_E(TRACE_ALARM, "Alarm updateCondition: No source\n");
         return true;
     }
     
     
     AlarmStage oldStage = _stage;
     
-    
-    
-    String source_ = "ALARM_" + String(_source->getAddress());
-    String baseDescription = getTypeString() + " alarm for point " + 
-                            String(_source->getAddress()) + " (" + _source->getName() + ")";
-    
-    // Get current temperature and threshold for logging
-    int16_t currentTemp = _source->getCurrentTemp();
+    // Transitions are logged by the consumer of the event ring
     bool conditionExists = _checkCondition();
-    Serial.printf("Alarm update: Point %d, Type=%s, Stage=%s, Condition=%s\n",
-                  _source->getAddress(), getTypeString().c_str(), 
-                  getStageString().c_str(), conditionExists ? "EXISTS" : "CLEARED");
-    int16_t threshold = 0;
-    
-    switch (_type) {
-        case AlarmType::HIGH_TEMPERATURE:
-            threshold = _source->getHighAlarmThreshold();
-            break;
-        case AlarmType::LOW_TEMPERATURE:
-            threshold = _source->getLowAlarmThreshold();
-            break;
-        case AlarmType::SENSOR_ERROR:
-        case AlarmType::SENSOR_DISCONNECTED:
-            threshold = 0; // Not applicable for these alarm types
-            break;
-    }
+    TRACE_D(TRACE_ALARM_CHECK, "Alarm update: Point %d, Type=%s, Stage=%s, Condition=%s\n",
+            _source->getAddress(), getTypeName(),
+            getStageName(), conditionExists ? "EXISTS" : "CLEARED");
     
     switch (_stage) {
         case AlarmStage::NEW:
             if (conditionExists) {
-                _stage = AlarmStage::ACTIVE;
+                _setStage(AlarmStage::ACTIVE);
                 
-                // LOG: NEW -> ACTIVE
-                LoggerManager::error(source_, baseDescription + " activated");
-                LoggerManager::logAlarmStateChange(_source->getAddress(), _source->getName(),
-                                                 getTypeString(), _getPriorityString(),
-                                                 "NEW", "ACTIVE", currentTemp, threshold);
-                
-                Serial.printf("Alarm %s: NEW -> ACTIVE\n", getTypeString().c_str());
+                TRACE_I(TRACE_ALARM, "Alarm %s: NEW -> ACTIVE\n", getTypeName());
             } else {
                 resolve();
                 
-                // LOG: NEW -> RESOLVED
-                LoggerManager::info(source_, baseDescription + " resolved before activation");
-                LoggerManager::logAlarmStateChange(_source->getAddress(), _source->getName(),
-                                                 getTypeString(), _getPriorityString(),
-                                                 "NEW", "RESOLVED", currentTemp, threshold);
-                
-                Serial.printf("Alarm %s: NEW -> RESOLVED (condition cleared)\n", getTypeString().c_str());
+                TRACE_I(TRACE_ALARM, "Alarm %s: NEW -> RESOLVED (condition cleared)\n", getTypeName());
             }
             break;
             
@@ -539,13 +542,7 @@ bool Alarm::updateCondition() {
             if (!conditionExists) {
                 clear();
                 
-                // LOG: ACTIVE -> CLEARED
-                LoggerManager::info(source_, baseDescription + " condition cleared");
-                LoggerManager::logAlarmStateChange(_source->getAddress(), _source->getName(),
-                                                 getTypeString(), _getPriorityString(),
-                                                 "ACTIVE", "CLEARED", currentTemp, threshold);
-                
-                Serial.printf("Alarm %s: ACTIVE -> CLEARED (condition no longer exists)\n", getTypeString().c_str());
+                TRACE_I(TRACE_ALARM, "Alarm %s: ACTIVE -> CLEARED (condition no longer exists)\n", getTypeName());
             }
             break;
             
@@ -553,65 +550,35 @@ bool Alarm::updateCondition() {
             if (!conditionExists) {
                 clear();
                 
-                // LOG: ACKNOWLEDGED -> CLEARED
-                LoggerManager::info(source_, baseDescription + " condition cleared while acknowledged");
-                LoggerManager::logAlarmStateChange(_source->getAddress(), _source->getName(),
-                                                 getTypeString(), _getPriorityString(),
-                                                 "ACKNOWLEDGED", "CLEARED", currentTemp, threshold);
-                
-                Serial.printf("Alarm %s: ACKNOWLEDGED -> CLEARED (condition no longer exists)\n", getTypeString().c_str());
+                TRACE_I(TRACE_ALARM, "Alarm %s: ACKNOWLEDGED -> CLEARED (condition no longer exists)\n", getTypeName());
             } else if (isAcknowledgedDelayElapsed()) {
-                _stage = AlarmStage::ACTIVE;
-                
-                // LOG: ACKNOWLEDGED -> ACTIVE (timeout)
-                LoggerManager::warning(source_, baseDescription + " acknowledgment timeout - returned to active");
-                LoggerManager::logAlarmStateChange(_source->getAddress(), _source->getName(),
-                                                 getTypeString(), _getPriorityString(),
-                                                 "ACKNOWLEDGED", "ACTIVE", currentTemp, threshold);
+                _setStage(AlarmStage::ACTIVE);
                 
-                Serial.printf("Alarm %s: ACKNOWLEDGED -> ACTIVE (acknowledged delay elapsed)\n", getTypeString().c_str());
+                TRACE_I(TRACE_ALARM, "Alarm %s: ACKNOWLEDGED -> ACTIVE (acknowledged delay elapsed)\n", getTypeName());
             }
             break;
             
         case AlarmStage::CLEARED:
             if (conditionExists) {
-                _stage = AlarmStage::ACTIVE;
+                _setStage(AlarmStage::ACTIVE);
                 _clearedTime = 0;
                 
-                // LOG: CLEARED -> ACTIVE (condition returned)
-                LoggerManager::warning(source_, baseDescription + " condition returned");
-                LoggerManager::logAlarmStateChange(_source->getAddress(), _source->getName(),
-                                                 getTypeString(), _getPriorityString(),
-                                                 "CLEARED", "ACTIVE", currentTemp, threshold);
-                
-                Serial.printf("Alarm %s: CLEARED -> ACTIVE (condition returned)\n", getTypeString().c_str());
+                TRACE_I(TRACE_ALARM, "Alarm %s: CLEARED -> ACTIVE (condition returned)\n", getTypeName());
             } else {//if (isDelayElapsed()) {
                 resolve();
                 
-                // LOG: CLEARED -> RESOLVED (delay elapsed)
-                LoggerManager::info(source_, baseDescription + " auto-resolved after delay");
-                LoggerManager::logAlarmStateChange(_source->getAddress(), _source->getName(),
-                                                 getTypeString(), _getPriorityString(),
-                                                 "CLEARED", "RESOLVED", currentTemp, threshold);
-                
-                Serial.printf("Alarm %s: CLEARED -> RESOLVED (delay elapsed)\n", getTypeString().c_str());
+                TRACE_I(TRACE_ALARM, "Alarm %s: CLEARED -> RESOLVED (delay elapsed)\n", getTypeName());
             }
             break;
         
         case AlarmStage::RESOLVED:
             if (conditionExists) {
-                _stage = AlarmStage::ACTIVE;
-                _timestamp = millis();
+                _timestamp = millis();    // before the stage: queues order by it
                 _acknowledgedTime = 0;
+                _setStage(AlarmStage::ACTIVE);
                 _clearedTime = 0;
                 
-                // LOG: RESOLVED -> ACTIVE (condition returned)
-                LoggerManager::error(source_, baseDescription + " reoccurred after resolution");
-                LoggerManager::logAlarmStateChange(_source->getAddress(), _source->getName(),
-                                                 getTypeString(), _getPriorityString(),
-                                                 "RESOLVED", "ACTIVE", currentTemp, threshold);
-                
-                Serial.printf("Alarm %s: RESOLVED -> ACTIVE (condition returned)\n", getTypeString().c_str());
+                TRACE_I(TRACE_ALARM, "Alarm %s: RESOLVED -> ACTIVE (condition returned)\n", getTypeName());
             }
             break;
     }
@@ -626,7 +593,26 @@ bool Alarm::updateCondition() {
 
 // Add these new methods to Alarm.cpp
 void Alarm::setAcknowledgedDelay(unsigned long delay) {
+    if (_acknowledgedDelay == delay) return;
     _acknowledgedDelay = delay;
+    if (_source) _source->markChanged(); // re-arm a running acknowledgment timer
+}
+
+bool Alarm::getPendingDeadline(unsigned long& dueAt) const {
+    switch (_stage) {
+        case AlarmStage::NEW:
+            dueAt = _timestamp;          // settles on the next update
+            return true;
+        case AlarmStage::CLEARED:
+            dueAt = _clearedTime;        // settles on the next update
+            return true;
+        case AlarmStage::ACKNOWLEDGED:
+            if (_acknowledgedTime == 0) return false;
+            dueAt = _acknowledgedTime + _acknowledgedDelay;
+            return true;
+        default:
+            return false;
+    }
 }
 
 unsigned long Alarm::getAcknowledgedDelay() const {
@@ -655,11 +641,5 @@ unsigned long Alarm::getAcknowledgedTimeLeft() const {
 
 
 String Alarm::_getPriorityString(AlarmPriority priority) const {
-    switch (priority) {
-        case AlarmPriority::PRIORITY_LOW: return "LOW";
-        case AlarmPriority::PRIORITY_MEDIUM: return "MEDIUM";
-        case AlarmPriority::PRIORITY_HIGH: return "HIGH";
-        case AlarmPriority::PRIORITY_CRITICAL: return "CRITICAL";
-        default: return "UNKNOWN";
-    }
+    return String(priorityName(priority));
 }
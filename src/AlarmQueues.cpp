@@ -0,0 +1,88 @@
+/**
+ * @file AlarmQueues.cpp
+ * @brief Implementation of the active/acknowledged alarm lists
+ * @author barabashsr
+ * @date 2026-10-16
+ *
+ * @section dependencies Dependencies
+ * - AlarmQueues.h for class definition
+ * - Alarm.h for the intrusive links
+ */
+
+#include "AlarmQueues.h"
+#include "Alarm.h"
+
+AlarmQueues::AlarmQueues() {
+    for (uint8_t q = 0; q < ALARM_QUEUE_COUNT; ++q) {
+        for (uint8_t p = 0; p < ALARM_PRIORITY_COUNT; ++p) {
+            _head[q][p] = nullptr;
+            _tail[q][p] = nullptr;
+        }
+        _sizes[q] = 0;
+    }
+}
+
+void AlarmQueues::insert(Alarm* alarm) {
+    if (alarm->_queueList != ALARM_QUEUE_NONE) return;
+
+    uint8_t q;
+    if (alarm->_stage == AlarmStage::ACTIVE) q = ALARM_QUEUE_ACTIVE;
+    else if (alarm->_stage == AlarmStage::ACKNOWLEDGED) q = ALARM_QUEUE_ACKNOWLEDGED;
+    else return;
+    const uint8_t p = static_cast<uint8_t>(alarm->_priority);
+    if (p >= ALARM_PRIORITY_COUNT) return;
+
+    // Walk back past newer alarms; a freshly raised alarm stops at the tail
+    Alarm* after = _tail[q][p];
+    while (after && (long)(after->_timestamp - alarm->_timestamp) > 0) after = after->_queuePrev;
+
+    alarm->_queuePrev = after;
+    alarm->_queueNext = after ? after->_queueNext : _head[q][p];
+    if (alarm->_queueNext) alarm->_queueNext->_queuePrev = alarm;
+    else _tail[q][p] = alarm;
+    if (after) after->_queueNext = alarm;
+    else _head[q][p] = alarm;
+
+    alarm->_queueList = (uint8_t)(q * ALARM_PRIORITY_COUNT + p);
+    _sizes[q]++;
+}
+
+void AlarmQueues::remove(Alarm* alarm) {
+    if (alarm->_queueList == ALARM_QUEUE_NONE) return;
+    const uint8_t q = alarm->_queueList / ALARM_PRIORITY_COUNT;
+    const uint8_t p = alarm->_queueList % ALARM_PRIORITY_COUNT;
+
+    if (alarm->_queuePrev) alarm->_queuePrev->_queueNext = alarm->_queueNext;
+    else _head[q][p] = alarm->_queueNext;
+    if (alarm->_queueNext) alarm->_queueNext->_queuePrev = alarm->_queuePrev;
+    else _tail[q][p] = alarm->_queuePrev;
+
+    alarm->_queuePrev = nullptr;
+    alarm->_queueNext = nullptr;
+    alarm->_queueList = ALARM_QUEUE_NONE;
+    _sizes[q]--;
+}
+
+Alarm* AlarmQueues::first(AlarmQueueId queue) const {
+    for (int p = ALARM_PRIORITY_COUNT - 1; p >= 0; --p) {
+        if (_head[queue][p]) return _head[queue][p];
+    }
+    return nullptr;
+}
+
+Alarm* AlarmQueues::next(const Alarm* alarm) const {
+    if (alarm->_queueList == ALARM_QUEUE_NONE) return nullptr;
+    if (alarm->_queueNext) return alarm->_queueNext;
+    const uint8_t q = alarm->_queueList / ALARM_PRIORITY_COUNT;
+    for (int p = (int)(alarm->_queueList % ALARM_PRIORITY_COUNT) - 1; p >= 0; --p) {
+        if (_head[q][p]) return _head[q][p];
+    }
+    return nullptr;
+}
+
+Alarm* AlarmQueues::at(AlarmQueueId queue, uint16_t index) const {
+    if (index >= _sizes[queue]) return nullptr;
+    Alarm* alarm = first(queue);
+    while (alarm && index-- > 0) alarm = next(alarm);
+    return alarm;
+}
@@ -35,16 +35,16 @@ String CSVConfigManager::exportPointsWithAlarmsToCSV() {
     csv += "-1,SAMPLE_POINT,SAMPLE,0,0,0,0,0,,";
     csv += ",CRITICAL,HIGH,MEDIUM,LOW\n";
     
-    // Export DS18B20 points (0-49)
-    for (int i = 0; i < 50; i++) {
+    // Export DS18B20 points
+    for (int i = 0; i < _controller.getDS18B20PointCount(); i++) {
         MeasurementPoint* point = _controller.getDS18B20Point(i);
         if (point) {
             _exportPointToCSV(csv, point, "DS18B20");
         }
     }
     
-    // Export PT1000 points (50-59)
-    for (int i = 0; i < 10; i++) {
+    // Export PT1000 points
+    for (int i = 0; i < _controller.getPT1000PointCount(); i++) {
         MeasurementPoint* point = _controller.getPT1000Point(i);
         if (point) {
             _exportPointToCSV(csv, point, "PT1000");
@@ -84,6 +84,68 @@ const char* VARIABLES_DEF_YAML PROGMEM = R"~(
           min: 1
           max: 3600
           default: 10
+      - ds_point_count:
+          label: DS18B20 measurement points (total with PT1000 up to 250, applied at restart)
+          type: number
+          min: 0
+          max: 250
+          default: 50
+      - pt_point_count:
+          label: PT1000 measurement points (applied at restart)
+          type: number
+          min: 0
+          max: 250
+          default: 10
+      - adaptive_sampling:
+          label: Adaptive sampling (read stable sensors less often)
+          checked: true
+      - background_discovery:
+          label: Detect hot-plugged DS18B20 sensors in the background
+          checked: true
+      - alarm_screening:
+          label: DS18B20 hardware alarm search between sweeps (writes TH/TL)
+          checked: false
+      - pt1000_continuous:
+          label: PT1000 continuous conversion (bias always on)
+          checked: false
+      - mains_frequency:
+          label: Mains frequency for PT1000 noise filter (Hz)
+          options: '50', '60'
+          default: '50'
+
+    PT1000 channels:
+      - rtd_type:
+          label: RTD element
+          options: 'PT1000', 'PT100'
+          default: 'PT1000'
+      - pt_rref_1:
+          label: Channel 1 reference resistor (ohm)
+          type: number
+          min: 100
+          max: 10000
+          step: 0.1
+          default: 4300
+      - pt_rref_2:
+          label: Channel 2 reference resistor (ohm)
+          type: number
+          min: 100
+          max: 10000
+          step: 0.1
+          default: 4300
+      - pt_rref_3:
+          label: Channel 3 reference resistor (ohm)
+          type: number
+          min: 100
+          max: 10000
+          step: 0.1
+          default: 4300
+      - pt_rref_4:
+          label: Channel 4 reference resistor (ohm)
+          type: number
+          min: 100
+          max: 10000
+          step: 0.1
+          default: 4300
     
     Alarm Acknowledged Delays:
       - ack_delay_critical:
@@ -125,6 +187,17 @@ const char* VARIABLES_DEF_YAML PROGMEM = R"~(
           label: Baud Rate
           options: '4800', '9600', '19200', '38400', '57600', '115200'
           default: '9600'
+
+    Diagnostics:
+      - trace_alarm_transitions:
+          label: Serial trace of alarm stage transitions
+          checked: true
+      - trace_alarm_checks:
+          label: Serial trace of every alarm condition check (firmware built with LOGGER_LOG_LEVEL 4)
+          checked: false
+      - trace_alarm_passes:
+          label: Serial trace of alarm engine passes (firmware built with LOGGER_LOG_LEVEL 4)
+          checked: false
     )~";
 
 ConfigManager::ConfigManager(TemperatureController& tempController)
@@ -237,6 +310,13 @@ bool ConfigManager::begin() {
     // Start the web server
     server->begin();
     
+    // Size the point registry before points are loaded and sensors bound
+    if (!controller.allocatePoints(getDS18B20PointCount(), getPT1000PointCount())) {
+        LoggerManager::error("CONFIG", "Point layout " + String(getDS18B20PointCount()) + " DS18B20 + " +
+            String(getPT1000PointCount()) + " PT1000 rejected, keeping " +
+            String(controller.getDS18B20PointCount()) + " + " + String(controller.getPT1000PointCount()));
+    }
+
     // Load sensor configuration
     //loadSensorConfig();
     loadPointsConfig();
@@ -251,12 +331,23 @@ bool ConfigManager::begin() {
     controller.setMeasurementPeriod(getMeasurementPeriod());
     LoggerManager::info("CONFIG", "Measurement period set to: " + String(getMeasurementPeriod()) + " seconds");
 
+    controller.setAdaptiveSampling(isAdaptiveSampling());
+    controller.setBackgroundDiscovery(isBackgroundDiscovery());
+    controller.setHardwareAlarmScreening(isAlarmScreening());
+    controller.setPT1000ContinuousMode(isPT1000Continuous(), getMainsFrequency() != 60);
+    controller.setRtdNominal(getRtdNominal());
+    for (uint8_t ch = 0; ch < 4; ++ch) {
+        controller.setRtdReference(ch, getRtdReference(ch));
+    }
+
     // Load acknowledged delays
     controller.setAcknowledgedDelayCritical(getAcknowledgedDelayCritical() * 60 * 1000);
     controller.setAcknowledgedDelayHigh(getAcknowledgedDelayHigh() * 60 * 1000);
     controller.setAcknowledgedDelayMedium(getAcknowledgedDelayMedium() * 60 * 1000);
     controller.setAcknowledgedDelayLow(getAcknowledgedDelayLow() * 60 * 1000);
     LoggerManager::info("CONFIG", "Acknowledged delays configured");
+
+    traceModuleMask = getTraceModules();
     
     LoggerManager::info("CONFIG", "ConfigManager initialization completed successfully");
     
@@ -295,6 +386,22 @@ void ConfigManager::onConfigChanged(String key) {
         instance->controller.setDeviceId(instance->conf(key).toInt());
     } else if (key == "measurement_period") {
         instance->controller.setMeasurementPeriod(instance->conf(key).toInt());
+    } else if (key == "ds_point_count" || key == "pt_point_count") {
+        LoggerManager::info("CONFIG", "Measurement point count changed, restart to apply");
+    } else if (key == "adaptive_sampling") {
+        instance->controller.setAdaptiveSampling(instance->isAdaptiveSampling());
+    } else if (key == "background_discovery") {
+        instance->controller.setBackgroundDiscovery(instance->isBackgroundDiscovery());
+    } else if (key == "alarm_screening") {
+        instance->controller.setHardwareAlarmScreening(instance->isAlarmScreening());
+    } else if (key == "pt1000_continuous" || key == "mains_frequency") {
+        instance->controller.setPT1000ContinuousMode(instance->isPT1000Continuous(),
+                                                     instance->getMainsFrequency() != 60);
+    } else if (key == "rtd_type") {
+        instance->controller.setRtdNominal(instance->getRtdNominal());
+    } else if (key.startsWith("pt_rref_")) {
+        uint8_t ch = key.substring(8).toInt() - 1;
+        instance->controller.setRtdReference(ch, instance->getRtdReference(ch));
     } else if (key == "reset_min_max") {
         instance->resetMinMaxValues();
     } else if (key == "ack_delay_critical") {
@@ -313,6 +420,8 @@ void ConfigManager::onConfigChanged(String key) {
         unsigned long delayMs = instance->conf(key).toInt() * 60 * 1000;
         instance->controller.setAcknowledgedDelayLow(delayMs);
         Serial.printf("Set low acknowledged delay to %lu ms (%d minutes)\n", delayMs, instance->conf(key).toInt());
+    } else if (key.startsWith("trace_")) {
+        traceModuleMask = instance->getTraceModules();
     }
 }
 
@@ -331,7 +440,7 @@ void ConfigManager::savePointsConfig() {
     ConfigAssist pointsConf("/points2.ini", false);
 
     // DS18B20 points
-    for (uint8_t i = 0; i < 50; ++i) {
+    for (uint8_t i = 0; i < controller.getDS18B20PointCount(); ++i) {
         MeasurementPoint* point = controller.getDS18B20Point(i);
         if (!point) continue;
         String key = "ds_" + String(point->getAddress());
@@ -346,6 +455,9 @@ void ConfigManager::savePointsConfig() {
             hysteresis = pointAlarms[0]->getHysteresis();
         }
         pointsConf[key + "_hysteresis"] = String(hysteresis);
+        pointsConf[key + "_resolution"] = String(point->getResolution());
+        pointsConf[key + "_min_period"] = String(point->getMinSamplePeriod());
+        pointsConf[key + "_max_period"] = String(point->getMaxSamplePeriod());
 
         // Get alarm settings from TemperatureController
         for (auto alarm : pointAlarms) {
@@ -376,7 +488,7 @@ void ConfigManager::savePointsConfig() {
     }
 
     // PT1000 points
-    for (uint8_t i = 0; i < 10; ++i) {
+    for (uint8_t i = 0; i < controller.getPT1000PointCount(); ++i) {
         MeasurementPoint* point = controller.getPT1000Point(i);
         if (!point) continue;
         String key = "pt_" + String(point->getAddress());
@@ -391,6 +503,8 @@ void ConfigManager::savePointsConfig() {
             hysteresis = pointAlarms[0]->getHysteresis();
         }
         pointsConf[key + "_hysteresis"] = String(hysteresis);
+        pointsConf[key + "_min_period"] = String(point->getMinSamplePeriod());
+        pointsConf[key + "_max_period"] = String(point->getMaxSamplePeriod());
 
         // Get alarm settings from TemperatureController
         for (auto alarm : pointAlarms) {
@@ -464,7 +578,7 @@ void ConfigManager::loadPointsConfig() {
     LoggerManager::info("CONFIG_LOAD", "Loading points configuration from /points2.ini");
 
     // DS18B20 points
-    for (uint8_t i = 0; i < 50; ++i) {
+    for (uint8_t i = 0; i < controller.getDS18B20PointCount(); ++i) {
         String key = "ds_" + String(i);
         MeasurementPoint* point = controller.getDS18B20Point(i);
         if (!point) continue;
@@ -481,6 +595,14 @@ void ConfigManager::loadPointsConfig() {
         
         // Load alarm settings - defer to after sensor binding
         // so we can auto-enable sensor error alarm if bound
+        // Resolution must be set before binding so the sensor picks it up
+        String resolutionStr = pointsConf(key + "_resolution");
+        if (!resolutionStr.isEmpty()) {
+            point->setResolution(resolutionStr.toInt());
+        }
+        point->setSamplePeriodLimits(pointsConf(key + "_min_period").toInt(),
+                                     pointsConf(key + "_max_period").toInt());
+
         uint8_t bus = pointsConf(key + "_sensor_bus").toInt();
         String rom = pointsConf(key + "_sensor_rom");
         if (rom.length() == 16) {
@@ -492,11 +614,13 @@ void ConfigManager::loadPointsConfig() {
                     romArr[j] = strtol(rom.substring(j*2, j*2+2).c_str(), nullptr, 16);
                 String sensorName = "DS18B20_" + rom;
                 sensor = new Sensor(SensorType::DS18B20, 0, sensorName);
-                sensor->setupDS18B20(controller.getOneWirePin(bus), romArr);
+                sensor->setupDS18B20(controller.getOneWireBus(bus), romArr);
                 if (!sensor->initialize()) {
                     //sensor->setErrorStatus(0x01); // Mark as error (not connected)
                 }
-                controller.addSensor(sensor);
+                if (!controller.addSensor(sensor)) {
+                    delete sensor;
+                }
             }
             
             controller.bindSensorToPointByRom(rom, i);
@@ -506,8 +630,8 @@ void ConfigManager::loadPointsConfig() {
     }
 
     // PT1000 points
-    for (uint8_t i = 0; i < 10; ++i) {
-        uint8_t address = 50 + i;
+    for (uint8_t i = 0; i < controller.getPT1000PointCount(); ++i) {
+        uint8_t address = controller.getPT1000Base() + i;
         String key = "pt_" + String(address);
         MeasurementPoint* point = controller.getPT1000Point(i);
         if (!point) continue;
@@ -522,6 +646,9 @@ void ConfigManager::loadPointsConfig() {
             hysteresis = hysteresisStr.toInt();
         }
         
+        point->setSamplePeriodLimits(pointsConf(key + "_min_period").toInt(),
+                                     pointsConf(key + "_max_period").toInt());
+
         int cs = pointsConf(key + "_sensor_cs").toInt();
         if (cs > 0) {
             // Ensure the sensor exists and is initialized before binding
@@ -533,7 +660,9 @@ void ConfigManager::loadPointsConfig() {
                 if (!sensor->initialize()) {
                     //sensor->setErrorStatus(0x01); // Mark as error (not connected)
                 }
-                controller.addSensor(sensor);
+                if (!controller.addSensor(sensor)) {
+                    delete sensor;
+                }
             }
             controller.bindSensorToPointByChipSelect(cs, address);
         } else {
@@ -543,7 +672,7 @@ void ConfigManager::loadPointsConfig() {
     
     // Load alarm configurations after sensor binding
     // DS18B20 points
-    for (uint8_t i = 0; i < 50; ++i) {
+    for (uint8_t i = 0; i < controller.getDS18B20PointCount(); ++i) {
         MeasurementPoint* point = controller.getDS18B20Point(i);
         if (!point) continue;
         
@@ -607,8 +736,8 @@ void ConfigManager::loadPointsConfig() {
     }
     
     // PT1000 points
-    for (uint8_t i = 0; i < 10; ++i) {
-        uint8_t address = 50 + i;
+    for (uint8_t i = 0; i < controller.getPT1000PointCount(); ++i) {
+        uint8_t address = controller.getPT1000Base() + i;
         MeasurementPoint* point = controller.getPT1000Point(i);
         if (!point) continue;
         
@@ -995,7 +1124,12 @@ void ConfigManager::sensorAPI(){
         server->sendHeader("Connection", "close");
         server->sendHeader("Access-Control-Allow-Origin", "*");
         server->sendHeader("Cache-Control", "no-store");
-        server->send(200, "application/json", controller.getSensorsJson());
+        String json = controller.getSensorsJson();
+        if (json.length() > 0) {
+            server->send(200, "application/json", json);
+        } else {
+            server->send(500, "application/json", "{\"error\":\"Sensor list too large\"}");
+        }
     });
     
     server->on("/api/status", HTTP_GET, [this]() {
@@ -1077,9 +1211,9 @@ void ConfigManager::sensorAPI(){
                 if (doc.containsKey("romString")) {
                     String rom = doc["romString"].as<String>();
                     // Find point bound to this ROM and unbind
-                    for (uint8_t i = 0; i < 50; ++i) {
-                        Sensor* bound = controller.getDS18B20Point(i)->getBoundSensor();
-                        if (bound && bound->getDS18B20RomString() == rom) {
+                    Sensor* sensor = controller.findSensorByRom(rom);
+                    for (uint8_t i = 0; sensor && i < controller.getDS18B20PointCount(); ++i) {
+                        if (controller.getDS18B20Point(i)->getBoundSensor() == sensor) {
                             if(controller.unbindSensorFromPoint(i)){
                                 savePointsConfig();
                             server->send(200, "text/plain", "Unbound");
@@ -1091,10 +1225,10 @@ void ConfigManager::sensorAPI(){
                     }
                 } else if (doc.containsKey("chipSelect")) {
                     int cs = doc["chipSelect"];
-                    for (uint8_t i = 0; i < 10; ++i) {
+                    for (uint8_t i = 0; i < controller.getPT1000PointCount(); ++i) {
                         Sensor* bound = controller.getPT1000Point(i)->getBoundSensor();
                         if (bound && bound->getPT1000ChipSelectPin() == cs) {
-                            if(controller.unbindSensorFromPoint(50 + i)){
+                            if(controller.unbindSensorFromPoint(controller.getPT1000Base() + i)){
                                 savePointsConfig();
                                 server->send(200, "text/plain", "Unbound");
                                 return;
@@ -1244,7 +1378,14 @@ void ConfigManager::pointsAPI(){
     // GET points
     server->on("/api/points", HTTP_GET, [this]() {
         server->sendHeader("Content-Type", "application/json");
-        server->send(200, "application/json", controller.getPointsJson());
+        // ?since=<sequence> returns only points changed after that sequence
+        uint32_t since = server->hasArg("since") ? strtoul(server->arg("since").c_str(), nullptr, 10) : 0;
+        String json = controller.getPointsJson(since);
+        if (json.length() > 0) {
+            server->send(200, "application/json", json);
+        } else {
+            server->send(500, "application/json", "{\"error\":\"Point list too large\"}");
+        }
     });
 
     // PUT point update
@@ -1274,6 +1415,13 @@ void ConfigManager::pointsAPI(){
         point->setName(name);
         point->setLowAlarmThreshold(low);
         point->setHighAlarmThreshold(high);
+        if (doc.containsKey("resolution") && controller.isDS18B20Address(address)) {
+            point->setResolution(doc["resolution"].as<uint8_t>());
+        }
+        if (doc.containsKey("minPeriodMs") || doc.containsKey("maxPeriodMs")) {
+            point->setSamplePeriodLimits(doc["minPeriodMs"] | point->getMinSamplePeriod(),
+                                         doc["maxPeriodMs"] | point->getMaxSamplePeriod());
+        }
         Serial.printf("Point: %s. LAS: %d, HAS: %d\n Delay....\n", point->getName(), point->getLowAlarmThreshold(), point->getHighAlarmThreshold());
         delay(5000);
         controller.applyConfigToRegisterMap();
@@ -1440,18 +1588,14 @@ void ConfigManager::alarmsAPI(){
             return;
         }
 
-        // Find corresponding active alarm and acknowledge it
+        // The configured alarm is the one the queues hold; acknowledge it directly
         bool acknowledged = false;
-        for (auto activeAlarm : controller.getActiveAlarms()) {
-            if (activeAlarm->getSource() == alarm->getSource() && 
-                activeAlarm->getType() == alarm->getType()) {
-                activeAlarm->acknowledge();
-                acknowledged = true;
-                Serial.printf("Acknowledged alarm: %s for point %d\n", 
-                            activeAlarm->getTypeString().c_str(),
-                            activeAlarm->getSource()->getAddress());
-                break;
-            }
+        if (alarm->isEnabled() && alarm->isActive()) {
+            alarm->acknowledge();
+            acknowledged = true;
+            Serial.printf("Acknowledged alarm: %s for point %d\n", 
+                        alarm->getTypeString().c_str(),
+                        alarm->getSource() ? alarm->getSource()->getAddress() : -1);
         }
 
         if (acknowledged) {
@@ -1554,31 +1698,18 @@ void ConfigManager::alarmsAPI(){
 
     // Get alarm statistics
     server->on("/api/alarms/stats", HTTP_GET, [this]() {
-        std::vector<Alarm*> activeAlarms = controller.getActiveAlarms();
-        
-        int criticalCount = 0, highCount = 0, mediumCount = 0, lowCount = 0;
-        int newCount = 0, activeCount = 0, acknowledgedCount = 0;
-        
-        for (auto alarm : activeAlarms) {
-            // Count by priority
-            switch (alarm->getPriority()) {
-                case AlarmPriority::PRIORITY_CRITICAL: criticalCount++; break;
-                case AlarmPriority::PRIORITY_HIGH: highCount++; break;
-                case AlarmPriority::PRIORITY_MEDIUM: mediumCount++; break;
-                case AlarmPriority::PRIORITY_LOW: lowCount++; break;
-            }
-            
-            // Count by stage
-            switch (alarm->getStage()) {
-                case AlarmStage::NEW: newCount++; break;
-                case AlarmStage::ACTIVE: activeCount++; break;
-                case AlarmStage::ACKNOWLEDGED: acknowledgedCount++; break;
-                default: break;
-            }
-        }
+        // Active = ACTIVE or ACKNOWLEDGED, the two highest stages
+        const AlarmStage active = AlarmStage::ACKNOWLEDGED;
+        int criticalCount = controller.getAlarmCount(AlarmPriority::PRIORITY_CRITICAL, active, AlarmCompare::EQ, AlarmCompare::GE);
+        int highCount = controller.getAlarmCount(AlarmPriority::PRIORITY_HIGH, active, AlarmCompare::EQ, AlarmCompare::GE);
+        int mediumCount = controller.getAlarmCount(AlarmPriority::PRIORITY_MEDIUM, active, AlarmCompare::EQ, AlarmCompare::GE);
+        int lowCount = controller.getAlarmCount(AlarmPriority::PRIORITY_LOW, active, AlarmCompare::EQ, AlarmCompare::GE);
+        int newCount = controller.getAlarmCount(AlarmStage::NEW);
+        int activeCount = controller.getAlarmCount(AlarmStage::ACTIVE);
+        int acknowledgedCount = controller.getAlarmCount(AlarmStage::ACKNOWLEDGED);
         
         DynamicJsonDocument doc(512);
-        doc["totalActive"] = activeAlarms.size();
+        doc["totalActive"] = controller.getAlarmCount(active, AlarmCompare::GE);
         doc["totalConfigured"] = controller.getAlarmCount();
         
         JsonObject byPriority = doc.createNestedObject("byPriority");
@@ -1591,6 +1722,9 @@ void ConfigManager::alarmsAPI(){
         byStage["new"] = newCount;
         byStage["active"] = activeCount;
         byStage["acknowledged"] = acknowledgedCount;
+
+        doc["eventsPending"] = controller.getPendingAlarmEvents();
+        doc["eventsDropped"] = controller.getDroppedAlarmEvents();
         
         String output;
         serializeJson(doc, output);
@@ -1676,11 +1810,13 @@ void ConfigManager::alarmsAPI(){
 
     // GET /api/alarm-config - Get alarm configuration for all measurement points
     server->on("/api/alarm-config", HTTP_GET, [this]() {
-        DynamicJsonDocument doc(8192); // Increased size for all points
+        // Sized for every point; 13 members and a copied name each
+        ExternalJsonDocument doc(JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(controller.getPointCount()) +
+                                 controller.getPointCount() * (JSON_OBJECT_SIZE(13) + 64));
         JsonArray pointsArray = doc.createNestedArray("points");
         
-        // Get DS18B20 points (0-49)
-        for (uint8_t i = 0; i < 50; ++i) {
+        // Get DS18B20 points
+        for (uint8_t i = 0; i < controller.getDS18B20PointCount(); ++i) {
             MeasurementPoint* point = controller.getMeasurementPoint(i);
             if (!point) continue;
             
@@ -1729,8 +1865,8 @@ void ConfigManager::alarmsAPI(){
             }
         }
         
-        // Get PT1000 points (50-59)
-        for (uint8_t i = 50; i < 60; ++i) {
+        // Get PT1000 points
+        for (uint16_t i = controller.getPT1000Base(); i < controller.getPointCount(); ++i) {
             MeasurementPoint* point = controller.getMeasurementPoint(i);
             if (!point) continue;
             
@@ -1779,6 +1915,11 @@ void ConfigManager::alarmsAPI(){
             }
         }
         
+        if (doc.overflowed()) {
+            server->send(500, "application/json", "{\"error\":\"Alarm configuration too large\"}");
+            return;
+        }
+
         String output;
         serializeJson(doc, output);
         
@@ -282,8 +282,8 @@ String LoggerManager::_generateLogFileNameWithSequence() {
 String LoggerManager::_generateCSVHeader() {
     String header = "Date,Time";
     
-    // Add all 60 measurement points (0-59)
-    for (int i = 0; i < 60; i++) {
+    // Add every allocated measurement point
+    for (int i = 0; i < _controller->getPointCount(); i++) {
         MeasurementPoint* point = _controller->getMeasurementPoint(i);
         if (point) {
             String pointName = point->getName();
@@ -332,16 +332,12 @@ bool LoggerManager::_writeDataRow() {
     // Build data row
     String dataRow = _getCurrentDateString() + "," + _getCurrentTimeString();
     
-    // Add temperature data for all 60 points
-    for (int i = 0; i < 60; i++) {
-        MeasurementPoint* point = _controller->getMeasurementPoint(i);
-        if (point && point->getBoundSensor()) {
-            // Point has a bound sensor, log actual temperature
-            dataRow += "," + String(point->getCurrentTemp());
-        } else {
-            // No bound sensor, log empty value
-            dataRow += ",";
-        }
+    // Add temperature data for every allocated point
+    const PointHotStore& hot = _controller->getHotStore();
+    for (uint16_t i = 0; i < hot.size(); i++) {
+        dataRow += ',';
+        // Points without a bound sensor log an empty value
+        if (hot.bound[i]) dataRow += String(hot.current[i]);
     }
     
     dataRow += "\n";
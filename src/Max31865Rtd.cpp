@@ -0,0 +1,79 @@
+/**
+ * @file Max31865Rtd.cpp
+ * @brief Implementation of the hardware MAX31865 backend
+ * @author barabashsr
+ * @date 2026-10-16
+ *
+ * @section dependencies Dependencies
+ * - Max31865Rtd.h for class definition
+ */
+
+#include "Max31865Rtd.h"
+
+Max31865Rtd::Max31865Rtd(uint8_t csPin)
+    : _csPin(csPin), _max31865(new Adafruit_MAX31865(csPin))
+{
+}
+
+Max31865Rtd::~Max31865Rtd() {
+    delete _max31865;
+}
+
+bool Max31865Rtd::begin() {
+    return _max31865->begin(MAX31865_3WIRE); // Adjust for your wiring
+}
+
+void Max31865Rtd::configure(bool continuous, bool filter50Hz) {
+    // Filter select must not change while auto-convert is running
+    _max31865->autoConvert(false);
+    _max31865->enable50Hz(filter50Hz);
+    _max31865->enableBias(continuous);
+    _max31865->autoConvert(continuous);
+}
+
+void Max31865Rtd::readLatest(uint16_t& raw, uint8_t& fault) {
+    // Latest auto-converted result: RTD MSB, LSB (bit 0 = fault)
+    uint8_t rtd[2];
+    _readRegisters(MAX31865_REG_RTD_MSB, rtd, 2);
+    fault = 0;
+    if (rtd[1] & 0x01) _readRegisters(MAX31865_REG_FAULT, &fault, 1);
+    raw = (((uint16_t)rtd[0] << 8) | rtd[1]) >> 1;
+}
+
+void Max31865Rtd::readOneShot(uint16_t& raw, uint8_t& fault) {
+    fault = _max31865->readFault();
+    raw = (fault & RTD_FAULT_SERIOUS) ? 0 : _max31865->readRTD();
+}
+
+void Max31865Rtd::setBias(bool on) {
+    _max31865->enableBias(on);
+}
+
+void Max31865Rtd::startOneShot() {
+    uint8_t config;
+    _readRegisters(MAX31865_REG_CONFIG, &config, 1);
+    _writeRegister(MAX31865_REG_CONFIG, config | MAX31865_CONFIG_ONESHOT);
+}
+
+void Max31865Rtd::clearFault() {
+    // Clearing keeps bias and auto-convert bits set
+    _max31865->clearFault();
+}
+
+void Max31865Rtd::_readRegisters(uint8_t reg, uint8_t* buf, uint8_t len) {
+    SPI.beginTransaction(SPISettings(MAX31865_SPI_CLOCK, MSBFIRST, SPI_MODE1));
+    digitalWrite(_csPin, LOW);
+    SPI.transfer(reg & 0x7F);
+    for (uint8_t i = 0; i < len; ++i) buf[i] = SPI.transfer(0xFF);
+    digitalWrite(_csPin, HIGH);
+    SPI.endTransaction();
+}
+
+void Max31865Rtd::_writeRegister(uint8_t reg, uint8_t value) {
+    SPI.beginTransaction(SPISettings(MAX31865_SPI_CLOCK, MSBFIRST, SPI_MODE1));
+    digitalWrite(_csPin, LOW);
+    SPI.transfer(reg | 0x80);
+    SPI.transfer(value);
+    digitalWrite(_csPin, HIGH);
+    SPI.endTransaction();
+}
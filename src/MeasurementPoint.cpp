@@ -9,6 +9,7 @@
  * @section dependencies Dependencies
  * - MeasurementPoint.h for class definition
  * - Sensor.h for temperature sensor interface
+ * - PointHotStore.h for the per-point temperature and status arrays
  * 
  * @section features Features
  * - Sensor binding and unbinding
@@ -21,16 +22,13 @@
 #include "MeasurementPoint.h"
 
 
-MeasurementPoint::MeasurementPoint(uint8_t address, const String& name)
+MeasurementPoint::MeasurementPoint(uint8_t address, const String& name, PointHotStore& hot)
     : address(address),
       name(name),
-      currentTemp(0),
-      minTemp(32767),
-      maxTemp(-32768),
-      lowAlarmThreshold(-10),
-      highAlarmThreshold(50),
-      alarmStatus(0),
-      errorStatus(0),
+      hot(hot),
+      resolution(DS18B20_DEFAULT_RESOLUTION),
+      minSamplePeriodMs(0),
+      maxSamplePeriodMs(0),
       boundSensor(nullptr)
       //oneWireBus(0)
 {
@@ -51,37 +49,38 @@ String MeasurementPoint::getName() const {
 }
 
 int16_t MeasurementPoint::getCurrentTemp() const {
-    return currentTemp;
+    return hot.current[address];
 }
 
 int16_t MeasurementPoint::getMinTemp() const {
-    return minTemp;
+    return hot.minTemp[address];
 }
 
 int16_t MeasurementPoint::getMaxTemp() const {
-    return maxTemp;
+    return hot.maxTemp[address];
 }
 
 int16_t MeasurementPoint::getLowAlarmThreshold() const {
-    return lowAlarmThreshold;
+    return hot.lowThreshold[address];
 }
 
 int16_t MeasurementPoint::getHighAlarmThreshold() const {
-    return highAlarmThreshold;
+    return hot.highThreshold[address];
 }
 
 uint8_t MeasurementPoint::getAlarmStatus() const {
-    return alarmStatus;
+    return hot.alarmStatus(address);
 }
 
 uint8_t MeasurementPoint::getErrorStatus() const {
-    return errorStatus;
+    return hot.errorBits[address];
 }
 
 void MeasurementPoint::setName(const String& newName) {
     if (newName != name) {
         String oldName = name.isEmpty() ? "Point_" + String(address) : name;
         name = newName;
+        hot.markChanged(address);
         LoggerManager::info("POINT_CONFIG", 
             "Point " + String(address) + " name changed from '" + 
             oldName + "' to '" + name + "'");
@@ -91,36 +90,91 @@ void MeasurementPoint::setName(const String& newName) {
 
 void MeasurementPoint::setLowAlarmThreshold(int16_t threshold) {
 
-    if (lowAlarmThreshold != threshold) {
+    if (hot.lowThreshold[address] != threshold) {
         LoggerManager::info("POINT_CONFIG", 
             "Point " + String(address) + " (" + name + 
-            ") low alarm threshold changed from " + String(lowAlarmThreshold) + 
+            ") low alarm threshold changed from " + String(hot.lowThreshold[address]) + 
             "°C to " + String(threshold) + "°C");
-        lowAlarmThreshold = threshold;
+        hot.lowThreshold[address] = threshold;
+        hot.markChanged(address);
     }
+    // The sampling scheduler of the sensor tracks the margin to the thresholds
+    if (boundSensor != nullptr) boundSensor->setLowAlarmThreshold(threshold);
 
-    //lowAlarmThreshold = threshold;
-    updateAlarmStatus();
+    hot.evaluateAlarms();
 }
 
 void MeasurementPoint::setHighAlarmThreshold(int16_t threshold) {
-    if (highAlarmThreshold != threshold) {
+    if (hot.highThreshold[address] != threshold) {
         LoggerManager::info("POINT_CONFIG", 
             "Point " + String(address) + " (" + name + 
-            ") high alarm threshold changed from " + String(highAlarmThreshold) + 
+            ") high alarm threshold changed from " + String(hot.highThreshold[address]) + 
             "°C to " + String(threshold) + "°C");
-        highAlarmThreshold = threshold;
+        hot.highThreshold[address] = threshold;
+        hot.markChanged(address);
     }
-    //highAlarmThreshold = threshold;
-    updateAlarmStatus();
+    if (boundSensor != nullptr) boundSensor->setHighAlarmThreshold(threshold);
+    hot.evaluateAlarms();
+}
+
+void MeasurementPoint::setLowAlarmHysteresis(int16_t hysteresis) {
+    if (hot.lowHysteresis[address] == hysteresis) return;
+    hot.lowHysteresis[address] = hysteresis;
+    hot.evaluateAlarms();
+    hot.markChanged(address);
+}
+
+void MeasurementPoint::setHighAlarmHysteresis(int16_t hysteresis) {
+    if (hot.highHysteresis[address] == hysteresis) return;
+    hot.highHysteresis[address] = hysteresis;
+    hot.evaluateAlarms();
+    hot.markChanged(address);
+}
+
+void MeasurementPoint::setResolution(uint8_t bits) {
+    bits = constrain(bits, DS18B20_MIN_RESOLUTION, DS18B20_MAX_RESOLUTION);
+    if (resolution != bits) {
+        LoggerManager::info("POINT_CONFIG", 
+            "Point " + String(address) + " (" + name + 
+            ") resolution changed from " + String(resolution) + 
+            " to " + String(bits) + " bits");
+        resolution = bits;
+        hot.markChanged(address);
+    }
+    if (boundSensor != nullptr && boundSensor->getType() == SensorType::DS18B20)
+        boundSensor->setResolution(resolution);
+}
+
+void MeasurementPoint::setSamplePeriodLimits(uint32_t minMs, uint32_t maxMs) {
+    if (minMs != minSamplePeriodMs || maxMs != maxSamplePeriodMs) {
+        LoggerManager::info("POINT_CONFIG", 
+            "Point " + String(address) + " (" + name + 
+            ") sampling period limits set to " + String(minMs) + 
+            "-" + String(maxMs) + " ms (0 = default)");
+        minSamplePeriodMs = minMs;
+        maxSamplePeriodMs = maxMs;
+        hot.markChanged(address);
+    }
+    if (boundSensor != nullptr)
+        boundSensor->setSamplePeriodLimits(minSamplePeriodMs, maxSamplePeriodMs);
 }
 
 void MeasurementPoint::bindSensor(Sensor* sensor) {
     boundSensor = sensor;
+    hot.bound[address] = sensor != nullptr;
+    hot.markChanged(address);
+    if (sensor == nullptr) return;
+    if (sensor->getType() == SensorType::DS18B20)
+        sensor->setResolution(resolution);
+    sensor->setLowAlarmThreshold(hot.lowThreshold[address]);
+    sensor->setHighAlarmThreshold(hot.highThreshold[address]);
+    sensor->setSamplePeriodLimits(minSamplePeriodMs, maxSamplePeriodMs);
 }
 
 void MeasurementPoint::unbindSensor() {
     boundSensor = nullptr;
+    hot.bound[address] = 0;
+    hot.markChanged(address);
 }
 
 Sensor* MeasurementPoint::getBoundSensor() const {
@@ -128,33 +182,29 @@ Sensor* MeasurementPoint::getBoundSensor() const {
 }
 
 void MeasurementPoint::update() {
+    int16_t temp = hot.current[address];
+    uint8_t error = POINT_ERROR_UNBOUND;
     if (boundSensor != nullptr) {
-        // Example: ask the sensor for the latest temperature
-        //if (boundSensor->readTemperature()) {
-            currentTemp = boundSensor->getCurrentTemp();
-            //Serial.printf("\nPoint: %d. %s. Sensor: %s. Temp: %d\n", getAddress(), getName(), boundSensor->getName(), currentTemp);
-            if (currentTemp < minTemp) minTemp = currentTemp;
-            if (currentTemp > maxTemp) maxTemp = currentTemp;
-            errorStatus = boundSensor->getErrorStatus();
-        //} else {
-            //errorStatus = boundSensor->getErrorStatus();
-        //}
-    } else {
-        errorStatus = 0x01; // Example: error code for "not bound"
+        temp = boundSensor->getCurrentTemp();
+        error = boundSensor->getErrorStatus();
     }
-    updateAlarmStatus();
+    if (temp == hot.current[address] && error == hot.errorBits[address]) return;
+    hot.current[address] = temp;
+    if (temp < hot.minTemp[address]) hot.minTemp[address] = temp;
+    if (temp > hot.maxTemp[address]) hot.maxTemp[address] = temp;
+    hot.errorBits[address] = error;
+    hot.evaluateAlarms();
+    hot.markChanged(address);
 }
 
 void MeasurementPoint::resetMinMaxTemp() {
-    minTemp = currentTemp;
-    maxTemp = currentTemp;
+    hot.minTemp[address] = hot.current[address];
+    hot.maxTemp[address] = hot.current[address];
+    hot.markChanged(address);
 }
 
-void MeasurementPoint::updateAlarmStatus() {
-    alarmStatus = 0;
-    if (errorStatus != 0) return;
-    if (currentTemp < lowAlarmThreshold) alarmStatus |= 0x01; // Low alarm bit
-    if (currentTemp > highAlarmThreshold) alarmStatus |= 0x02; // High alarm bit
+void MeasurementPoint::markChanged() {
+    hot.markChanged(address);
 }
 
 // void MeasurementPoint::setOneWireBus(uint8_t bus) {
@@ -0,0 +1,80 @@
+/**
+ * @file OneWireBus.cpp
+ * @brief Implementation of the hardware OneWire bus backend
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Creates one OneWire/DallasTemperature pair per GPIO and a recursive
+ *          mutex that arbitrates access between the acquisition task, discovery
+ *          and the web configuration handlers.
+ * 
+ * @section dependencies Dependencies
+ * - OneWireBus.h for class definition
+ */
+
+#include "OneWireBus.h"
+
+OneWireBus::OneWireBus(uint8_t pin)
+    : _pin(pin), _wire(nullptr), _dallas(nullptr), _mutex(nullptr)
+{
+    _wire = new OneWire(pin);
+    _dallas = new DallasTemperature(_wire);
+    // Conversion waits are scheduled by the caller, never inside the driver
+    _dallas->setWaitForConversion(false);
+    _mutex = xSemaphoreCreateRecursiveMutex();
+}
+
+OneWireBus::~OneWireBus() {
+    delete _dallas;
+    delete _wire;
+    if (_mutex) vSemaphoreDelete(_mutex);
+}
+
+void OneWireBus::lock() {
+    if (_mutex) xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+}
+
+void OneWireBus::unlock() {
+    if (_mutex) xSemaphoreGiveRecursive(_mutex);
+}
+
+bool OneWireBus::begin() {
+    // Sets the driver's parasite flag used by the Convert-T requests below
+    _dallas->begin();
+    return _dallas->isParasitePowerMode();
+}
+
+bool OneWireBus::convertAll() {
+    _dallas->requestTemperatures();
+    return true;
+}
+
+bool OneWireBus::convert(const uint8_t* rom) {
+    return _dallas->requestTemperaturesByAddress(rom);
+}
+
+bool OneWireBus::readScratchPad(const uint8_t* rom, uint8_t* scratchPad) {
+    return _dallas->readScratchPad(rom, scratchPad);
+}
+
+bool OneWireBus::writeScratchPad(const uint8_t* rom, const uint8_t* scratchPad) {
+    _dallas->writeScratchPad(rom, scratchPad);
+    return true;
+}
+
+bool OneWireBus::setResolution(const uint8_t* rom, uint8_t bits) {
+    // Skip the global resolution recalculation: it searches the whole bus
+    return _dallas->setResolution(rom, bits, true);
+}
+
+bool OneWireBus::isConnected(const uint8_t* rom) {
+    return _dallas->isConnected(rom);
+}
+
+void OneWireBus::resetSearch() {
+    _wire->reset_search();
+}
+
+bool OneWireBus::search(uint8_t* rom, bool alarmOnly) {
+    // search_mode false = Alarm Search (0xEC)
+    return _wire->search(rom, !alarmOnly);
+}
@@ -0,0 +1,62 @@
+/**
+ * @file PointRegistry.cpp
+ * @brief Implementation of the measurement point table
+ * @author barabashsr
+ * @date 2026-10-16
+ *
+ * @section dependencies Dependencies
+ * - PointRegistry.h for class definition
+ * - ExternalMemory.h for PSRAM allocation
+ */
+
+#include "PointRegistry.h"
+#include "ExternalMemory.h"
+#include <new>
+
+PointRegistry::PointRegistry()
+    : _points(nullptr), _dsCount(0), _ptCount(0), _count(0), _external(false)
+{
+}
+
+PointRegistry::~PointRegistry() {
+    _release();
+}
+
+bool PointRegistry::allocate(uint8_t dsCount, uint8_t ptCount) {
+    uint16_t count = (uint16_t)dsCount + ptCount;
+    if (count > POINT_REGISTRY_MAX_POINTS) return false;
+
+    PointHotStore hot;
+    if (!hot.allocate(count, _hot.getSequence())) return false;
+
+    bool external = false;
+    MeasurementPoint* points = nullptr;
+    if (count > 0) {
+        points = static_cast<MeasurementPoint*>(externalAlloc(sizeof(MeasurementPoint) * count, &external));
+        if (points == nullptr) return false;
+    }
+
+    // New points refer to _hot, which takes the fresh arrays below
+    for (uint8_t i = 0; i < dsCount; ++i)
+        new (&points[i]) MeasurementPoint(i, "DS18B20_Point_" + String(i), _hot);
+    for (uint8_t i = 0; i < ptCount; ++i)
+        new (&points[dsCount + i]) MeasurementPoint(dsCount + i, "PT1000_Point_" + String(i), _hot);
+
+    _release();
+    _hot.swap(hot);
+    _points = points;
+    _dsCount = dsCount;
+    _ptCount = ptCount;
+    _count = count;
+    _external = external;
+    return true;
+}
+
+void PointRegistry::_release() {
+    for (uint16_t i = 0; i < _count; ++i)
+        _points[i].~MeasurementPoint();
+    externalFree(_points);
+    _points = nullptr;
+    _dsCount = _ptCount = 0;
+    _count = 0;
+}
@@ -16,6 +16,7 @@
  */
 
 #include "RegisterMap.h"
+#include "ExternalMemory.h"
 
 RegisterMap::RegisterMap() {
     deviceId = 1000;
@@ -24,21 +25,12 @@ RegisterMap::RegisterMap() {
     numActivePT1000 = 0;
     commandRegister = 0;
     commandPending = false;
+    pointRegisters = nullptr;
+    pointCount = 0;
+    pt1000Base = 0;
+    pointSequence = 0;
     
     for (int i = 0; i < 7; i++) deviceStatus[i] = 0;
-    for (int i = 0; i < 60; i++) {
-        currentTemps[i] = 0;
-        minTemps[i] = 32767;
-        maxTemps[i] = -32768;
-        alarmStatus[i] = 0;
-        errorStatus[i] = 0;
-        lowAlarmThresholds[i] = -10;
-        highAlarmThresholds[i] = 50;
-        // Initialize alarm config with all alarms disabled, medium priority
-        alarmConfig[i] = (1 << ALARM_CONFIG_LOW_PRIORITY_SHIFT) | 
-                        (1 << ALARM_CONFIG_HIGH_PRIORITY_SHIFT) | 
-                        (1 << ALARM_CONFIG_ERROR_PRIORITY_SHIFT);
-    }
     
     // Initialize relay control (all auto mode)
     for (int i = 0; i < 6; i++) {
@@ -56,17 +48,62 @@ RegisterMap::RegisterMap() {
     }
 }
 
+RegisterMap::~RegisterMap() {
+    externalFree(pointRegisters);
+}
+
+bool RegisterMap::allocatePoints(uint16_t count, uint8_t ptBase) {
+    uint16_t* block = allocatePointBlock(count);
+    if (block == nullptr) return false;
+    adoptPoints(block, count, ptBase);
+    return true;
+}
+
+uint16_t* RegisterMap::allocatePointBlock(uint16_t count) {
+    return static_cast<uint16_t*>(
+        externalAlloc(sizeof(uint16_t) * POINT_FIELD_COUNT * (count ? count : 1)));
+}
+
+void RegisterMap::adoptPoints(uint16_t* block, uint16_t count, uint8_t ptBase) {
+    externalFree(pointRegisters);
+    pointRegisters = block;
+    pointCount = count;
+    pt1000Base = ptBase;
+
+    for (uint16_t i = 0; i < count; i++) {
+        pointRegister(POINT_FIELD_CURRENT, i) = 0;
+        pointRegister(POINT_FIELD_MIN, i) = static_cast<uint16_t>(32767);
+        pointRegister(POINT_FIELD_MAX, i) = static_cast<uint16_t>(-32768);
+        pointRegister(POINT_FIELD_ALARM_STATUS, i) = 0;
+        pointRegister(POINT_FIELD_ERROR_STATUS, i) = 0;
+        pointRegister(POINT_FIELD_LOW_ALARM, i) = static_cast<uint16_t>(-10);
+        pointRegister(POINT_FIELD_HIGH_ALARM, i) = 50;
+        // Initialize alarm config with all alarms disabled, medium priority
+        pointRegister(POINT_FIELD_ALARM_CONFIG, i) = (1 << ALARM_CONFIG_LOW_PRIORITY_SHIFT) | 
+                                                     (1 << ALARM_CONFIG_HIGH_PRIORITY_SHIFT) | 
+                                                     (1 << ALARM_CONFIG_ERROR_PRIORITY_SHIFT);
+    }
+}
+
+bool RegisterMap::decodePointRegister(uint16_t address, uint8_t& field, uint16_t& index) const {
+    if (address >= POINT_BLOCK_START_REG) {
+        uint16_t offset = address - POINT_BLOCK_START_REG;
+        field = offset / POINT_BLOCK_STRIDE;
+        index = offset % POINT_BLOCK_STRIDE;
+        return field < POINT_FIELD_COUNT && index < pointCount;
+    }
+    // Legacy windows: one per hundred registers from 100, indexed by point address
+    if (address < CURRENT_TEMP_DS18B20_START_REG || address > ALARM_CONFIG_PT1000_END_REG) return false;
+    field = address / 100 - 1;
+    index = address % 100;
+    return index < LEGACY_POINT_WINDOW && index < pointCount;
+}
+
 bool RegisterMap::isValidAddress(uint16_t address) {
-    if (address <= DEVICE_STATUS_END_REG) return true;
-    if (address >= RELAY_STATUS_REG_START && address <= RELAY_STATUS_REG_END) return true;
-    if (address >= CURRENT_TEMP_DS18B20_START_REG && address <= CURRENT_TEMP_PT1000_END_REG) return true;
-    if (address >= MIN_TEMP_DS18B20_START_REG && address <= MIN_TEMP_PT1000_END_REG) return true;
-    if (address >= MAX_TEMP_DS18B20_START_REG && address <= MAX_TEMP_PT1000_END_REG) return true;
-    if (address >= ALARM_STATUS_DS18B20_START_REG && address <= ALARM_STATUS_PT1000_END_REG) return true;
-    if (address >= ERROR_STATUS_DS18B20_START_REG && address <= ERROR_STATUS_PT1000_END_REG) return true;
-    if (address >= LOW_ALARM_DS18B20_START_REG && address <= LOW_ALARM_PT1000_END_REG) return true;
-    if (address >= HIGH_ALARM_DS18B20_START_REG && address <= HIGH_ALARM_PT1000_END_REG) return true;
-    if (address >= ALARM_CONFIG_DS18B20_START_REG && address <= ALARM_CONFIG_PT1000_END_REG) return true;
+    uint8_t field;
+    uint16_t index;
+    if (address <= POINT_SEQUENCE_REG) return true; // Device info, health, relay status, layout
+    if (decodePointRegister(address, field, index)) return true;
     if (address >= RELAY_CONTROL_START_REG && address <= RELAY_CONTROL_END_REG) return true;
     if (address >= HYSTERESIS_START_REG && address <= HYSTERESIS_END_REG) return true;
     if (address == COMMAND_REG) return true;
@@ -75,9 +112,10 @@ bool RegisterMap::isValidAddress(uint16_t address) {
 
 bool RegisterMap::isReadOnlyRegister(uint16_t address) {
     // Writable registers
-    if (address >= LOW_ALARM_DS18B20_START_REG && address <= LOW_ALARM_PT1000_END_REG) return false;
-    if (address >= HIGH_ALARM_DS18B20_START_REG && address <= HIGH_ALARM_PT1000_END_REG) return false;
-    if (address >= ALARM_CONFIG_DS18B20_START_REG && address <= ALARM_CONFIG_PT1000_END_REG) return false;
+    uint8_t field;
+    uint16_t index;
+    if (decodePointRegister(address, field, index))
+        return field < POINT_FIELD_LOW_ALARM;
     if (address >= RELAY_CONTROL_START_REG && address <= RELAY_CONTROL_START_REG + 2) return false; // Only control, not status
     if (address >= HYSTERESIS_START_REG && address <= HYSTERESIS_END_REG) return false;
     if (address == COMMAND_REG) return false;
@@ -95,26 +133,15 @@ uint16_t RegisterMap::readHoldingRegister(uint16_t address) {
         return deviceStatus[address - DEVICE_STATUS_START_REG];
     if (address >= RELAY_STATUS_REG_START && address <= RELAY_STATUS_REG_END)
         return relayStatus[address - RELAY_STATUS_REG_START];
+    if (address == POINT_COUNT_REG) return pointCount;
+    if (address == PT1000_BASE_REG) return pt1000Base;
+    if (address == POINT_SEQUENCE_REG) return pointSequence;
 
-    // DS18B20 and PT1000 share the same arrays, just different index offsets
-    if (address >= CURRENT_TEMP_DS18B20_START_REG && address <= CURRENT_TEMP_PT1000_END_REG)
-        return currentTemps[address - CURRENT_TEMP_DS18B20_START_REG];
-    if (address >= MIN_TEMP_DS18B20_START_REG && address <= MIN_TEMP_PT1000_END_REG)
-        return minTemps[address - MIN_TEMP_DS18B20_START_REG];
-    if (address >= MAX_TEMP_DS18B20_START_REG && address <= MAX_TEMP_PT1000_END_REG)
-        return maxTemps[address - MAX_TEMP_DS18B20_START_REG];
-    if (address >= ALARM_STATUS_DS18B20_START_REG && address <= ALARM_STATUS_PT1000_END_REG)
-        return alarmStatus[address - ALARM_STATUS_DS18B20_START_REG];
-    if (address >= ERROR_STATUS_DS18B20_START_REG && address <= ERROR_STATUS_PT1000_END_REG)
-        return errorStatus[address - ERROR_STATUS_DS18B20_START_REG];
-    if (address >= LOW_ALARM_DS18B20_START_REG && address <= LOW_ALARM_PT1000_END_REG)
-        return lowAlarmThresholds[address - LOW_ALARM_DS18B20_START_REG];
-    if (address >= HIGH_ALARM_DS18B20_START_REG && address <= HIGH_ALARM_PT1000_END_REG)
-        return highAlarmThresholds[address - HIGH_ALARM_DS18B20_START_REG];
-    
-    // Alarm configuration registers
-    if (address >= ALARM_CONFIG_DS18B20_START_REG && address <= ALARM_CONFIG_PT1000_END_REG)
-        return alarmConfig[address - ALARM_CONFIG_DS18B20_START_REG];
+    // Temperatures, status flags, thresholds and alarm configuration
+    uint8_t field;
+    uint16_t index;
+    if (decodePointRegister(address, field, index))
+        return pointRegister(field, index);
     
     // Relay control and status registers
     if (address >= RELAY_CONTROL_START_REG && address <= RELAY_CONTROL_END_REG)
@@ -135,19 +162,11 @@ bool RegisterMap::writeHoldingRegister(uint16_t address, uint16_t value) {
     if (!isValidAddress(address)) return false;
     if (isReadOnlyRegister(address)) return false;
 
-    // Alarm thresholds
-    if (address >= LOW_ALARM_DS18B20_START_REG && address <= LOW_ALARM_PT1000_END_REG) {
-        lowAlarmThresholds[address - LOW_ALARM_DS18B20_START_REG] = static_cast<int16_t>(value);
-        return true;
-    }
-    if (address >= HIGH_ALARM_DS18B20_START_REG && address <= HIGH_ALARM_PT1000_END_REG) {
-        highAlarmThresholds[address - HIGH_ALARM_DS18B20_START_REG] = static_cast<int16_t>(value);
-        return true;
-    }
-    
-    // Alarm configuration
-    if (address >= ALARM_CONFIG_DS18B20_START_REG && address <= ALARM_CONFIG_PT1000_END_REG) {
-        alarmConfig[address - ALARM_CONFIG_DS18B20_START_REG] = value;
+    // Alarm thresholds and alarm configuration
+    uint8_t field;
+    uint16_t index;
+    if (decodePointRegister(address, field, index)) {
+        pointRegister(field, index) = value;
         return true;
     }
     
@@ -175,38 +194,54 @@ bool RegisterMap::writeHoldingRegister(uint16_t address, uint16_t value) {
 
 void RegisterMap::updateFromMeasurementPoint(const MeasurementPoint& point) {
     uint8_t idx = point.getAddress();
-    // DS18B20: 0-49, PT1000: 50-59
-    if (idx < 60) {
-        currentTemps[idx] = point.getCurrentTemp();
-        minTemps[idx] = point.getMinTemp();
-        maxTemps[idx] = point.getMaxTemp();
-        alarmStatus[idx] = point.getAlarmStatus();
-        errorStatus[idx] = point.getErrorStatus();
+    if (idx < pointCount) {
+        pointRegister(POINT_FIELD_CURRENT, idx) = point.getCurrentTemp();
+        pointRegister(POINT_FIELD_MIN, idx) = point.getMinTemp();
+        pointRegister(POINT_FIELD_MAX, idx) = point.getMaxTemp();
+        pointRegister(POINT_FIELD_ALARM_STATUS, idx) = point.getAlarmStatus();
+        pointRegister(POINT_FIELD_ERROR_STATUS, idx) = point.getErrorStatus();
         // Thresholds are updated by config methods, not here
     }
 }
 
+void RegisterMap::updateFromHotStore(const PointHotStore& hot, uint32_t since) {
+    uint16_t count = hot.size() < pointCount ? hot.size() : pointCount;
+    if (count == 0 || hot.getSequence() <= since) return;
+    uint16_t* current = &pointRegister(POINT_FIELD_CURRENT, 0);
+    uint16_t* minTemp = &pointRegister(POINT_FIELD_MIN, 0);
+    uint16_t* maxTemp = &pointRegister(POINT_FIELD_MAX, 0);
+    uint16_t* alarm = &pointRegister(POINT_FIELD_ALARM_STATUS, 0);
+    uint16_t* error = &pointRegister(POINT_FIELD_ERROR_STATUS, 0);
+    for (uint16_t i = 0; i < count; ++i) {
+        if (!hot.changedSince(i, since)) continue;
+        current[i] = hot.current[i];
+        minTemp[i] = hot.minTemp[i];
+        maxTemp[i] = hot.maxTemp[i];
+        alarm[i] = hot.alarmStatus(i);
+        error[i] = hot.errorBits[i];
+    }
+    pointSequence = (uint16_t)hot.getSequence();
+}
+
 void RegisterMap::applyConfigToMeasurementPoint(MeasurementPoint& point) {
     uint8_t idx = point.getAddress();
-    if (idx < 60) {
-        point.setLowAlarmThreshold(lowAlarmThresholds[idx]);
-        point.setHighAlarmThreshold(highAlarmThresholds[idx]);
-        //Serial.printf("applyConfigToMeasurementPoint(%d): LAS: %d, HAS: %d\n", idx, lowAlarmThresholds[idx], highAlarmThresholds[idx]);
+    if (idx < pointCount) {
+        point.setLowAlarmThreshold(static_cast<int16_t>(pointRegister(POINT_FIELD_LOW_ALARM, idx)));
+        point.setHighAlarmThreshold(static_cast<int16_t>(pointRegister(POINT_FIELD_HIGH_ALARM, idx)));
     }
 }
 
 void RegisterMap::applyConfigFromMeasurementPoint(const MeasurementPoint& point) {
     uint8_t idx = point.getAddress();
-    if (idx < 60) {
-        lowAlarmThresholds[idx] = point.getLowAlarmThreshold();
-        highAlarmThresholds[idx] = point.getHighAlarmThreshold();
-        //Serial.printf("applyConfigFromMeasurementPoint(%d): LAS: %d, HAS: %d\n", idx, lowAlarmThresholds[idx], highAlarmThresholds[idx]);
+    if (idx < pointCount) {
+        pointRegister(POINT_FIELD_LOW_ALARM, idx) = point.getLowAlarmThreshold();
+        pointRegister(POINT_FIELD_HIGH_ALARM, idx) = point.getHighAlarmThreshold();
     }
 }
 
 uint16_t RegisterMap::getAlarmConfig(uint8_t pointIndex) const {
-    if (pointIndex < 60) {
-        return alarmConfig[pointIndex];
+    if (pointIndex < pointCount) {
+        return pointRegister(POINT_FIELD_ALARM_CONFIG, pointIndex);
     }
     return 0;
 }
@@ -8,8 +8,7 @@
  * 
  * @section dependencies Dependencies
  * - Sensor.h for class definition
- * - OneWire and DallasTemperature for DS18B20
- * - Adafruit_MAX31865 for PT1000 RTD sensors
+ * - SensorBus.h backends for DS18B20 and PT1000 access
  * 
  * @section hardware Hardware Requirements
  * - DS18B20: OneWire digital sensors on GPIO pins
@@ -28,7 +27,16 @@ Sensor::Sensor(SensorType type, uint8_t address, const String& name)
       currentTemp(0), minTemp(32767), maxTemp(-32768),
       lowAlarmThreshold(-40), highAlarmThreshold(85),
       alarmStatus(0), errorStatus(0),
-      oneWire(nullptr), dallasTemperature(nullptr), max31865(nullptr)
+      resolution(DS18B20_DEFAULT_RESOLUTION),
+      ptContinuous(false), ptFilter50Hz(true),
+      ptNominal(RTD_PT1000_NOMINAL), ptRefResistor(PT1000_REF_RESISTOR),
+      ptScaleQ16(rtdScaleQ16(PT1000_REF_RESISTOR, RTD_PT1000_NOMINAL)),
+      ptOneShotStage(RtdOneShotStage::IDLE), ptOneShotStepAt(0),
+      alarmLimitsPending(type == SensorType::DS18B20),
+      searchSeen(false), missedSearches(0),
+      consecutiveFailures(0), quarantined(false), quarantineBackoffMs(0), nextProbeMs(0),
+      reportedErrors(0), linkErrorLogged(false), linkErrorReported(false), linkErrorLoggedAt(0),
+      oneWireBus(nullptr), rtd(nullptr)
 {
     if (type == SensorType::DS18B20) {
         connection.ds18b20.oneWirePin = 0;
@@ -40,22 +48,15 @@ Sensor::Sensor(SensorType type, uint8_t address, const String& name)
 }
 
 Sensor::~Sensor() {
-    if (oneWire != nullptr) {
-        delete oneWire;
-        oneWire = nullptr;
-    }
-    if (dallasTemperature != nullptr) {
-        delete dallasTemperature;
-        dallasTemperature = nullptr;
-    }
-    if (max31865 != nullptr) {
-        delete max31865;
-        max31865 = nullptr;
-    }
+    // oneWireBus is owned by TemperatureController
+    oneWireBus = nullptr;
+    delete rtd;
+    rtd = nullptr;
 }
 
-void Sensor::setupDS18B20(uint8_t pin, const uint8_t* deviceAddress) {
-    connection.ds18b20.oneWirePin = pin;
+void Sensor::setupDS18B20(OneWireInterface* bus, const uint8_t* deviceAddress) {
+    oneWireBus = bus;
+    connection.ds18b20.oneWirePin = bus ? bus->getPin() : 0;
     memcpy(connection.ds18b20.oneWireAddress, deviceAddress, 8);
 }
 
@@ -64,52 +65,24 @@ void Sensor::setupPT1000(uint8_t csPin, uint8_t maxAddress) {
     connection.pt1000.maxAddress = maxAddress;
 }
 
+void Sensor::setRtdFrontend(RtdInterface* frontend) {
+    if (frontend == rtd) return;
+    delete rtd;
+    rtd = frontend;
+}
+
 bool Sensor::initialize() {
     if (type == SensorType::DS18B20) {
-        oneWire = new OneWire(connection.ds18b20.oneWirePin);
-        dallasTemperature = new DallasTemperature(oneWire);
-        dallasTemperature->begin();
-        DeviceAddress deviceAddress;
-        memcpy(deviceAddress, connection.ds18b20.oneWireAddress, 8);
-        dallasTemperature->setResolution(deviceAddress, 12);
-        return dallasTemperature->isConnected(deviceAddress);
+        if (oneWireBus == nullptr) return false;
+        oneWireBus->lock();
+        oneWireBus->setResolution(connection.ds18b20.oneWireAddress, resolution);
+        bool connected = oneWireBus->isConnected(connection.ds18b20.oneWireAddress);
+        oneWireBus->unlock();
+        return connected;
     } else if (type == SensorType::PT1000) {
-        max31865 = new Adafruit_MAX31865(connection.pt1000.csPin);
-        
-        // Try to begin the MAX31865
-        bool beginSuccess = max31865->begin(MAX31865_3WIRE); // Adjust for your wiring
-        
-        // if (!beginSuccess) {
-        //     errorStatus |= ERROR_COMMUNICATION;
-        //     return false;
-        // }
-        
-        // // Check for faults immediately after initialization
-        // uint8_t fault = max31865->readFault();
-        // if (fault) {
-        //     max31865->clearFault();
-        //     errorStatus |= ERROR_COMMUNICATION;
-        //     return false;
-        // }
-        
-        // // Read RTD value to verify communication
-        // uint16_t rtd = max31865->readRTD();
-        // if (rtd == 0 || rtd == 0xFFFF) {  // Common values when module is not connected
-        //     errorStatus |= ERROR_COMMUNICATION;
-        //     // return false;
-        // }
-        
-        // // Calculate resistance to check if it's within reasonable range for PT1000
-        // float ratio = rtd / 32768.0;
-        // float resistance = 4300.0 * ratio;  // Using RREF of 4300 for PT1000
-        
-        // // PT1000 should be roughly 1000 ohms at 0°C, with reasonable range between 800-1400 ohms
-        // // for normal temperature measurements (-50°C to +100°C)
-        // if (resistance < 800.0 || resistance > 2200.0) {
-        //     errorStatus |= ERROR_DISCONNECTED;
-        //     // return false;
-        // }
-        
+        if (rtd == nullptr) rtd = createRtdFrontend(connection.pt1000.csPin);
+        rtd->begin();
+        rtd->configure(ptContinuous, ptFilter50Hz);
         return true;
     }
     return false;
@@ -121,40 +94,218 @@ bool Sensor::readTemperature() {
     errorStatus &= ~(ERROR_COMMUNICATION | ERROR_OUT_OF_RANGE | ERROR_DISCONNECTED);
 
     if (type == SensorType::DS18B20) {
-        if (dallasTemperature != nullptr) {
-            DeviceAddress deviceAddress;
-            memcpy(deviceAddress, connection.ds18b20.oneWireAddress, 8);
-            if (dallasTemperature->isConnected(deviceAddress)) {
-                dallasTemperature->requestTemperaturesByAddress(deviceAddress);
-                tempC = dallasTemperature->getTempC(deviceAddress);
-                if (tempC != DEVICE_DISCONNECTED_C) {
-                    success = true;
-                } else {
-                    errorStatus |= ERROR_DISCONNECTED;
-                }
-            } else {
-                errorStatus |= ERROR_COMMUNICATION;
-            }
+        if (oneWireBus != nullptr) {
+            oneWireBus->lock();
+            // Match-ROM Convert-T; the bus never waits, so hold it through the conversion
+            oneWireBus->convert(connection.ds18b20.oneWireAddress);
+            delay(ds18b20ConversionTimeMs(resolution));
+            success = readConvertedTemperature();
+            oneWireBus->unlock();
+            return success;
         }
-    } else if (type == SensorType::PT1000) {
-        if (max31865 != nullptr) {
-            uint8_t fault = max31865->readFault();
-            // if (fault) {
-            //     // if (fault & MAX31865_FAULT_HIGHTHRESH || fault & MAX31865_FAULT_LOWTHRESH) {
-            //     //     errorStatus |= ERROR_OUT_OF_RANGE;
-            //     // }
-                if (fault & (MAX31865_FAULT_REFINLOW | MAX31865_FAULT_REFINHIGH |
-                             MAX31865_FAULT_RTDINLOW | MAX31865_FAULT_OVUV)) {
-                    errorStatus |= ERROR_COMMUNICATION;
-                    max31865->clearFault();
-                
-                } else {
-                    tempC = max31865->temperature(1000.0, 4300.0); // PT1000: 1000 ohm at 0°C, adjust reference as needed
-                    success = true;
-                }
+    } else if (type == SensorType::PT1000 && rtd != nullptr) {
+        uint32_t readStart = micros();
+        uint16_t raw;
+        uint8_t fault;
+        if (ptContinuous) {
+            rtd->readLatest(raw, fault);
+            if (fault) rtd->clearFault();
+        } else {
+            rtd->readOneShot(raw, fault);
+            if (fault & RTD_FAULT_SERIOUS) rtd->clearFault();
+        }
+        return _applyRtdReading(raw, fault, readStart);
+    }
+
+    _applyReading(success, tempC);
+    return success;
+}
+
+bool Sensor::readConvertedTemperature() {
+    if (type != SensorType::DS18B20 || oneWireBus == nullptr) return false;
+
+    errorStatus &= ~(ERROR_COMMUNICATION | ERROR_OUT_OF_RANGE | ERROR_DISCONNECTED);
+
+    const uint8_t* deviceAddress = connection.ds18b20.oneWireAddress;
+    uint8_t scratchPad[DS18B20_SCRATCHPAD_SIZE];
+    bool success = false;
+
+    oneWireBus->lock();
+    uint32_t readStart = micros();
+    for (uint8_t attempt = 0; attempt <= DS18B20_CRC_RETRIES; ++attempt) {
+        if (attempt > 0) health.retries++;
+
+        // One Match-ROM + Read-Scratchpad; false means no presence pulse
+        if (!oneWireBus->readScratchPad(deviceAddress, scratchPad)) {
+            errorStatus |= ERROR_DISCONNECTED;
+            break;
+        }
+
+        // All-zero or all-one scratchpad: line stuck, nothing answered
+        bool allZero = true, allOne = true;
+        for (uint8_t i = 0; i < DS18B20_SCRATCHPAD_SIZE; ++i) {
+            if (scratchPad[i] != 0x00) allZero = false;
+            if (scratchPad[i] != 0xFF) allOne = false;
+        }
+        if (allZero || allOne) {
+            errorStatus |= ERROR_DISCONNECTED;
+            break;
         }
+
+        if (oneWireCrc8(scratchPad, 8) == scratchPad[DS18B20_SP_CRC]) {
+            success = true;
+            break;
+        }
+        health.crcErrors++;
     }
+    uint32_t readUs = micros() - readStart;
+    oneWireBus->unlock();
+    health.recordRead(readUs, success, errorStatus & ERROR_DISCONNECTED, millis());
 
+    float tempC = 0.0;
+    if (success) {
+        // Raw value is 1/16 °C; undefined low bits depend on configured resolution
+        int16_t raw = (int16_t)(((uint16_t)scratchPad[DS18B20_SP_TEMP_MSB] << 8) |
+                                scratchPad[DS18B20_SP_TEMP_LSB]);
+        uint8_t resolution = ((scratchPad[DS18B20_SP_CONFIG] >> 5) & 0x03) + 9;
+        raw &= ~((1 << (12 - resolution)) - 1);
+        tempC = raw / 16.0f;
+    } else if (!(errorStatus & ERROR_DISCONNECTED)) {
+        errorStatus |= ERROR_COMMUNICATION;
+    }
+
+    _applyReading(success, tempC);
+    return success;
+}
+
+bool Sensor::startConversion() {
+    if (type != SensorType::DS18B20 || oneWireBus == nullptr) return false;
+    oneWireBus->lock();
+    bool sent = oneWireBus->convert(connection.ds18b20.oneWireAddress);
+    oneWireBus->unlock();
+    return sent;
+}
+
+bool Sensor::beginRtdOneShot(unsigned long now) {
+    if (type != SensorType::PT1000 || rtd == nullptr || ptContinuous) return false;
+    rtd->setBias(true);
+    ptOneShotStage = RtdOneShotStage::BIASING;
+    ptOneShotStepAt = now + RTD_BIAS_SETTLE_MS;
+    return true;
+}
+
+bool Sensor::startRtdOneShot(unsigned long now) {
+    if (ptOneShotStage != RtdOneShotStage::BIASING || (long)(now - ptOneShotStepAt) < 0) return false;
+    rtd->startOneShot();
+    ptOneShotStage = RtdOneShotStage::CONVERTING;
+    ptOneShotStepAt = now + RTD_ONESHOT_CONVERSION_MS;
+    return true;
+}
+
+RtdCollectResult Sensor::collectRtdOneShot(unsigned long now) {
+    if (type != SensorType::PT1000 || rtd == nullptr) return RtdCollectResult::FAILED;
+    if (ptContinuous)
+        return readTemperature() ? RtdCollectResult::READ : RtdCollectResult::FAILED;
+
+    // Collected early: advance at most one step and let the caller retry
+    if (ptOneShotStage == RtdOneShotStage::IDLE) {
+        beginRtdOneShot(now);
+        return RtdCollectResult::PENDING;
+    }
+    if ((long)(now - ptOneShotStepAt) < 0) return RtdCollectResult::PENDING;
+    if (ptOneShotStage == RtdOneShotStage::BIASING) {
+        startRtdOneShot(now);
+        return RtdCollectResult::PENDING;
+    }
+
+    errorStatus &= ~(ERROR_COMMUNICATION | ERROR_OUT_OF_RANGE | ERROR_DISCONNECTED);
+    uint32_t readStart = micros();
+    uint16_t raw;
+    uint8_t fault;
+    rtd->readLatest(raw, fault);
+    if (fault) rtd->clearFault();
+    rtd->setBias(false);
+    ptOneShotStage = RtdOneShotStage::IDLE;
+    return _applyRtdReading(raw, fault, readStart) ? RtdCollectResult::READ
+                                                   : RtdCollectResult::FAILED;
+}
+
+bool Sensor::_applyRtdReading(uint16_t raw, uint8_t fault, uint32_t readStart) {
+    float tempC = 0.0f;
+    bool success = false;
+    // Threshold faults only flag the configured limits; the reading stays valid
+    if (fault & RTD_FAULT_SERIOUS) {
+        errorStatus |= ERROR_COMMUNICATION;
+    } else {
+        tempC = rtdRawToMilliC(raw, ptScaleQ16) / 1000.0f;
+        success = true;
+    }
+    // SPI has no presence detect: MAX31865 faults count as failures, not timeouts
+    health.recordRead(micros() - readStart, success, false, millis());
+    _applyReading(success, tempC);
+    return success;
+}
+
+bool Sensor::setResolution(uint8_t bits) {
+    if (type != SensorType::DS18B20) return false;
+    bits = constrain(bits, DS18B20_MIN_RESOLUTION, DS18B20_MAX_RESOLUTION);
+    resolution = bits;
+    if (oneWireBus == nullptr) return true;
+
+    oneWireBus->lock();
+    bool ok = oneWireBus->setResolution(connection.ds18b20.oneWireAddress, bits);
+    oneWireBus->unlock();
+    return ok;
+}
+
+bool Sensor::writeAlarmLimits() {
+    if (type != SensorType::DS18B20 || oneWireBus == nullptr) return false;
+
+    int8_t th = (int8_t)constrain(highAlarmThreshold, -55, 125);
+    int8_t tl = (int8_t)constrain(lowAlarmThreshold, -55, 125);
+
+    const uint8_t* deviceAddress = connection.ds18b20.oneWireAddress;
+    uint8_t scratchPad[DS18B20_SCRATCHPAD_SIZE];
+    bool ok = false;
+
+    oneWireBus->lock();
+    if (oneWireBus->readScratchPad(deviceAddress, scratchPad) &&
+        oneWireCrc8(scratchPad, 8) == scratchPad[DS18B20_SP_CRC]) {
+        if ((int8_t)scratchPad[DS18B20_SP_TH] != th || (int8_t)scratchPad[DS18B20_SP_TL] != tl) {
+            // Also copies to EEPROM so the limits survive a power cycle
+            scratchPad[DS18B20_SP_TH] = (uint8_t)th;
+            scratchPad[DS18B20_SP_TL] = (uint8_t)tl;
+            oneWireBus->writeScratchPad(deviceAddress, scratchPad);
+        }
+        ok = true;
+    }
+    oneWireBus->unlock();
+
+    if (ok) alarmLimitsPending = false;
+    return ok;
+}
+
+bool Sensor::setPT1000ContinuousMode(bool enabled, bool filter50Hz) {
+    if (type != SensorType::PT1000) return false;
+    if (enabled == ptContinuous && filter50Hz == ptFilter50Hz) return true;
+    ptContinuous = enabled;
+    ptFilter50Hz = filter50Hz;
+    ptOneShotStage = RtdOneShotStage::IDLE;   // configure() rewrites the bias bit
+    if (rtd != nullptr) rtd->configure(ptContinuous, ptFilter50Hz);
+    return true;
+}
+
+bool Sensor::setRtdCalibration(float nominal, float refResistor) {
+    if (type != SensorType::PT1000) return false;
+    // RREF below R0 cannot reach 0 °C; above RTD_MAX_REF_RATIO the Q16 ratio overflows
+    if (nominal <= 0.0f || refResistor < nominal || refResistor > nominal * RTD_MAX_REF_RATIO) return false;
+    ptNominal = nominal;
+    ptRefResistor = refResistor;
+    ptScaleQ16 = rtdScaleQ16(refResistor, nominal);
+    return true;
+}
+
+void Sensor::_applyReading(bool success, float tempC) {
     if (success) {
         if (tempC < -40.0 || tempC > 200.0) {
             errorStatus |= ERROR_OUT_OF_RANGE;
@@ -164,8 +315,37 @@ bool Sensor::readTemperature() {
             if (currentTemp > maxTemp) maxTemp = currentTemp;
         }
     }
+    _updateQuarantine(success && !(errorStatus & (ERROR_COMMUNICATION | ERROR_DISCONNECTED)));
     updateAlarmStatus();
-    return success;
+    scheduler.onSample(millis(), currentTemp, lowAlarmThreshold, highAlarmThreshold, errorStatus != 0);
+}
+
+void Sensor::_updateQuarantine(bool healthy) {
+    if (healthy) {
+        consecutiveFailures = 0;
+        quarantined = false;
+        errorStatus &= ~ERROR_QUARANTINED;
+        return;
+    }
+
+    if (consecutiveFailures < 255) consecutiveFailures++;
+    if (quarantined) {
+        quarantineBackoffMs = quarantineBackoffMs >= QUARANTINE_MAX_BACKOFF_MS / 2 ?
+            QUARANTINE_MAX_BACKOFF_MS : quarantineBackoffMs * 2;
+    } else if (consecutiveFailures >= QUARANTINE_FAILURE_THRESHOLD) {
+        quarantined = true;
+        health.quarantines++;
+        quarantineBackoffMs = QUARANTINE_INITIAL_BACKOFF_MS;
+        errorStatus |= ERROR_QUARANTINED;
+    } else {
+        return;
+    }
+    nextProbeMs = millis() + quarantineBackoffMs;
+}
+
+void Sensor::requestSample() {
+    scheduler.reset();
+    if (quarantined) nextProbeMs = millis();
 }
 
 SensorType Sensor::getType() const { return type; }
@@ -182,8 +362,17 @@ uint8_t Sensor::getAlarmStatus() const { return alarmStatus; }
 uint8_t Sensor::getErrorStatus() const { return errorStatus; }
 
 void Sensor::setAddress(uint8_t newAddress) { address = newAddress; }
-void Sensor::setLowAlarmThreshold(int16_t threshold) { lowAlarmThreshold = threshold; updateAlarmStatus(); }
-void Sensor::setHighAlarmThreshold(int16_t threshold) { highAlarmThreshold = threshold; updateAlarmStatus(); }
+void Sensor::setLowAlarmThreshold(int16_t threshold) {
+    if (threshold != lowAlarmThreshold && type == SensorType::DS18B20) alarmLimitsPending = true;
+    lowAlarmThreshold = threshold;
+    updateAlarmStatus();
+}
+
+void Sensor::setHighAlarmThreshold(int16_t threshold) {
+    if (threshold != highAlarmThreshold && type == SensorType::DS18B20) alarmLimitsPending = true;
+    highAlarmThreshold = threshold;
+    updateAlarmStatus();
+}
 
 const uint8_t* Sensor::getDS18B20Address() const {
     if (type == SensorType::DS18B20) {
@@ -198,10 +387,8 @@ void Sensor::resetMinMaxTemp() {
 }
 
 void Sensor::updateAlarmStatus() {
-    alarmStatus = 0;
-    if (errorStatus != 0) return;
-    if (currentTemp < lowAlarmThreshold) alarmStatus |= ALARM_LOW_TEMP;
-    if (currentTemp > highAlarmThreshold) alarmStatus |= ALARM_HIGH_TEMP;
+    // Same rule as the point kernel; ALARM_*_TEMP equal THRESHOLD_BIT_*
+    alarmStatus = thresholdBits(currentTemp, lowAlarmThreshold, highAlarmThreshold, errorStatus);
 }
 
 
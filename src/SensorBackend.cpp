@@ -0,0 +1,42 @@
+/**
+ * @file SensorBackend.cpp
+ * @brief Backend selection for OneWire buses and MAX31865 front ends
+ * @author barabashsr
+ * @date 2026-10-16
+ * @details Hardware drivers by default. Build with -DSENSOR_BUS_SIMULATED to run
+ *          the firmware against SimulatedOneWireBus / SimulatedRtd, e.g. to
+ *          exercise the web UI and Modbus map on a bare board.
+ *
+ * @section dependencies Dependencies
+ * - SensorBus.h for the factory declarations
+ * - OneWireBus.h and Max31865Rtd.h, or SimulatedSensorBus.h
+ */
+
+#include "SensorBus.h"
+
+#ifdef SENSOR_BUS_SIMULATED
+#include "SimulatedSensorBus.h"
+
+OneWireInterface* createOneWireBus(uint8_t pin) {
+    SimulationProfile profile;
+    return new SimulatedOneWireBus(pin, profile);
+}
+
+RtdInterface* createRtdFrontend(uint8_t csPin) {
+    SimulationProfile profile;
+    return new SimulatedRtd(csPin, profile);
+}
+
+#else
+#include "OneWireBus.h"
+#include "Max31865Rtd.h"
+
+OneWireInterface* createOneWireBus(uint8_t pin) {
+    return new OneWireBus(pin);
+}
+
+RtdInterface* createRtdFrontend(uint8_t csPin) {
+    return new Max31865Rtd(csPin);
+}
+
+#endif
@@ -0,0 +1,236 @@
+/**
+ * @file SimulatedSensorBus.cpp
+ * @brief Implementation of the simulated OneWire and MAX31865 backends
+ * @author barabashsr
+ * @date 2026-10-16
+ *
+ * @section dependencies Dependencies
+ * - SimulatedSensorBus.h for class definitions
+ */
+
+#include "SimulatedSensorBus.h"
+#include <string.h>
+#include <math.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+static uint32_t (*simulationClock)() = nullptr;
+
+uint32_t simulationMillis() {
+    if (simulationClock) return simulationClock();
+#ifdef ARDUINO
+    return millis();
+#else
+    using namespace std::chrono;
+    static const steady_clock::time_point origin = steady_clock::now();
+    return (uint32_t)duration_cast<milliseconds>(steady_clock::now() - origin).count();
+#endif
+}
+
+void setSimulationClock(uint32_t (*clock)()) {
+    simulationClock = clock;
+}
+
+/**
+ * @brief Spin for the configured read latency
+ * @param[in] us Busy time in microseconds
+ */
+static void simulationBusy(uint32_t us) {
+    if (us == 0) return;
+#ifdef ARDUINO
+    delayMicroseconds(us);
+#else
+    using namespace std::chrono;
+    const steady_clock::time_point end = steady_clock::now() + microseconds(us);
+    while (steady_clock::now() < end) {
+    }
+#endif
+}
+
+/**
+ * @brief Temperature of a device at a point in time
+ * @param[in] profile Shared behaviour
+ * @param[in] random Noise source
+ * @param[in] offsetC Device offset
+ * @param[in] elapsedMs Time since the backend was created
+ * @return float Temperature in °C
+ */
+static float simulatedTemperature(const SimulationProfile& profile, SimulationRandom& random,
+                                  float offsetC, uint32_t elapsedMs) {
+    return profile.baseTempC + offsetC + profile.driftCPerMin * (elapsedMs / 60000.0f) +
+           profile.noiseC * random.symmetric();
+}
+
+// ---------------------------------------------------------------------------
+// SimulatedOneWireBus
+// ---------------------------------------------------------------------------
+
+SimulatedOneWireBus::SimulatedOneWireBus(uint8_t pin, const SimulationProfile& profile)
+    : _pin(pin), _profile(profile), _random(profile.seed ^ ((uint32_t)pin * 0x9E3779B9u)),
+      _searchIndex(0), _startMs(simulationMillis())
+{
+    _devices.resize(profile.devicesPerBus);
+    for (Device& device : _devices) {
+        device.rom[0] = 0x28; // DS18B20 family
+        for (uint8_t i = 1; i < 7; ++i) device.rom[i] = (uint8_t)_random.next();
+        device.rom[7] = oneWireCrc8(device.rom, 7);
+        device.offsetC = profile.spreadC * 0.5f * _random.symmetric();
+        device.present = true;
+        device.resolution = 12;
+        device.th = 127;
+        device.tl = -128;
+        device.rawTemp = 85 * 16; // Power-on reset value
+        device.pendingRaw = device.rawTemp;
+        device.converting = false;
+        device.convertStartMs = 0;
+    }
+}
+
+bool SimulatedOneWireBus::convertAll() {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    uint32_t now = simulationMillis();
+    for (Device& device : _devices) {
+        if (device.present) _startConversion(device, now);
+    }
+    return true;
+}
+
+bool SimulatedOneWireBus::convert(const uint8_t* rom) {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    Device* device = _find(rom);
+    if (device == nullptr || !device->present) return false;
+    _startConversion(*device, simulationMillis());
+    return true;
+}
+
+bool SimulatedOneWireBus::readScratchPad(const uint8_t* rom, uint8_t* scratchPad) {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    _busy();
+    Device* device = _find(rom);
+    if (device == nullptr || !device->present || _random.chance(_profile.dropoutPerMille)) {
+        memset(scratchPad, 0xFF, DS18B20_SCRATCHPAD_SIZE); // Bus pulled high, no presence
+        return false;
+    }
+    _settle(*device, simulationMillis());
+
+    scratchPad[DS18B20_SP_TEMP_LSB] = (uint8_t)(device->rawTemp & 0xFF);
+    scratchPad[DS18B20_SP_TEMP_MSB] = (uint8_t)((uint16_t)device->rawTemp >> 8);
+    scratchPad[DS18B20_SP_TH] = (uint8_t)device->th;
+    scratchPad[DS18B20_SP_TL] = (uint8_t)device->tl;
+    scratchPad[DS18B20_SP_CONFIG] = (uint8_t)(((device->resolution - 9) << 5) | 0x1F);
+    scratchPad[5] = 0xFF;
+    scratchPad[6] = 0x0C;
+    scratchPad[7] = 0x10;
+    scratchPad[DS18B20_SP_CRC] = oneWireCrc8(scratchPad, 8);
+
+    if (_random.chance(_profile.crcErrorPerMille)) {
+        scratchPad[_random.next() % 8] ^= (uint8_t)(1u << (_random.next() % 8));
+    }
+    return true;
+}
+
+bool SimulatedOneWireBus::writeScratchPad(const uint8_t* rom, const uint8_t* scratchPad) {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    Device* device = _find(rom);
+    if (device == nullptr || !device->present) return false;
+    device->th = (int8_t)scratchPad[DS18B20_SP_TH];
+    device->tl = (int8_t)scratchPad[DS18B20_SP_TL];
+    device->resolution = (uint8_t)(((scratchPad[DS18B20_SP_CONFIG] >> 5) & 0x03) + 9);
+    return true;
+}
+
+bool SimulatedOneWireBus::setResolution(const uint8_t* rom, uint8_t bits) {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    Device* device = _find(rom);
+    if (device == nullptr || !device->present || bits < 9 || bits > 12) return false;
+    device->resolution = bits;
+    return true;
+}
+
+bool SimulatedOneWireBus::isConnected(const uint8_t* rom) {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    uint8_t scratchPad[DS18B20_SCRATCHPAD_SIZE];
+    return readScratchPad(rom, scratchPad) &&
+           oneWireCrc8(scratchPad, 8) == scratchPad[DS18B20_SP_CRC];
+}
+
+bool SimulatedOneWireBus::search(uint8_t* rom, bool alarmOnly) {
+    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    uint32_t now = simulationMillis();
+    while (_searchIndex < _devices.size()) {
+        Device& device = _devices[_searchIndex++];
+        if (!device.present) continue;
+        if (alarmOnly) {
+            _settle(device, now);
+            // Alarm flag: last conversion >= TH or <= TL (whole degrees)
+            int16_t whole = device.rawTemp / 16;
+            if (whole < device.th && whole > device.tl) continue;
+        }
+        memcpy(rom, device.rom, 8);
+        return true;
+    }
+    return false;
+}
+
+SimulatedOneWireBus::Device* SimulatedOneWireBus::_find(const uint8_t* rom) {
+    for (Device& device : _devices) {
+        if (memcmp(device.rom, rom, 8) == 0) return &device;
+    }
+    return nullptr;
+}
+
+void SimulatedOneWireBus::_startConversion(Device& device, uint32_t now) {
+    float tempC = simulatedTemperature(_profile, _random, device.offsetC, now - _startMs);
+    int32_t raw = (int32_t)lroundf(tempC * 16.0f);
+    if (raw > 125 * 16) raw = 125 * 16;
+    if (raw < -55 * 16) raw = -55 * 16;
+    // Lower resolutions leave the low bits undefined; the model clears them
+    raw &= ~((1 << (12 - device.resolution)) - 1);
+    device.pendingRaw = (int16_t)raw;
+    device.converting = true;
+    device.convertStartMs = now;
+}
+
+void SimulatedOneWireBus::_settle(Device& device, uint32_t now) {
+    if (device.converting && now - device.convertStartMs >= ds18b20ConversionTimeMs(device.resolution)) {
+        device.rawTemp = device.pendingRaw;
+        device.converting = false;
+    }
+}
+
+void SimulatedOneWireBus::_busy() const {
+    simulationBusy(_profile.readLatencyUs);
+}
+
+// ---------------------------------------------------------------------------
+// SimulatedRtd
+// ---------------------------------------------------------------------------
+
+SimulatedRtd::SimulatedRtd(uint8_t csPin, const SimulationProfile& profile,
+                           double nominal, double refResistor)
+    : _csPin(csPin), _profile(profile), _random(profile.seed ^ ((uint32_t)csPin * 0x85EBCA6Bu)),
+      _nominal(nominal), _refResistor(refResistor), _offsetC(0.0f), _continuous(false),
+      _startMs(simulationMillis())
+{
+    _offsetC = profile.spreadC * 0.5f * _random.symmetric();
+}
+
+void SimulatedRtd::_read(uint16_t& raw, uint8_t& fault) {
+    simulationBusy(_profile.readLatencyUs);
+    if (_random.chance(_profile.dropoutPerMille)) {
+        // Open RTD: input floats to full scale and RTDIN- trips
+        fault = RTD_FAULT_HIGHTHRESH | RTD_FAULT_RTDINLOW;
+        raw = _continuous ? 0x7FFF : 0;
+        return;
+    }
+    float tempC = simulatedTemperature(_profile, _random, _offsetC, simulationMillis() - _startMs);
+    double code = rtdCvdRatio(tempC) * _nominal / _refResistor * 32768.0;
+    if (code < 0.0) code = 0.0;
+    if (code > 32767.0) code = 32767.0;
+    raw = (uint16_t)lround(code);
+    fault = 0;
+}
@@ -442,7 +442,7 @@ void TempModbusServer::processCommands() {
                 // This requires access to TemperatureController instance
                 
                 // For now, log what would be done
-                for (uint8_t i = 0; i < 60; i++) {
+                for (uint16_t i = 0; i < registerMap.getPointCount(); i++) {
                     uint16_t config = registerMap.getAlarmConfig(i);
                     if (config != 0) {
                         bool lowEnabled = (config & RegisterMap::ALARM_CONFIG_LOW_ENABLE_BIT) != 0;
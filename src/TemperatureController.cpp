@@ -11,6 +11,7 @@
  * - DallasTemperature for DS18B20 sensor interface
  * - ArduinoJson for JSON serialization
  * - Custom sensor and alarm implementations
+ * - Trace.h for alarm pass tracing
  * 
  * @section hardware Hardware Support
  * - 4 OneWire buses supporting up to 50 DS18B20 sensors
@@ -22,7 +23,10 @@
 #include "TemperatureController.h"
 #include <WiFi.h>
 #include <algorithm>
+#include <array>
 #include "ConfigManager.h"
+#include "ExternalMemory.h"
+#include "Trace.h"
 
 TemperatureController::TemperatureController(uint8_t oneWirePin[4], uint8_t csPin[4], IndicatorInterface& indicator)
 : indicator(indicator), 
@@ -31,7 +35,39 @@ deviceId(1),
 firmwareVersion(0x0100),
 lastMeasurementTime(0), 
 systemInitialized(false), 
-_lastAlarmCheck(0),
+acquisitionMode(AcquisitionMode::BUS_SWEEP),
+_acqPhase(AcquisitionPhase::IDLE),
+_acqDeadline(0),
+_activeGroup(-1),
+_slowestGroup(0),
+_rtdStartPending(false),
+_rtdStartAt(0),
+_acqSliceBudgetUs(2000),
+_appliedSamples(nullptr),
+_appliedSnapshotSequence(0),
+_registerMapSequence(0),
+_acqTask(nullptr),
+_ptContinuous(false),
+_ptFilter50Hz(true),
+_rtdNominal(RTD_PT1000_NOMINAL),
+_adaptiveSampling(true),
+_sampleAll(false),
+_sampleAllRequested(false),
+_alarmScreening(false),
+_lastAlarmScreen(0),
+_alarmScreenHits(0),
+_discoveryEnabled(true),
+_discoveryActive(false),
+_discoveryBus(0),
+_discoveryBusStarted(false),
+_discoveryNextPass(0),
+_discoveryPasses(0),
+_failedRomCount(0),
+_failedRomNext(0),
+_alarmSequence(0),
+_alarmWakeAt(0),
+_alarmTimerArmed(false),
+_alarmEventsDropReported(0),
 _lastButtonState(false), 
 _lastButtonPressTime(0), 
 _currentDisplayedAlarm(nullptr),
@@ -55,23 +91,30 @@ _buttonPressStartTime(0),
 _systemStatusModeStartTime(0),
 _buttonPressHandled(false)
 {
-    // Initialize measurement points
-    for (uint8_t i = 0; i < 50; ++i)
-        dsPoints[i] = MeasurementPoint(i, "DS18B20_Point_" + String(i));
-    for (uint8_t i = 0; i < 10; ++i)
-        ptPoints[i] = MeasurementPoint(50 + i, "PT1000_Point_" + String(i));
+    // Default point layout; ConfigManager may resize it before points are loaded
+    allocatePoints(DEFAULT_DS18B20_POINTS, DEFAULT_PT1000_POINTS);
+    // Sequences restart at boot and could pass a client's stale value unnoticed
+    _pointEpoch = esp_random();
     
     // Initialize bus pins
     for (uint8_t i = 0; i < 4; i++) {
         oneWireBusPin[i] = oneWirePin[i];
         chipSelectPin[i] = csPin[i];
+        _ptRefResistor[i] = PT1000_REF_RESISTOR;
     }
     
     // Initialize OneWire buses
     for (int i = 0; i < 4; ++i) {
-        oneWireBuses[i] = new OneWire(oneWireBusPin[i]);
-        dallasSensors[i] = new DallasTemperature(oneWireBuses[i]);
+        oneWireBuses[i] = createOneWireBus(oneWireBusPin[i]);
+        _busReadStarted[i] = false;
+        _busParasite[i] = false;
+        _busReadGroup[i] = -1;
     }
+
+    for (uint8_t i = 0; i < SENSOR_CS_INDEX_SIZE; ++i)
+        _csIndex[i] = nullptr;
+
+    _sensorsMutex = xSemaphoreCreateRecursiveMutex();
 }
 
 TemperatureController::~TemperatureController() {
@@ -79,12 +122,15 @@ TemperatureController::~TemperatureController() {
     for (auto sensor : sensors)
         delete sensor;
     sensors.clear();
+    _sweepSensors.clear();
+    _romIndex.clear();
+    for (int i = 0; i < 4; ++i)
+        _busSensors[i].clear();
     
  
     
     // Clean up OneWire buses
     for (int i = 0; i < 4; ++i) {
-        delete dallasSensors[i];
         delete oneWireBuses[i];
     }
 
@@ -92,6 +138,9 @@ TemperatureController::~TemperatureController() {
     for (auto alarm : _configuredAlarms)
         delete alarm;
     _configuredAlarms.clear();
+    _alarmSlots.clear();
+
+    externalFree(_appliedSamples);
 }
 
 /**
@@ -174,14 +223,27 @@ bool TemperatureController::begin() {
 }
 
 void TemperatureController::update() {
-    updateAllSensors();
-    readAllPoints();
+    // Without the acquisition task, run the engine from the loop
+    if (_acqTask == nullptr) {
+        if (acquisitionMode == AcquisitionMode::BUS_SWEEP) {
+            // Cooperative acquisition: one bounded slice per call
+            _stepAcquisition();
+        } else {
+            updateAllSensors();
+        }
+    }
+    if (readAllPoints()) {
+        _logSensorErrors();
+        _updateHealthRegisters();
+    }
+    _processDiscoveryEvents();
     
     // Handle PCF8575 interrupts
     indicator.handleInterrupt();
     
     // Update alarm system
     updateAlarms();
+    _processAlarmEvents();
     
     // Handle button presses
     _checkButtonPress();
@@ -207,99 +269,150 @@ void TemperatureController::update() {
 
 // Alarm Management Methods
 void TemperatureController::updateAlarms() {
+    // Event driven: run when a point changed (values, thresholds, alarm
+    // configuration, acknowledgment) or an alarm timer expired
+    const PointHotStore& hot = _points.hot();
+    const uint32_t sequence = hot.getSequence();
     unsigned long currentTime = millis();
-    if (currentTime - _lastAlarmCheck < _alarmCheckInterval) {
-        return;
-    }
-    _lastAlarmCheck = currentTime;
-    
-    Serial.println("=== Checking alarms with fresh sensor data ===");
-    
-    // Check all measurement points for NEW alarm conditions
-    for (uint8_t i = 0; i < 50; ++i) {
-        if (dsPoints[i].getBoundSensor() != nullptr) {
-            Serial.printf("DS Point %d: Temp=%d, High=%d, Low=%d\n",
-                         i, dsPoints[i].getCurrentTemp(),
-                         dsPoints[i].getHighAlarmThreshold(),
-                         dsPoints[i].getLowAlarmThreshold());
-            //_checkPointForAlarms(&dsPoints[i]);
+    bool timerDue = _alarmTimerArmed && (long)(currentTime - _alarmWakeAt) >= 0;
+    if (sequence == _alarmSequence && !timerDue) return;
+
+    const uint32_t since = _alarmSequence;
+    _alarmSequence = sequence;
+
+    if (TRACE_ENABLED(TRACE_LEVEL_DEBUG, TRACE_ALARM_PASS)) {
+        TRACE_D(TRACE_ALARM_PASS, "=== Checking alarms with fresh sensor data ===\n");
+        for (const MeasurementPoint& point : _points) {
+            if (hot.changedSince(point.getAddress(), since) && point.getBoundSensor() != nullptr) {
+                TRACE_D(TRACE_ALARM_PASS, "%s Point %d: Temp=%d, High=%d, Low=%d\n",
+                        isPT1000Address(point.getAddress()) ? "PT" : "DS",
+                        point.getAddress(), point.getCurrentTemp(),
+                        point.getHighAlarmThreshold(),
+                        point.getLowAlarmThreshold());
+            }
         }
+        TRACE_D(TRACE_ALARM_PASS, "=== Updating existing alarms ===\n");
     }
     
-    for (uint8_t i = 0; i < 10; ++i) {
-        if (ptPoints[i].getBoundSensor() != nullptr) {
-            Serial.printf("PT Point %d: Temp=%d, High=%d, Low=%d\n",
-                         i, ptPoints[i].getCurrentTemp(),
-                         ptPoints[i].getHighAlarmThreshold(),
-                         ptPoints[i].getLowAlarmThreshold());
-            //_checkPointForAlarms(&ptPoints[i]);
+    // Fault alarms first so temperature alarms see this pass's sensor fault state
+    static const AlarmType evaluationOrder[ALARM_TYPE_COUNT] = {
+        AlarmType::SENSOR_ERROR, AlarmType::SENSOR_DISCONNECTED,
+        AlarmType::HIGH_TEMPERATURE, AlarmType::LOW_TEMPERATURE
+    };
+
+    // Alarms of changed points, through the slot table
+    if (sequence != since) {
+        for (uint16_t address = 0; address < _points.size(); ++address) {
+            if (!hot.changedSince(address, since)) continue;
+            for (AlarmType type : evaluationOrder)
+                _updateAlarm(_alarmSlots.get(address, type), currentTime, true);
+        }
+    }
+
+    // Deadlines: settling NEW/CLEARED alarms and acknowledgment delays.
+    // Alarms of points changed above were already updated in this pass.
+    if (timerDue) {
+        for (size_t i = 0; i < _alarmsSettling.size(); ++i) {
+            uint16_t address = _alarmsSettling[i] / ALARM_TYPE_COUNT;
+            AlarmType type = static_cast<AlarmType>(_alarmsSettling[i] % ALARM_TYPE_COUNT);
+            if (address >= _points.size() || hot.changedSince(address, since)) continue;
+            _updateAlarm(_alarmSlots.get(address, type), currentTime, false);
+            if (type == AlarmType::SENSOR_ERROR || type == AlarmType::SENSOR_DISCONNECTED) {
+                // A fault that just became active holds the temperature alarms resolved
+                _updateAlarm(_alarmSlots.get(address, AlarmType::HIGH_TEMPERATURE), currentTime, false);
+                _updateAlarm(_alarmSlots.get(address, AlarmType::LOW_TEMPERATURE), currentTime, false);
+            }
         }
-    }
-    
-    // Update existing configured alarms (do NOT remove resolved alarms)
-    Serial.println("=== Updating existing alarms ===");
-    
-    // First, check for active sensor errors
-    std::vector<MeasurementPoint*> pointsWithSensorError;
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->isEnabled() && 
-            (alarm->getType() == AlarmType::SENSOR_ERROR || alarm->getType() == AlarmType::SENSOR_DISCONNECTED) &&
-            alarm->isActive()) {
-            pointsWithSensorError.push_back(alarm->getSource());
+        for (Alarm* alarm = _alarmQueues.first(ALARM_QUEUE_ACKNOWLEDGED); alarm != nullptr;) {
+            Alarm* next = _alarmQueues.next(alarm);   // the update may move it to ACTIVE
+            uint8_t address = alarm->getPointAddress();
+            if (address >= _points.size() || !hot.changedSince(address, since))
+                _updateAlarm(alarm, currentTime, false);
+            alarm = next;
         }
     }
-    
-    // Update all alarms
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->isEnabled()) {
-            // Check if this is a temperature alarm for a point with sensor error
-            if ((alarm->getType() == AlarmType::HIGH_TEMPERATURE || alarm->getType() == AlarmType::LOW_TEMPERATURE) &&
-                std::find(pointsWithSensorError.begin(), pointsWithSensorError.end(), alarm->getSource()) != pointsWithSensorError.end()) {
-                // Force temperature alarms to resolved state when sensor error is active
-                if (!alarm->isResolved()) {
-                    alarm->resolve();
-                    Serial.printf("Forced %s alarm to RESOLVED for point %d due to sensor error\n",
-                                 alarm->getTypeString().c_str(),
-                                 alarm->getSource() ? alarm->getSource()->getAddress() : -1);
-                }
-            } else {
-                // Normal alarm update
-                alarm->updateCondition();
+    _armAlarmTimer();
+
+    if (TRACE_ENABLED(TRACE_LEVEL_DEBUG, TRACE_ALARM_PASS)) {
+        TRACE_D(TRACE_ALARM_PASS, "Active alarms count: %d\n", 
+                _alarmQueues.size(ALARM_QUEUE_ACTIVE) + _alarmQueues.size(ALARM_QUEUE_ACKNOWLEDGED));
+        for (auto alarm : _configuredAlarms) {
+            if (alarm->isEnabled()) {
+                TRACE_D(TRACE_ALARM_PASS, "  Alarm: %s, Stage: %s, Point: %d\n",
+                        alarm->getTypeName(), alarm->getStageName(),
+                        alarm->getSource() ? alarm->getSource()->getAddress() : -1);
             }
         }
     }
-    
-    // Sort alarms by priority
-    std::sort(_configuredAlarms.begin(), _configuredAlarms.end(), AlarmComparator());
-    
-    Serial.printf("Active alarms count: %d\n", getActiveAlarms().size());
-    
-    // Debug: Print all current alarms
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->isEnabled()) {
-            Serial.printf("  Alarm: %s, Stage: %s, Point: %d\n",
-                         alarm->getTypeString().c_str(),
-                         alarm->getStageString().c_str(),
-                         alarm->getSource() ? alarm->getSource()->getAddress() : -1);
+}
+
+
+
+
+void TemperatureController::_updateAlarm(Alarm* alarm, unsigned long now, bool pointChanged) {
+    if (alarm == nullptr || !alarm->isEnabled()) return;
+    unsigned long dueAt = 0;
+    if ((alarm->getType() == AlarmType::HIGH_TEMPERATURE || alarm->getType() == AlarmType::LOW_TEMPERATURE) &&
+        _hasSensorFault(alarm->getPointAddress())) {
+        // Force temperature alarms to resolved state when sensor error is active
+        if (!alarm->isResolved()) {
+            alarm->resolve();
+            TRACE_I(TRACE_ALARM, "Forced %s alarm to RESOLVED for point %d due to sensor error\n",
+                    alarm->getTypeName(), alarm->getPointAddress());
         }
+    } else if (pointChanged ||
+               (alarm->getPendingDeadline(dueAt) && (long)(now - dueAt) >= 0)) {
+        alarm->updateCondition();
+    }
+
+    AlarmStage stage = alarm->getStage();
+    if (stage == AlarmStage::NEW || stage == AlarmStage::CLEARED) {
+        uint16_t key = (uint16_t)alarm->getPointAddress() * ALARM_TYPE_COUNT + static_cast<uint8_t>(alarm->getType());
+        if (std::find(_alarmsSettling.begin(), _alarmsSettling.end(), key) == _alarmsSettling.end())
+            _alarmsSettling.push_back(key);
     }
 }
 
+void TemperatureController::_armAlarmTimer() {
+    _alarmTimerArmed = false;
+    unsigned long dueAt = 0;
+    auto arm = [this](unsigned long at) {
+        if (!_alarmTimerArmed || (long)(at - _alarmWakeAt) < 0) {
+            _alarmWakeAt = at;
+            _alarmTimerArmed = true;
+        }
+    };
 
+    // Keep only alarms that still settle; removed alarms leave an empty slot
+    size_t kept = 0;
+    for (size_t i = 0; i < _alarmsSettling.size(); ++i) {
+        uint16_t key = _alarmsSettling[i];
+        Alarm* alarm = _alarmSlots.get(key / ALARM_TYPE_COUNT, static_cast<AlarmType>(key % ALARM_TYPE_COUNT));
+        if (alarm == nullptr || !alarm->isEnabled() ||
+            (alarm->getStage() != AlarmStage::NEW && alarm->getStage() != AlarmStage::CLEARED)) continue;
+        _alarmsSettling[kept++] = key;
+        if (alarm->getPendingDeadline(dueAt)) arm(dueAt);
+    }
+    _alarmsSettling.resize(kept);
 
+    for (Alarm* alarm = _alarmQueues.first(ALARM_QUEUE_ACKNOWLEDGED); alarm != nullptr;
+         alarm = _alarmQueues.next(alarm)) {
+        if (alarm->getPendingDeadline(dueAt)) arm(dueAt);
+    }
+}
 
 void TemperatureController::_checkPointForAlarms(MeasurementPoint* point) {
     if (!point || !point->getBoundSensor()) return;
     
     // Check for high temperature alarm
-    if (point->getCurrentTemp() >= point->getHighAlarmThreshold()) {
+    if (point->getAlarmStatus() & POINT_ALARM_HIGH) {
         if (!_hasAlarmForPoint(point, AlarmType::HIGH_TEMPERATURE)) {
             createAlarm(AlarmType::HIGH_TEMPERATURE, point, AlarmPriority::PRIORITY_HIGH);
         }
     }
     
     // Check for low temperature alarm
-    if (point->getCurrentTemp() <= point->getLowAlarmThreshold()) {
+    if (point->getAlarmStatus() & POINT_ALARM_LOW) {
         if (!_hasAlarmForPoint(point, AlarmType::LOW_TEMPERATURE)) {
             createAlarm(AlarmType::LOW_TEMPERATURE, point, AlarmPriority::PRIORITY_MEDIUM);
         }
@@ -313,49 +426,117 @@ void TemperatureController::_checkPointForAlarms(MeasurementPoint* point) {
     }
 }
 
-bool TemperatureController::_hasAlarmForPoint(MeasurementPoint* point, AlarmType type) {
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->getSource() == point && 
-            alarm->getType() == type && 
-            alarm->isEnabled() &&
-            alarm->isActive()) {
-            return true;
-        }
+void TemperatureController::_registerAlarm(Alarm* alarm) {
+    _configuredAlarms.push_back(alarm);
+    _alarmSlots.set(alarm);
+    alarm->attachIndexes(&_alarmCounters, &_alarmQueues);
+    alarm->setEventRing(&_alarmEvents);
+}
+
+void TemperatureController::_processAlarmEvents() {
+    AlarmEvent event;
+    for (uint8_t n = 0; n < ALARM_EVENTS_PER_UPDATE && _alarmEvents.pop(event); ++n) {
+        _logAlarmEvent(event);
     }
-    return false;
+
+    uint32_t dropped = _alarmEvents.getDropped();
+    if (dropped != _alarmEventsDropReported) {
+        LoggerManager::warning("ALARM",
+            String(dropped - _alarmEventsDropReported) + " alarm transitions not logged (event queue full)");
+        _alarmEventsDropReported = dropped;
+    }
+}
+
+void TemperatureController::_logAlarmEvent(const AlarmEvent& event) {
+    const MeasurementPoint* point = getMeasurementPoint(event.pointAddress);
+    String pointName = point ? point->getName() : "Unknown";
+    String source = "ALARM_" + String(event.pointAddress);
+    String description = String(Alarm::typeName(event.type)) + " alarm for point " +
+                         String(event.pointAddress) + " (" + pointName + ")";
+
+    switch (event.toStage) {
+        case AlarmStage::ACTIVE:
+            if (event.fromStage == AlarmStage::NEW) {
+                LoggerManager::error(source, description + " activated");
+            } else if (event.fromStage == AlarmStage::RESOLVED) {
+                LoggerManager::error(source, description + " reoccurred after resolution");
+            } else if (event.fromStage == AlarmStage::ACKNOWLEDGED) {
+                LoggerManager::warning(source, description + " acknowledgment timeout - returned to active");
+            } else {
+                LoggerManager::warning(source, description + " condition returned");
+            }
+            break;
+        case AlarmStage::ACKNOWLEDGED:
+            if (event.fromStage == AlarmStage::CLEARED) {
+                LoggerManager::warning(source, description + " condition returned");
+            } else {
+                LoggerManager::info(source, description + " acknowledged");
+            }
+            break;
+        case AlarmStage::CLEARED:
+            LoggerManager::info(source, description + (event.fromStage == AlarmStage::ACKNOWLEDGED ?
+                                " condition cleared while acknowledged" : " condition cleared"));
+            break;
+        case AlarmStage::RESOLVED:
+            if (event.fromStage == AlarmStage::NEW) {
+                LoggerManager::info(source, description + " resolved before activation");
+            } else if (event.fromStage == AlarmStage::CLEARED) {
+                LoggerManager::info(source, description + " auto-resolved after delay");
+            } else {
+                LoggerManager::info(source, description + " resolved");
+            }
+            break;
+        case AlarmStage::NEW:
+            LoggerManager::info(source, description + " reset");
+            break;
+    }
+
+    LoggerManager::logAlarmStateChange(event.pointAddress, pointName,
+                                       Alarm::typeName(event.type), Alarm::priorityName(event.priority),
+                                       Alarm::stageName(event.fromStage), Alarm::stageName(event.toStage),
+                                       event.temperature, event.threshold);
+}
+
+bool TemperatureController::_hasAlarmForPoint(MeasurementPoint* point, AlarmType type) {
+    Alarm* alarm = point ? _alarmSlots.get(point->getAddress(), type) : nullptr;
+    return alarm && alarm->isEnabled() && alarm->isActive();
+}
+
+bool TemperatureController::_hasSensorFault(uint8_t address) const {
+    Alarm* error = _alarmSlots.get(address, AlarmType::SENSOR_ERROR);
+    Alarm* disconnected = _alarmSlots.get(address, AlarmType::SENSOR_DISCONNECTED);
+    return (error && error->isEnabled() && error->isActive()) ||
+           (disconnected && disconnected->isEnabled() && disconnected->isActive());
 }
 
 
 void TemperatureController::createAlarm(AlarmType type, MeasurementPoint* source, AlarmPriority priority) {
     // Check if this alarm already exists in configured alarms
-    String configKey = "alarm_" + String(source->getAddress()) + "_" + String(static_cast<int>(type));
-    
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->getConfigKey() == configKey) {
-            // Alarm already exists, just enable it if it's disabled
-            if (!alarm->isEnabled()) {
-                alarm->setEnabled(true);
-                alarm->setStage(AlarmStage::NEW); // Reset stage
-            }
-            return;
+    Alarm* alarm = _alarmSlots.get(source->getAddress(), type);
+    if (alarm) {
+        // Alarm already exists, just enable it if it's disabled
+        if (!alarm->isEnabled()) {
+            alarm->setEnabled(true);
+            alarm->setStage(AlarmStage::NEW); // Reset stage
         }
+        return;
     }
     
     // Create new alarm and add to configured alarms
     Alarm* newAlarm = new Alarm(type, source, priority);
-    newAlarm->setConfigKey(configKey);
-    _configuredAlarms.push_back(newAlarm);
-    
-    // Sort alarms by priority
-    std::sort(_configuredAlarms.begin(), _configuredAlarms.end(), AlarmComparator());
+    newAlarm->setConfigKey("alarm_" + String(source->getAddress()) + "_" + String(static_cast<int>(type)));
+    _registerAlarm(newAlarm);
 }
 
 
 Alarm* TemperatureController::getHighestPriorityAlarm() const {
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->isEnabled() && alarm->isActive()) {
-            return alarm;
-        }
+    // Oldest of the two queue heads at the highest occupied priority
+    for (int p = ALARM_PRIORITY_COUNT - 1; p >= 0; --p) {
+        Alarm* active = _alarmQueues.head(ALARM_QUEUE_ACTIVE, p);
+        Alarm* acknowledged = _alarmQueues.head(ALARM_QUEUE_ACKNOWLEDGED, p);
+        if (active && acknowledged)
+            return (long)(acknowledged->getTimestamp() - active->getTimestamp()) < 0 ? acknowledged : active;
+        if (active || acknowledged) return active ? active : acknowledged;
     }
     return nullptr;
 }
@@ -370,19 +551,27 @@ void TemperatureController::acknowledgeHighestPriorityAlarm() {
 }
 
 void TemperatureController::acknowledgeAllAlarms() {
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->isEnabled() && alarm->isActive() && !alarm->isAcknowledged()) {
-            alarm->acknowledge();
-        }
+    // Each acknowledgment moves the alarm to the acknowledged queue
+    while (Alarm* alarm = _alarmQueues.first(ALARM_QUEUE_ACTIVE)) {
+        alarm->acknowledge();
     }
 }
 
 
 std::vector<Alarm*> TemperatureController::getActiveAlarms() const {
     std::vector<Alarm*> activeAlarms;
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->isEnabled() && alarm->isActive()) {
-            activeAlarms.push_back(alarm);
+    activeAlarms.reserve(_alarmQueues.size(ALARM_QUEUE_ACTIVE) + _alarmQueues.size(ALARM_QUEUE_ACKNOWLEDGED));
+    // Merge both queues per priority, oldest first
+    for (int p = ALARM_PRIORITY_COUNT - 1; p >= 0; --p) {
+        Alarm* active = _alarmQueues.head(ALARM_QUEUE_ACTIVE, p);
+        Alarm* acknowledged = _alarmQueues.head(ALARM_QUEUE_ACKNOWLEDGED, p);
+        while (active || acknowledged) {
+            bool takeActive = !acknowledged ||
+                (active && (long)(acknowledged->getTimestamp() - active->getTimestamp()) >= 0);
+            Alarm*& from = takeActive ? active : acknowledged;
+            activeAlarms.push_back(from);
+            from = _alarmQueues.next(from);
+            if (from && from->getPriority() != static_cast<AlarmPriority>(p)) from = nullptr;
         }
     }
     return activeAlarms;
@@ -395,6 +584,7 @@ void TemperatureController::clearResolvedAlarms() {
                 _currentDisplayedAlarm = nullptr;
             }
             Serial.printf("Manually clearing resolved alarm: %s\n", (*it)->getConfigKey().c_str());
+            _alarmSlots.erase(*it);
             delete *it;
             it = _configuredAlarms.erase(it);
         } else {
@@ -412,6 +602,7 @@ void TemperatureController::clearConfiguredAlarms() {
             delete *it;
             it = _configuredAlarms.erase(it);
     }
+    _alarmSlots.clear();
 }
 
 void TemperatureController::ensureAlarmsForPoint(MeasurementPoint* point) {
@@ -420,35 +611,32 @@ void TemperatureController::ensureAlarmsForPoint(MeasurementPoint* point) {
     uint8_t address = point->getAddress();
     
     // Check and create LOW_TEMPERATURE alarm if not exists
-    String lowKey = "P" + String(address) + "_LOW_TEMP";
-    if (!findAlarm(lowKey)) {
+    if (!_alarmSlots.get(address, AlarmType::LOW_TEMPERATURE)) {
         Alarm* lowAlarm = new Alarm(AlarmType::LOW_TEMPERATURE, point);
-        lowAlarm->setConfigKey(lowKey);
+        lowAlarm->setConfigKey("P" + String(address) + "_LOW_TEMP");
         lowAlarm->setPriority(AlarmPriority::PRIORITY_MEDIUM);  // Default priority
         lowAlarm->setEnabled(false);  // Default disabled
-        _configuredAlarms.push_back(lowAlarm);
+        _registerAlarm(lowAlarm);
         Serial.printf("Created LOW_TEMPERATURE alarm for point %d\n", address);
     }
     
     // Check and create HIGH_TEMPERATURE alarm if not exists
-    String highKey = "P" + String(address) + "_HIGH_TEMP";
-    if (!findAlarm(highKey)) {
+    if (!_alarmSlots.get(address, AlarmType::HIGH_TEMPERATURE)) {
         Alarm* highAlarm = new Alarm(AlarmType::HIGH_TEMPERATURE, point);
-        highAlarm->setConfigKey(highKey);
+        highAlarm->setConfigKey("P" + String(address) + "_HIGH_TEMP");
         highAlarm->setPriority(AlarmPriority::PRIORITY_MEDIUM);  // Default priority
         highAlarm->setEnabled(false);  // Default disabled
-        _configuredAlarms.push_back(highAlarm);
+        _registerAlarm(highAlarm);
         Serial.printf("Created HIGH_TEMPERATURE alarm for point %d\n", address);
     }
     
     // Check and create SENSOR_ERROR alarm if not exists
-    String errorKey = "P" + String(address) + "_SENSOR_ERROR";
-    if (!findAlarm(errorKey)) {
+    if (!_alarmSlots.get(address, AlarmType::SENSOR_ERROR)) {
         Alarm* errorAlarm = new Alarm(AlarmType::SENSOR_ERROR, point);
-        errorAlarm->setConfigKey(errorKey);
+        errorAlarm->setConfigKey("P" + String(address) + "_SENSOR_ERROR");
         errorAlarm->setPriority(AlarmPriority::PRIORITY_HIGH);  // Default high priority
         errorAlarm->setEnabled(point->getBoundSensor() != nullptr);  // Auto-enable if sensor bound
-        _configuredAlarms.push_back(errorAlarm);
+        _registerAlarm(errorAlarm);
         Serial.printf("Created SENSOR_ERROR alarm for point %d (enabled=%d)\n", address, point->getBoundSensor() != nullptr);
     }
 }
@@ -459,10 +647,9 @@ std::vector<Alarm*> TemperatureController::getAlarmsForPoint(MeasurementPoint* p
     
     uint8_t address = point->getAddress();
     
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->getSource() == point) {
-            alarms.push_back(alarm);
-        }
+    for (uint8_t t = 0; t < ALARM_TYPE_COUNT; ++t) {
+        Alarm* alarm = _alarmSlots.get(address, static_cast<AlarmType>(t));
+        if (alarm) alarms.push_back(alarm);
     }
     
     return alarms;
@@ -947,72 +1134,135 @@ String TemperatureController::getAlarmsJson() {
 
 
 MeasurementPoint* TemperatureController::getMeasurementPoint(uint8_t address) {
-    if (isDS18B20Address(address))
-        return &dsPoints[address];
-    if (isPT1000Address(address))
-        return &ptPoints[address - 50];
-    return nullptr;
+    return _points.get(address);
 }
 
 MeasurementPoint* TemperatureController::getDS18B20Point(uint8_t idx) {
-    return (idx < 50) ? &dsPoints[idx] : nullptr;
+    return (idx < _points.getDS18B20Count()) ? &_points[idx] : nullptr;
 }
 
 MeasurementPoint* TemperatureController::getPT1000Point(uint8_t idx) {
-    return (idx < 10) ? &ptPoints[idx] : nullptr;
+    return (idx < _points.getPT1000Count()) ? &_points[_points.getPT1000Base() + idx] : nullptr;
 }
 
-bool TemperatureController::addSensor(Sensor* sensor) {
-    if (!sensor) return false;
-    // For DS18B20, check by ROM string
-    if (sensor->getType() == SensorType::DS18B20) {
-        String romStr = sensor->getDS18B20RomString();
-        if (findSensorByRom(romStr)) return false;
-    } else if (sensor->getType() == SensorType::PT1000) {
-        if (findSensorByChipSelect(sensor->getPT1000ChipSelectPin())) return false;
+bool TemperatureController::allocatePoints(uint8_t dsCount, uint8_t ptCount) {
+    if (_acqTask != nullptr) return false;
+    // The constructor runs before psramInit(); move the same layout to PSRAM once it is up
+    if (_points.size() > 0 && dsCount == _points.getDS18B20Count() && ptCount == _points.getPT1000Count() &&
+        (_points.isExternal() || !externalMemoryAvailable()))
+        return true;
+
+    // Stage every table first so a failure leaves the current layout untouched
+    uint16_t count = (uint16_t)dsCount + ptCount;
+    PointSample* applied = static_cast<PointSample*>(externalAlloc(sizeof(PointSample) * (count ? count : 1)));
+    uint16_t* registers = RegisterMap::allocatePointBlock(count);
+    PointSnapshot snapshot;
+    AlarmSlotTable slots;
+    AlarmEventRing events;
+    // Room for a transition of every alarm the slot table can hold
+    size_t eventCount = (size_t)count * ALARM_TYPE_COUNT;
+    if (applied == nullptr || registers == nullptr ||
+        !snapshot.allocate(count) || !slots.allocate(count) ||
+        !events.allocate(eventCount > ALARM_EVENT_RING_SIZE ? eventCount : ALARM_EVENT_RING_SIZE) ||
+        !_points.allocate(dsCount, ptCount)) {
+        externalFree(applied);
+        externalFree(registers);
+        LoggerManager::error("POINTS", "Cannot allocate " + String(count) + " measurement points");
+        return false;
     }
-    sensors.push_back(sensor);
-    if (sensor->getType() == SensorType::DS18B20)
-        registerMap.incrementActiveDS18B20();
-    else
-        registerMap.incrementActivePT1000();
+
+    registerMap.adoptPoints(registers, count, dsCount);
+    _pointSnapshot.swap(snapshot);
+    _alarmSlots.swap(slots);
+    // Queued transitions are carried over; the alarms keep pointing at _alarmEvents
+    AlarmEvent event;
+    while (_alarmEvents.pop(event)) events.push(event);
+    _alarmEvents.swap(events);
+    externalFree(_appliedSamples);
+    _appliedSamples = applied;
+    _appliedSnapshotSequence = 0;
     return true;
 }
 
+bool TemperatureController::addSensor(Sensor* sensor) {
+    if (!sensor) return false;
+    _lockSensors();
+    bool added = _registerSensor(sensor);
+    _unlockSensors();
+    return added;
+}
+
 bool TemperatureController::removeSensorByRom(const String& romString) {
-    for (auto it = sensors.begin(); it != sensors.end(); ++it) {
-        if ((*it)->getType() == SensorType::DS18B20 &&
-            (*it)->getDS18B20RomString() == romString) {
-            // Unbind from any point
-            for (uint8_t i = 0; i < 50; ++i) {
-                if (dsPoints[i].getBoundSensor() == *it)
-                    dsPoints[i].unbindSensor();
-            }
-            registerMap.decrementActiveDS18B20();
-            delete *it;
-            sensors.erase(it);
-            return true;
-        }
+    _lockSensors();
+    Sensor* sensor = findSensorByRom(romString);
+    if (!sensor) {
+        _unlockSensors();
+        return false;
     }
-    return false;
+    // Unbind from any point
+    for (MeasurementPoint& point : _points) {
+        if (point.getBoundSensor() == sensor)
+            point.unbindSensor();
+    }
+    _unregisterSensor(sensor);
+    delete sensor;
+    _unlockSensors();
+    return true;
 }
 
 Sensor* TemperatureController::findSensorByRom(const String& romString) {
-    for (auto s : sensors) {
-            Serial.println("Sensor ROM" + s->getDS18B20RomString());
-        if (s->getType() == SensorType::DS18B20 &&
-            s->getDS18B20RomString() == romString)
-            return s;
-    }
-    return nullptr;
+    uint64_t key;
+    if (!SensorRomIndex::romKeyFromHex(romString.c_str(), key))
+        return nullptr;
+    return _romIndex.find(key);
+}
+
+Sensor* TemperatureController::findSensorByRom(const uint8_t* rom) {
+    return _romIndex.find(SensorRomIndex::romKey(rom));
 }
 
 Sensor* TemperatureController::findSensorByChipSelect(uint8_t csPin) {
-    for (auto s : sensors)
-        if (s->getType() == SensorType::PT1000 &&
-            s->getPT1000ChipSelectPin() == csPin)
-            return s;
-    return nullptr;
+    return csPin < SENSOR_CS_INDEX_SIZE ? _csIndex[csPin] : nullptr;
+}
+
+bool TemperatureController::_registerSensor(Sensor* sensor) {
+    if (sensor->getType() == SensorType::DS18B20) {
+        int bus = getSensorBus(sensor);
+        uint64_t key = SensorRomIndex::romKey(sensor->getDS18B20Address());
+        if (bus < 0 || _romIndex.find(key)) return false;
+        if (!_romIndex.insert(key, sensor)) {
+            Serial.printf("ROM index full (%u sensors), sensor %s not added\n",
+                          (unsigned)_romIndex.size(), sensor->getDS18B20RomString().c_str());
+            return false;
+        }
+        _busSensors[bus].push_back(sensor);
+        registerMap.incrementActiveDS18B20();
+    } else if (sensor->getType() == SensorType::PT1000) {
+        uint8_t cs = sensor->getPT1000ChipSelectPin();
+        if (cs >= SENSOR_CS_INDEX_SIZE || _csIndex[cs]) return false;
+        _csIndex[cs] = sensor;
+        registerMap.incrementActivePT1000();
+    } else {
+        return false;
+    }
+    sensors.push_back(sensor);
+    return true;
+}
+
+void TemperatureController::_unregisterSensor(Sensor* sensor) {
+    if (sensor->getType() == SensorType::DS18B20) {
+        _romIndex.erase(SensorRomIndex::romKey(sensor->getDS18B20Address()));
+        for (auto& list : _busSensors)
+            list.erase(std::remove(list.begin(), list.end(), sensor), list.end());
+        registerMap.decrementActiveDS18B20();
+    } else if (sensor->getType() == SensorType::PT1000) {
+        uint8_t cs = sensor->getPT1000ChipSelectPin();
+        if (cs < SENSOR_CS_INDEX_SIZE && _csIndex[cs] == sensor) _csIndex[cs] = nullptr;
+        registerMap.decrementActivePT1000();
+    }
+    sensors.erase(std::remove(sensors.begin(), sensors.end(), sensor), sensors.end());
+    // Keep the running sweep's read indices valid
+    std::replace(_sweepSensors.begin(), _sweepSensors.end(), sensor, (Sensor*)nullptr);
 }
 
 Sensor* TemperatureController::getSensorByIndex(int idx) {
@@ -1020,45 +1270,47 @@ Sensor* TemperatureController::getSensorByIndex(int idx) {
 }
 
 bool TemperatureController::bindSensorToPointByRom(const String& romString, uint8_t pointAddress) {
-    if(pointAddress > 49) return false;
+    if (!isDS18B20Address(pointAddress)) return false;
+    // Bindings are read by the acquisition task in _publishSweep()
+    _lockSensors();
     Sensor* sensor = findSensorByRom(romString);
     unbindSensorFromPointBySensor(sensor);
     MeasurementPoint* point = getMeasurementPoint(pointAddress);
-    if (!sensor || !point){
+    if (sensor && point) point->bindSensor(sensor);
+    _unlockSensors();
+
+    if (!sensor || !point) {
         LoggerManager::warning("BINDING", 
             "Failed to bind sensor " + romString + " to point " + String(pointAddress));
-        
-        return false;} 
-
-        point->bindSensor(sensor);
-
-        String pointName = point->getName().isEmpty() ? 
-            "Point_" + String(pointAddress) : point->getName();
-        LoggerManager::info("BINDING", 
-            "Sensor " + romString + " bound to point " + String(pointAddress) + 
-            " (" + pointName + ")");
-
-
-
+        return false;
+    }
 
+    String pointName = point->getName().isEmpty() ? 
+        "Point_" + String(pointAddress) : point->getName();
+    LoggerManager::info("BINDING", 
+        "Sensor " + romString + " bound to point " + String(pointAddress) + 
+        " (" + pointName + ")");
     return true;
 }
 
 bool TemperatureController::bindSensorToPointByChipSelect(uint8_t csPin, uint8_t pointAddress) {
     Serial.printf("Point address: %d\n", pointAddress);
-    if((pointAddress < 50) || (pointAddress > 59)) 
+    if (!isPT1000Address(pointAddress))
         return false;
     Serial.printf("Point address: %d PASSED!\n", pointAddress);
+    _lockSensors();
     Sensor* sensor = findSensorByChipSelect(csPin);
     unbindSensorFromPointBySensor(sensor);
     MeasurementPoint* point = getMeasurementPoint(pointAddress);
+    if (sensor && point) point->bindSensor(sensor);
+    _unlockSensors();
+
     if (!sensor || !point) {
-        
         LoggerManager::warning("BINDING", 
             "Failed to bind PT1000 sensor CS" + String(csPin) + 
             " to point " + String(pointAddress));
-        return false;}
-    point->bindSensor(sensor);
+        return false;
+    }
     
     String pointName = point->getName().isEmpty() ? 
             "Point_" + String(pointAddress) : point->getName();
@@ -1072,22 +1324,26 @@ bool TemperatureController::unbindSensorFromPoint(uint8_t pointAddress) {
     MeasurementPoint* point = getMeasurementPoint(pointAddress);
     if (!point) {
         LoggerManager::error("BINDING", 
-            "Faild to unbound sensor from point " + String(pointAddress) + 
-            " (" + point->getName() + ")");
+            "Faild to unbound sensor from point " + String(pointAddress));
         return false;
     }
 
-    if (point->getBoundSensor()) {
-        String sensorInfo = point->getBoundSensor()->getType() == SensorType::DS18B20 ? 
-        point->getBoundSensor()->getDS18B20RomString() : 
-            "CS" + String(point->getBoundSensor()->getPT1000ChipSelectPin());
-        
+    _lockSensors();
+    Sensor* sensor = point->getBoundSensor();
+    String sensorInfo;
+    if (sensor) {
+        sensorInfo = sensor->getType() == SensorType::DS18B20 ? 
+            sensor->getDS18B20RomString() : 
+            "CS" + String(sensor->getPT1000ChipSelectPin());
+    }
+    point->unbindSensor();
+    _unlockSensors();
+
+    if (sensor) {
         LoggerManager::info("BINDING", 
             "Sensor " + sensorInfo + " unbound from point " + String(pointAddress) + 
             " (" + point->getName() + ")");
     }
-
-    point->unbindSensor();
     return true;
 }
 
@@ -1096,18 +1352,19 @@ Sensor* TemperatureController::getBoundSensor(uint8_t pointAddress) {
     return point ? point->getBoundSensor() : nullptr;
 }
 
-void TemperatureController::readAllPoints() {
-    for (uint8_t i = 0; i < 50; ++i)
-        dsPoints[i].update();
-    for (uint8_t i = 0; i < 10; ++i)
-        ptPoints[i].update();
+bool TemperatureController::readAllPoints() {
+    uint32_t sequence = _pointSnapshot.read(_appliedSamples);
+    if (sequence == 0 || sequence == _appliedSnapshotSequence) return false;
+    _appliedSnapshotSequence = sequence;
+
+    _points.hot().applySamples(_appliedSamples);
+    return true;
 }
 
 void TemperatureController::updateRegisterMap() {
-    for (uint8_t i = 0; i < 50; ++i)
-        registerMap.updateFromMeasurementPoint(dsPoints[i]);
-    for (uint8_t i = 0; i < 10; ++i)
-        registerMap.updateFromMeasurementPoint(ptPoints[i]);
+    const PointHotStore& hot = _points.hot();
+    registerMap.updateFromHotStore(hot, _registerMapSequence);
+    _registerMapSequence = hot.getSequence();
     
     // Update relay status registers with commanded and actual states
     for (uint8_t i = 1; i <= 3; ++i) {
@@ -1118,17 +1375,13 @@ void TemperatureController::updateRegisterMap() {
 }
 
 void TemperatureController::applyConfigFromRegisterMap() {
-    for (uint8_t i = 0; i < 50; ++i)
-        registerMap.applyConfigToMeasurementPoint(dsPoints[i]);
-    for (uint8_t i = 0; i < 10; ++i)
-        registerMap.applyConfigToMeasurementPoint(ptPoints[i]);
+    for (MeasurementPoint& point : _points)
+        registerMap.applyConfigToMeasurementPoint(point);
 }
 
 void TemperatureController::applyConfigToRegisterMap() {
-    for (uint8_t i = 0; i < 50; ++i)
-        registerMap.applyConfigFromMeasurementPoint(dsPoints[i]);
-    for (uint8_t i = 0; i < 10; ++i)
-        registerMap.applyConfigFromMeasurementPoint(ptPoints[i]);
+    for (const MeasurementPoint& point : _points)
+        registerMap.applyConfigFromMeasurementPoint(point);
 }
 
 bool TemperatureController::discoverDS18B20Sensors() {
@@ -1136,6 +1389,10 @@ bool TemperatureController::discoverDS18B20Sensors() {
     Serial.println("Discover method started...");
     LoggerManager::info("DISCOVERY", "Starting DS18B20 sensor discovery");
     uint totalFound = 0;
+    // Discovery drives the same buses as the acquisition task
+    _lockSensors();
+    // The full search below reuses the OneWire search state; restart any background pass
+    _discoveryActive = false;
     // OneWire oneWire[] = { OneWire(oneWireBusPin[0]), OneWire(oneWireBusPin[1]), OneWire(oneWireBusPin[2]), OneWire(oneWireBusPin[3]) };
     // DallasTemperature dallasSensors[] = {DallasTemperature(&oneWire[0]), DallasTemperature(&oneWire[1]), DallasTemperature(&oneWire[2]), DallasTemperature(&oneWire[3])};
     for (uint j = 0; j < 4; j++){
@@ -1143,14 +1400,29 @@ bool TemperatureController::discoverDS18B20Sensors() {
         
     //OneWire oneWire(oneWireBusPin[j]);
     
-    dallasSensors[j]->begin();
+    OneWireInterface* bus = oneWireBuses[j];
+    bus->lock();
+    _busParasite[j] = bus->begin();
+    if (_busParasite[j]) {
+        LoggerManager::info("DISCOVERY", "Parasite-powered devices on bus " + String(j));
+    }
 
-    int deviceCount = dallasSensors[j]->getDeviceCount();
+    // Enumerate the bus once; a device failing CRC or family check is skipped
+    std::vector<std::array<uint8_t, 8>> roms;
+    std::array<uint8_t, 8> found;
+    bus->resetSearch();
+    while (bus->search(found.data())) {
+        if (oneWireCrc8(found.data(), 7) == found[7] && oneWireValidFamily(found.data()))
+            roms.push_back(found);
+    }
+    int deviceCount = roms.size();
     Serial.printf("Devices on bus %d: %d\n", j, deviceCount);
-    if (deviceCount == 0) continue;
+    if (deviceCount == 0) {
+        bus->unlock();
+        continue;
+    }
     totalFound += deviceCount;
 
-    DeviceAddress sensorAddress;
     if (deviceCount > 0) {
         LoggerManager::info("DISCOVERY", 
             "Found " + String(deviceCount) + " DS18B20 sensors on bus " + String(j));
@@ -1158,7 +1430,8 @@ bool TemperatureController::discoverDS18B20Sensors() {
     
 
     for (int i = 0; i < deviceCount; i++) {
-        if (dallasSensors[j]->getAddress(sensorAddress, i)) {
+        const uint8_t* sensorAddress = roms[i].data();
+        {
             Serial.printf("Bus %d. Device %d of %d\n", j, i, deviceCount);
             // Convert ROM to string for uniqueness
             char buf[17];
@@ -1167,8 +1440,9 @@ bool TemperatureController::discoverDS18B20Sensors() {
             Serial.printf("ROM: %s\n", romString);
 
             // Check if already exists
-            if (findSensorByRom(romString)){
-                if(getSensorBus(findSensorByRom(romString)) != j) {
+            Sensor* existing = findSensorByRom(sensorAddress);
+            if (existing){
+                if(getSensorBus(existing) != j) {
                     removeSensorByRom(romString);
                     Serial.println("Device existed on enother bus. Deleting");
                     //continue;
@@ -1182,12 +1456,10 @@ bool TemperatureController::discoverDS18B20Sensors() {
             Sensor* newSensor = new Sensor(SensorType::DS18B20, 0, sensorName); // address field not used for DS
             Serial.printf("Sensor created with name %s on bus %d\n", newSensor->getName(), getSensorBus(newSensor));
 
-            newSensor->setupDS18B20(oneWireBusPin[j], sensorAddress);
+            newSensor->setupDS18B20(bus, sensorAddress);
             Serial.printf("Sensor %s set on bus %d/ pin %d\n", newSensor->getName(), getSensorBus(newSensor), newSensor->getOneWirePin());
 
-            if (newSensor->initialize()) {
-                sensors.push_back(newSensor);
-                registerMap.incrementActiveDS18B20();
+            if (newSensor->initialize() && _registerSensor(newSensor)) {
                 anyAdded = true;
                 Serial.printf("Sensor %s set on bus %d/ pin %d status: Connected\n", newSensor->getName(), getSensorBus(newSensor), newSensor->getOneWirePin());
                 
@@ -1197,8 +1469,10 @@ bool TemperatureController::discoverDS18B20Sensors() {
             }
         }
     }
+    bus->unlock();
     }
 
+    _unlockSensors();
     LoggerManager::info("DISCOVERY", 
         "DS18B20 discovery completed. Total sensors: " + String(totalFound));
 
@@ -1233,16 +1507,15 @@ bool TemperatureController::discoverPTSensors() {
             Serial.printf("Sensor created with name %s on bus %d\n", newSensor->getName(), getSensorBus(newSensor));
 
             newSensor->setupPT1000(chipSelectPin[j], j);
+            newSensor->setPT1000ContinuousMode(_ptContinuous, _ptFilter50Hz);
+            if (!newSensor->setRtdCalibration(_rtdNominal, _ptRefResistor[j])) {
+                LoggerManager::error("CONFIG",
+                    "Invalid RTD calibration for PT channel " + String(j) + ", using PT1000 defaults");
+            }
             Serial.printf("Sensor %s set on bus %d/ pin %d\n", newSensor->getName(), getSensorBus(newSensor), newSensor->getPT1000ChipSelectPin());
             
 
-            if (newSensor->initialize()) {
-
-                
-
-
-                sensors.push_back(newSensor);
-                registerMap.incrementActivePT1000();
+            if (newSensor->initialize() && addSensor(newSensor)) {
                 anyAdded = true;
                 Serial.printf("Sensor %s set on bus %d/ pin %d status: Connected\n", newSensor->getName(), getSensorBus(newSensor), newSensor->getPT1000ChipSelectPin());
                 LoggerManager::info("DISCOVERY", 
@@ -1258,8 +1531,19 @@ bool TemperatureController::discoverPTSensors() {
 }
 
 
+// Document budgets for getSensorsJson()/getPointsJson(); strings are copied into the pool
+static constexpr size_t HEALTH_JSON_SIZE =
+    JSON_OBJECT_SIZE(11) + JSON_ARRAY_SIZE(LogHistogram<HEALTH_READ_BASE_US>::BUCKETS);
+static constexpr size_t SENSOR_JSON_SIZE =
+    JSON_OBJECT_SIZE(24) + JSON_ARRAY_SIZE(8) + HEALTH_JSON_SIZE + 96;
+static constexpr size_t POINT_JSON_SIZE = JSON_OBJECT_SIZE(17) + JSON_ARRAY_SIZE(8) + 96;
+static constexpr size_t SENSORS_FOOTER_JSON_SIZE =
+    JSON_OBJECT_SIZE(12) + JSON_ARRAY_SIZE(4) * 3 + 4 * (JSON_OBJECT_SIZE(11) + JSON_ARRAY_SIZE(8) + HEALTH_JSON_SIZE) +
+    4 * (JSON_OBJECT_SIZE(3) + HEALTH_JSON_SIZE) + JSON_OBJECT_SIZE(2) + 2 * JSON_ARRAY_SIZE(8) +
+    4 * JSON_OBJECT_SIZE(4) + 256;
+
 String TemperatureController::getSensorsJson() {
-    DynamicJsonDocument doc(8192);
+    ExternalJsonDocument doc(sensors.size() * SENSOR_JSON_SIZE + SENSORS_FOOTER_JSON_SIZE);
     JsonArray sensorArray = doc.createNestedArray("sensors");
 
     for (auto sensor : sensors) {
@@ -1281,52 +1565,118 @@ String TemperatureController::getSensorsJson() {
             uint8_t rom[8];
             sensor->getDS18B20RomArray(rom);
             for (int j = 0; j < 8; ++j) romArr.add(rom[j]);
+            obj["resolution"] = sensor->getResolution();
+            obj["crcErrors"] = sensor->getCrcErrorCount();
+            obj["retries"] = sensor->getRetryCount();
             
         } else if (sensor->getType() == SensorType::PT1000) {
             obj["chipSelectPin"] = sensor->getPT1000ChipSelectPin();
+            obj["continuous"] = sensor->isPT1000ContinuousMode();
+            obj["rtdNominal"] = sensor->getRtdNominal();
+            obj["rref"] = sensor->getRtdReference();
         }
 
+        obj["sampleIntervalMs"] = sensor->getSampleInterval();
+        obj["quarantined"] = sensor->isQuarantined();
+        obj["consecutiveFailures"] = sensor->getConsecutiveFailures();
+        obj["probeBackoffMs"] = sensor->getQuarantineBackoff();
+        _addHealthJson(obj.createNestedObject("health"), sensor->getHealth());
+
         // Binding info
         int boundPoint = -1;
-        if (sensor->getType() == SensorType::DS18B20) {
-            String romString = sensor->getDS18B20RomString();
-            for (uint8_t i = 0; i < 50; ++i) {
-                Sensor* bound = dsPoints[i].getBoundSensor();
-                if (bound && bound->getType() == SensorType::DS18B20 &&
-                    bound->getDS18B20RomString() == romString) {
-                    boundPoint = dsPoints[i].getAddress();
-                    break;
-                }
-            }
-        } else if (sensor->getType() == SensorType::PT1000) {
-            for (uint8_t i = 0; i < 10; ++i) {
-                Sensor* bound = ptPoints[i].getBoundSensor();
-                if (bound && bound == sensor) {
-                    boundPoint = ptPoints[i].getAddress();
-                    break;
-                }
+        for (const MeasurementPoint& point : _points) {
+            if (point.getBoundSensor() == sensor) {
+                boundPoint = point.getAddress();
+                break;
             }
         }
         if (boundPoint >= 0) obj["boundPoint"] = boundPoint;
         else obj["boundPoint"] = nullptr;
     }
 
+    // Per-bus acquisition timing
+    doc["acquisitionMode"] = (acquisitionMode == AcquisitionMode::BUS_SWEEP) ? "bus_sweep" : "per_sensor";
+    doc["adaptiveSampling"] = _adaptiveSampling;
+    doc["alarmScreening"] = _alarmScreening;
+    doc["alarmScreenHits"] = _alarmScreenHits;
+    doc["backgroundDiscovery"] = _discoveryEnabled;
+    doc["discoveryPasses"] = _discoveryPasses;
+    doc["discoveryEventsDropped"] = _discoveryEvents.getDropped();
+    JsonArray busArray = doc.createNestedArray("buses");
+    for (int b = 0; b < 4; ++b) {
+        JsonObject busObj = busArray.createNestedObject();
+        busObj["bus"] = b;
+        busObj["pin"] = oneWireBusPin[b];
+        busObj["sensorCount"] = busTiming[b].sensorCount;
+        busObj["conversionMs"] = busTiming[b].conversionMs;
+        busObj["readMs"] = busTiming[b].readMs;
+        busObj["sweepMs"] = busTiming[b].sweepMs;
+        busObj["lastSweepStart"] = busTiming[b].lastSweepStart;
+        busObj["sweepP95Ms"] = busTiming[b].sweepHistogram.percentile(95);
+        busObj["sweepMaxMs"] = busTiming[b].sweepHistogram.maxValue;
+        JsonArray sweepBuckets = busObj.createNestedArray("sweepHistogram");
+        for (uint8_t k = 0; k < LogHistogram<HEALTH_SWEEP_BASE_MS>::BUCKETS; ++k)
+            sweepBuckets.add(busTiming[b].sweepHistogram.counts[k]);
+        _addHealthJson(busObj.createNestedObject("health"), getBusHealth(b));
+    }
+    JsonArray csArray = doc.createNestedArray("chipSelects");
+    for (int c = 0; c < 4; ++c) {
+        JsonObject csObj = csArray.createNestedObject();
+        csObj["channel"] = c;
+        csObj["pin"] = chipSelectPin[c];
+        _addHealthJson(csObj.createNestedObject("health"), getChipSelectHealth(c));
+    }
+    JsonObject bucketsObj = doc.createNestedObject("histogramBuckets");
+    JsonArray readLimits = bucketsObj.createNestedArray("readUs");
+    JsonArray sweepLimits = bucketsObj.createNestedArray("sweepMs");
+    for (uint8_t k = 0; k < LogHistogram<HEALTH_READ_BASE_US>::BUCKETS - 1; ++k) {
+        readLimits.add(LogHistogram<HEALTH_READ_BASE_US>::bucketLimit(k));
+        sweepLimits.add(LogHistogram<HEALTH_SWEEP_BASE_MS>::bucketLimit(k));
+    }
+    JsonArray groupArray = doc.createNestedArray("resolutionGroups");
+    for (int g = 0; g < 4; ++g) {
+        JsonObject groupObj = groupArray.createNestedObject();
+        groupObj["resolution"] = g + DS18B20_MIN_RESOLUTION;
+        groupObj["conversionMs"] = ds18b20ConversionTimeMs(g + DS18B20_MIN_RESOLUTION);
+        groupObj["sensorCount"] = _groups[g].sensorCount;
+        groupObj["passes"] = _groups[g].passes;
+    }
+
+    if (doc.overflowed()) {
+        LoggerManager::error("SENSOR", "Sensor list exceeds the JSON document (" + String(sensors.size()) +
+                             " sensors, " + String(doc.capacity()) + " bytes)");
+        return String();
+    }
+
     String out;
     serializeJson(doc, out);
     return out;
 }
 
-String TemperatureController::getPointsJson() {
-    DynamicJsonDocument doc(8192);
+String TemperatureController::getPointsJson(uint32_t since) {
+    const PointHotStore& hot = _points.hot();
+    if (since > hot.getSequence()) since = 0;
+
+    uint16_t listed = 0;
+    for (uint16_t i = 0; i < _points.size(); ++i)
+        if (hot.changedSince(i, since)) listed++;
+    ExternalJsonDocument doc(JSON_OBJECT_SIZE(6) + JSON_ARRAY_SIZE(listed) + listed * POINT_JSON_SIZE);
+    doc["dsPointCount"] = _points.getDS18B20Count();
+    doc["ptPointCount"] = _points.getPT1000Count();
+    doc["epoch"] = _pointEpoch;
+    doc["sequence"] = hot.getSequence();
+    doc["full"] = since == 0;
     JsonArray pointsArray = doc.createNestedArray("points");
 
     // DS18B20 points
-    for (uint8_t i = 0; i < 50; ++i) { //Should be 50 instad of 2 here
-        MeasurementPoint& point = dsPoints[i];
+    for (uint8_t i = 0; i < _points.getDS18B20Count(); ++i) {
+        if (!hot.changedSince(i, since)) continue;
+        MeasurementPoint& point = _points[i];
         JsonObject obj = pointsArray.createNestedObject();
         obj["address"] = point.getAddress();
         obj["name"] = point.getName();
         obj["type"] = "DS18B20";
+        obj["resolution"] = point.getResolution();
         obj["currentTemp"] = point.getCurrentTemp();
         obj["minTemp"] = point.getMinTemp();
         obj["maxTemp"] = point.getMaxTemp();
@@ -1334,6 +1684,8 @@ String TemperatureController::getPointsJson() {
         obj["highAlarmThreshold"] = point.getHighAlarmThreshold();
         obj["alarmStatus"] = point.getAlarmStatus();
         obj["errorStatus"] = point.getErrorStatus();
+        obj["minPeriodMs"] = point.getMinSamplePeriod();
+        obj["maxPeriodMs"] = point.getMaxSamplePeriod();
         
 
         Sensor* bound = point.getBoundSensor();
@@ -1350,8 +1702,9 @@ String TemperatureController::getPointsJson() {
     }
 
     // PT1000 points
-    for (uint8_t i = 0; i < 10; ++i) { //should be 10 instaed of 1
-        MeasurementPoint& point = ptPoints[i];
+    for (uint16_t i = _points.getPT1000Base(); i < _points.size(); ++i) {
+        if (!hot.changedSince(i, since)) continue;
+        MeasurementPoint& point = _points[i];
         JsonObject obj = pointsArray.createNestedObject();
         obj["address"] = point.getAddress();
         obj["name"] = point.getName();
@@ -1363,6 +1716,8 @@ String TemperatureController::getPointsJson() {
         obj["highAlarmThreshold"] = point.getHighAlarmThreshold();
         obj["alarmStatus"] = point.getAlarmStatus();
         obj["errorStatus"] = point.getErrorStatus();
+        obj["minPeriodMs"] = point.getMinSamplePeriod();
+        obj["maxPeriodMs"] = point.getMaxSamplePeriod();
 
         Sensor* bound = point.getBoundSensor();
         if (bound && bound->getType() == SensorType::PT1000) {
@@ -1372,6 +1727,12 @@ String TemperatureController::getPointsJson() {
         }
     }
 
+    if (doc.overflowed()) {
+        LoggerManager::error("POINTS", "Point list exceeds the JSON document (" + String(listed) +
+                             " points, " + String(doc.capacity()) + " bytes)");
+        return String();
+    }
+
     String out;
     serializeJson(doc, out);
     return out;
@@ -1383,6 +1744,9 @@ String TemperatureController::getSystemStatusJson() {
     doc["firmwareVersion"] = firmwareVersion;
     doc["ds18b20Count"] = getDS18B20Count();
     doc["pt1000Count"] = getPT1000Count();
+    doc["dsPointCount"] = _points.getDS18B20Count();
+    doc["ptPointCount"] = _points.getPT1000Count();
+    doc["pointsInPsram"] = _points.isExternal();
     doc["measurementPeriod"] = measurementPeriodSeconds;
     doc["uptime"] = millis() / 1000;
 
@@ -1398,10 +1762,7 @@ String TemperatureController::getSystemStatusJson() {
 
 void TemperatureController::resetMinMaxValues() {
     LoggerManager::info("SYSTEM", "Min/Max temperature values reset");
-    for (uint8_t i = 0; i < 50; ++i)
-        dsPoints[i].resetMinMaxTemp();
-    for (uint8_t i = 0; i < 10; ++i)
-        ptPoints[i].resetMinMaxTemp();
+    _points.hot().resetMinMax();
 }
 
 void TemperatureController::setDeviceId(uint16_t id) {
@@ -1432,6 +1793,81 @@ void TemperatureController::setMeasurementPeriod(uint16_t seconds) {
     }
 }
 
+void TemperatureController::setPT1000ContinuousMode(bool continuous, bool filter50Hz) {
+    if (continuous == _ptContinuous && filter50Hz == _ptFilter50Hz) return;
+    _ptContinuous = continuous;
+    _ptFilter50Hz = filter50Hz;
+
+    _lockSensors();
+    for (auto sensor : sensors) {
+        if (sensor->getType() == SensorType::PT1000) {
+            sensor->setPT1000ContinuousMode(continuous, filter50Hz);
+        }
+    }
+    _unlockSensors();
+
+    LoggerManager::info("CONFIG",
+        "PT1000 conversion mode: " + String(continuous ? "continuous" : "one-shot") +
+        ", mains filter " + String(filter50Hz ? "50" : "60") + " Hz");
+}
+
+void TemperatureController::setBackgroundDiscovery(bool enabled) {
+    if (enabled == _discoveryEnabled) return;
+    _lockSensors();
+    _discoveryEnabled = enabled;
+    _discoveryActive = false;
+    _unlockSensors();
+    LoggerManager::info("CONFIG",
+        "Background sensor discovery " + String(enabled ? "enabled" : "disabled"));
+}
+
+void TemperatureController::setHardwareAlarmScreening(bool enabled) {
+    if (enabled == _alarmScreening) return;
+    _alarmScreening = enabled;
+    LoggerManager::info("CONFIG",
+        "DS18B20 hardware alarm screening " + String(enabled ? "enabled" : "disabled"));
+}
+
+void TemperatureController::setAdaptiveSampling(bool enabled) {
+    if (enabled == _adaptiveSampling) return;
+    _adaptiveSampling = enabled;
+    LoggerManager::info("CONFIG",
+        "Adaptive sampling " + String(enabled ? "enabled" : "disabled"));
+}
+
+bool TemperatureController::setRtdNominal(float nominal) {
+    if (nominal == _rtdNominal) return true;
+    _rtdNominal = nominal;
+    bool ok = true;
+    for (size_t ch = 0; ch < 4; ++ch) ok = _applyRtdCalibration(ch) && ok;
+    LoggerManager::info("CONFIG", "RTD element set to PT" + String((int)nominal));
+    return ok;
+}
+
+bool TemperatureController::setRtdReference(size_t channel, float refResistor) {
+    if (channel >= 4) return false;
+    if (refResistor == _ptRefResistor[channel]) return true;
+    _ptRefResistor[channel] = refResistor;
+    LoggerManager::info("CONFIG",
+        "PT channel " + String(channel) + " reference resistor set to " + String(refResistor, 1) + " ohm");
+    return _applyRtdCalibration(channel);
+}
+
+bool TemperatureController::_applyRtdCalibration(size_t channel) {
+    _lockSensors();
+    Sensor* sensor = findSensorByChipSelect(chipSelectPin[channel]);
+    bool ok = !sensor || sensor->setRtdCalibration(_rtdNominal, _ptRefResistor[channel]);
+    _unlockSensors();
+    if (!ok) {
+        LoggerManager::error("CONFIG",
+            "Invalid RTD calibration for PT channel " + String(channel) + ": RREF " +
+            String(_ptRefResistor[channel], 1) + " ohm with PT" + String((int)_rtdNominal) +
+            " (allowed " + String((int)_rtdNominal) + ".." + String((int)(_rtdNominal * RTD_MAX_REF_RATIO)) +
+            " ohm), keeping previous values");
+    }
+    return ok;
+}
+
 uint16_t TemperatureController::getMeasurementPeriod() const {
     return measurementPeriodSeconds;
 }
@@ -1461,29 +1897,723 @@ int TemperatureController::getPT1000Count() const {
 }
 
 void TemperatureController::updateAllSensors() {
+    if (acquisitionMode == AcquisitionMode::BUS_SWEEP && _acqTask != nullptr) {
+        // The task owns the engine: request the sweep and wait for its snapshot
+        _lockSensors();
+        uint32_t sequence = _pointSnapshot.getSequence();
+        _sampleAllRequested = true;
+        _unlockSensors();
+        unsigned long start = millis();
+        bool done = false;
+        while (!done && millis() - start < FORCED_SWEEP_TIMEOUT_MS) {
+            vTaskDelay(1);
+            _lockSensors();
+            done = !_sampleAllRequested && !_sampleAll &&
+                   _pointSnapshot.getSequence() != sequence;
+            _unlockSensors();
+        }
+        return;
+    }
+
+    _lockSensors();
+    if (acquisitionMode == AcquisitionMode::BUS_SWEEP) {
+        // Blocking full sweep through the same engine used by update(); a
+        // sweep already in flight is finished first, never restarted
+        bool forced = false;
+        for (;;) {
+            if (!forced && _acqPhase == AcquisitionPhase::IDLE) {
+                _sampleAll = true;
+                forced = true;
+            }
+            _stepAcquisition();
+            if (forced && !_sampleAll) break;
+            if (_acqPhase == AcquisitionPhase::CONVERTING ||
+                _acqPhase == AcquisitionPhase::SCREENING) {
+                long remaining = (long)(_acqDeadline - millis());
+                if (remaining > 0) delay(remaining);
+            }
+        }
+    } else {
+        _sampleAll = true;
+        for (auto sensor : sensors) {
+            sensor->readTemperature();
+        }
+        _publishSweep();
+        _acqPhase = AcquisitionPhase::IDLE;
+    }
+    _sampleAll = false;
+    _unlockSensors();
+}
+
+bool TemperatureController::_stepAcquisition() {
+    switch (_acqPhase) {
+        case AcquisitionPhase::IDLE:
+            if (_sampleAllRequested) {
+                _sampleAllRequested = false;
+                _sampleAll = true;
+            }
+            if (_alarmScreening) _writePendingAlarmLimits();
+            // Hot-plug detection: one ROM search step between sweeps
+            if (_discoveryEnabled && !_sampleAll) _discoveryStep();
+            if (_startConversions()) {
+                _acqPhase = AcquisitionPhase::CONVERTING;
+                return false;
+            }
+            if (_sampleAll) {
+                // Forced sweep with nothing to convert: still publish a fresh snapshot
+                _publishSweep();
+                _sampleAll = false;
+                return true;
+            }
+            // Nothing due: screen for threshold excursions, else stay idle
+            // until the earliest sensor is due (_acqDeadline)
+            // Alarm search shares the OneWire search state; never interleave it with a pass
+            if (_alarmScreening && !_discoveryActive &&
+                millis() - _lastAlarmScreen >= ALARM_SCREEN_INTERVAL_MS)
+                _startAlarmScreen();
+            return false;
+
+        case AcquisitionPhase::SCREENING:
+            if ((long)(millis() - _acqDeadline) < 0) return false;
+            _finishAlarmScreen();
+            _acqPhase = AcquisitionPhase::IDLE;
+            return false;
+
+        case AcquisitionPhase::CONVERTING:
+        case AcquisitionPhase::READING: {
+            if (_rtdStartPending && (long)(millis() - _rtdStartAt) >= 0) _startRtdOneShots();
+            if (_activeGroup < 0) {
+                _activeGroup = _nextDueGroup();
+                if (_activeGroup < 0) {
+                    _acqPhase = AcquisitionPhase::CONVERTING;
+                    return false;
+                }
+                _groups[_activeGroup].state = ConversionGroupState::READING;
+            }
+            _acqPhase = AcquisitionPhase::READING;
+
+            int group = _activeGroup;
+            unsigned long sliceStart = micros();
+            do {
+                if (!_readNextSensor(group)) {
+                    // A group waiting on a PT1000 one-shot resumes later
+                    if (_groups[group].state == ConversionGroupState::READING) _finishGroup(group);
+                    break;
+                }
+            } while (micros() - sliceStart < _acqSliceBudgetUs);
+            return false;
+        }
+
+        case AcquisitionPhase::PUBLISH:
+            for (int b = 0; b < 4; ++b) {
+                if (_busReadStarted[b]) busTiming[b].sweepHistogram.record(busTiming[b].sweepMs);
+            }
+            _publishSweep();
+            _sampleAll = false;
+            _acqPhase = AcquisitionPhase::IDLE;
+            return true;
+    }
+    return false;
+}
+
+bool TemperatureController::_isSampleDue(Sensor* sensor, unsigned long now) const {
+    // Quarantined sensors are only read at their backoff re-probe, even in full sweeps
+    if (sensor->isQuarantined()) return sensor->isSampleDue(now);
+    return _sampleAll || !_adaptiveSampling || sensor->isSampleDue(now);
+}
+
+bool TemperatureController::_startConversions() {
+    unsigned long now = millis();
+    uint8_t busSensorCount[4] = {0, 0, 0, 0};
+    int8_t busSlowestGroup[4] = {-1, -1, -1, -1};
+    bool ptDue = false;
+    bool ptOneShot = false;
+    unsigned long earliestDue = now + SAMPLE_DEFAULT_MIN_PERIOD_MS;
+    for (auto& group : _groups) {
+        group.state = ConversionGroupState::IDLE;
+        group.sensorCount = 0;
+        group.passes = 0;
+        group.readIndex = 0;
+    }
+    _sweepSensors.clear();
     for (auto sensor : sensors) {
-        sensor->readTemperature();
+        if (!_isSampleDue(sensor, now)) {
+            if ((long)(sensor->getSampleDueAt() - earliestDue) < 0)
+                earliestDue = sensor->getSampleDueAt();
+            continue;
+        }
+        if (sensor->getType() != SensorType::DS18B20) {
+            ptDue = true;
+            if (sensor->beginRtdOneShot(now)) ptOneShot = true;
+            _sweepSensors.push_back(sensor);
+            continue;
+        }
+        int bus = getSensorBus(sensor);
+        if (bus < 0) continue;
+        int group = sensor->getResolution() - DS18B20_MIN_RESOLUTION;
+        busSensorCount[bus]++;
+        if (group > busSlowestGroup[bus]) busSlowestGroup[bus] = group;
+        _groups[group].sensorCount++;
+        _sweepSensors.push_back(sensor);
     }
 
-    for (auto& sensor : sensors) {
-        if (sensor->getErrorStatus() != 0) {
-            static std::map<Sensor*, unsigned long> lastErrorLog;
-            unsigned long now = millis();
-            
-            // Only log errors every 5 minutes to avoid spam
-            if (lastErrorLog[sensor] == 0 || (now - lastErrorLog[sensor]) > 300000) {
-                String sensorId = sensor->getType() == SensorType::DS18B20 ? 
-                    sensor->getDS18B20RomString() : 
-                    "BUS " + String(getSensorBus(sensor));
-                
-                LoggerManager::error("SENSOR", 
-                    "Sensor error detected: " + sensorId + 
-                    " (Error code: " + String(sensor->getErrorStatus()) + ")");
-                
-                lastErrorLog[sensor] = now;
+    bool dsDue = busSensorCount[0] || busSensorCount[1] || busSensorCount[2] || busSensorCount[3];
+    if (!dsDue && !ptDue) {
+        // Without sensors earliestDue is a full period away; the idle poll still
+        // wakes every ACQ_IDLE_POLL_MS to pick up new sensors
+        _acqDeadline = earliestDue;
+        return false;
+    }
+
+    // Start conversion on all populated buses at once (Skip-ROM + Convert-T).
+    // Each sensor converts at its own resolution.
+    for (int b = 0; b < 4; ++b) {
+        busTiming[b].sensorCount = busSensorCount[b];
+        _busReadStarted[b] = false;
+        // A parasite bus keeps the strong pull-up until its slowest device is
+        // done, so it is read in one pass with that device's group
+        _busReadGroup[b] = _busParasite[b] ? busSlowestGroup[b] : -1;
+        if (busSensorCount[b] == 0) continue;
+        busTiming[b].lastSweepStart = millis();
+        busTiming[b].conversionMs = 0;
+        busTiming[b].readMs = 0;
+        oneWireBuses[b]->lock();
+        oneWireBuses[b]->convertAll();
+        oneWireBuses[b]->unlock();
+    }
+
+    // One deadline per resolution group; the slowest populated group ends the sweep
+    now = millis();
+    _slowestGroup = -1;
+    for (int g = 0; g < 4; ++g) {
+        if (_groups[g].sensorCount == 0) continue;
+        _groups[g].state = ConversionGroupState::CONVERTING;
+        _groups[g].deadline = now + ds18b20ConversionTimeMs(g + DS18B20_MIN_RESOLUTION);
+        _slowestGroup = g;
+    }
+    if (_slowestGroup < 0) {
+        // No DS18B20: a zero-length group still carries the PT1000 reads
+        _slowestGroup = 0;
+        _groups[0].state = ConversionGroupState::CONVERTING;
+        _groups[0].deadline = now;
+    }
+
+    // Biased one-shot PT1000 channels: start after the bias settles, collect
+    // with the slowest group once the conversion is done
+    _rtdStartPending = ptOneShot;
+    if (ptOneShot) {
+        _rtdStartAt = now + RTD_BIAS_SETTLE_MS;
+        unsigned long ready = _rtdStartAt + RTD_ONESHOT_CONVERSION_MS;
+        if ((long)(ready - _groups[_slowestGroup].deadline) > 0)
+            _groups[_slowestGroup].deadline = ready;
+    }
+
+    _activeGroup = -1;
+    _nextDueGroup();
+    return true;
+}
+
+void TemperatureController::_writePendingAlarmLimits() {
+    for (auto sensor : sensors) {
+        if (sensor->getType() == SensorType::DS18B20 && sensor->isAlarmLimitsPending()) {
+            sensor->writeAlarmLimits();
+            return;
+        }
+    }
+}
+
+bool TemperatureController::_startAlarmScreen() {
+    uint8_t maxResolution[4] = {0, 0, 0, 0};
+    for (auto sensor : sensors) {
+        if (sensor->getType() != SensorType::DS18B20) continue;
+        int bus = getSensorBus(sensor);
+        if (bus >= 0 && sensor->getResolution() > maxResolution[bus])
+            maxResolution[bus] = sensor->getResolution();
+    }
+
+    // TH/TL flags are only updated by a conversion
+    _lastAlarmScreen = millis();
+    uint16_t conversionMs = 0;
+    for (int b = 0; b < 4; ++b) {
+        if (maxResolution[b] == 0) continue;
+        oneWireBuses[b]->lock();
+        oneWireBuses[b]->convertAll();
+        oneWireBuses[b]->unlock();
+        conversionMs = max(conversionMs, ds18b20ConversionTimeMs(maxResolution[b]));
+    }
+    if (conversionMs == 0) return false;
+
+    _acqDeadline = millis() + conversionMs;
+    _acqPhase = AcquisitionPhase::SCREENING;
+    return true;
+}
+
+void TemperatureController::_finishAlarmScreen() {
+    for (int b = 0; b < 4; ++b) {
+        if (_busSensors[b].empty()) continue;
+
+        OneWireInterface* bus = oneWireBuses[b];
+        uint8_t rom[8];
+        bus->lock();
+        bus->resetSearch();
+        // Alarm Search (0xEC): only flagged devices answer
+        while (bus->search(rom, true)) {
+            if (oneWireCrc8(rom, 7) != rom[7]) continue;
+            Sensor* sensor = findSensorByRom(rom);
+            if (sensor) {
+                sensor->requestSample();
+                _alarmScreenHits++;
+            }
+        }
+        bus->unlock();
+    }
+}
+
+bool TemperatureController::_discoveryStep() {
+    if (!_discoveryActive) {
+        if ((long)(millis() - _discoveryNextPass) < 0) return false;
+        _discoveryActive = true;
+        _discoveryBus = 0;
+        _discoveryBusStarted = false;
+    }
+
+    uint8_t b = _discoveryBus;
+    OneWireInterface* bus = oneWireBuses[b];
+    if (!_discoveryBusStarted) {
+        for (auto sensor : _busSensors[b])
+            sensor->beginSearchPass();
+        bus->lock();
+        bus->resetSearch();
+        bus->unlock();
+        _discoveryBusStarted = true;
+    }
+
+    DiscoveryEvent event;
+    event.bus = b;
+    bus->lock();
+    bool found = bus->search(event.rom);
+    bus->unlock();
+
+    if (found) {
+        if (oneWireCrc8(event.rom, 7) != event.rom[7] ||
+            !oneWireValidFamily(event.rom)) return true;
+
+        Sensor* known = findSensorByRom(event.rom);
+        if (known == nullptr || getSensorBus(known) != b) {
+            event.type = DiscoveryEventType::ADDED;
+            _discoveryEvents.push(event);
+        } else if (known->markSearchSeen() >= DISCOVERY_MISSES_TO_VANISH) {
+            event.type = DiscoveryEventType::REAPPEARED;
+            _discoveryEvents.push(event);
+        }
+        return true;
+    }
+
+    // Search exhausted on this bus: count misses, report each vanish once
+    for (auto sensor : _busSensors[b]) {
+        if (sensor->endSearchPass() == DISCOVERY_MISSES_TO_VANISH) {
+            event.type = DiscoveryEventType::VANISHED;
+            memcpy(event.rom, sensor->getDS18B20Address(), 8);
+            _discoveryEvents.push(event);
+        }
+    }
+    _discoveryBusStarted = false;
+    if (++_discoveryBus >= 4) {
+        _discoveryActive = false;
+        _discoveryPasses++;
+        _discoveryNextPass = millis() + DISCOVERY_PASS_INTERVAL_MS;
+    }
+    return true;
+}
+
+void TemperatureController::_processDiscoveryEvents() {
+    DiscoveryEvent event;
+    while (_discoveryEvents.pop(event)) {
+        char buf[17];
+        for (int i = 0; i < 8; ++i) sprintf(buf + i * 2, "%02X", event.rom[i]);
+        String romString(buf);
+        Sensor* sensor = findSensorByRom(event.rom);
+
+        int boundPoint = -1;
+        for (uint8_t i = 0; sensor && i < _points.getDS18B20Count(); ++i) {
+            if (_points[i].getBoundSensor() == sensor) {
+                boundPoint = _points[i].getAddress();
+                break;
             }
         }
+
+        switch (event.type) {
+            case DiscoveryEventType::ADDED: {
+                if (sensor) {
+                    if (getSensorBus(sensor) == event.bus) break;
+                    // Moved to another bus: re-create on the new bus, keep the binding
+                    removeSensorByRom(romString);
+                }
+                Sensor* newSensor = new Sensor(SensorType::DS18B20, 0, "DS18B20_" + romString);
+                newSensor->setupDS18B20(oneWireBuses[event.bus], event.rom);
+                if (newSensor->initialize() && addSensor(newSensor)) {
+                    _forgetFailedRom(event.rom);
+                    // Re-probe the power mode for the newcomer; the probe enumerates
+                    // the bus, so the background pass is restarted
+                    _lockSensors();
+                    _discoveryActive = false;
+                    oneWireBuses[event.bus]->lock();
+                    _busParasite[event.bus] = oneWireBuses[event.bus]->begin();
+                    oneWireBuses[event.bus]->unlock();
+                    _unlockSensors();
+                    if (boundPoint >= 0) bindSensorToPointByRom(romString, boundPoint);
+                    LoggerManager::info("DISCOVERY",
+                        "Sensor attached on bus " + String(event.bus) + ": " + romString);
+                } else {
+                    delete newSensor;
+                    // Retried every pass; warn only when this ROM starts failing
+                    if (_rememberFailedRom(event)) {
+                        LoggerManager::warning("DISCOVERY",
+                            "Sensor found on bus " + String(event.bus) + " but failed to initialize: " + romString);
+                    }
+                }
+                break;
+            }
+
+            case DiscoveryEventType::VANISHED:
+                if (!sensor) break;
+                if (boundPoint >= 0) {
+                    // Keep it so the point reports the disconnection and rebinds on return
+                    LoggerManager::warning("DISCOVERY",
+                        "Sensor vanished from bus " + String(event.bus) + ": " + romString +
+                        " (bound to point " + String(boundPoint) + ")");
+                } else {
+                    removeSensorByRom(romString);
+                    LoggerManager::info("DISCOVERY",
+                        "Sensor removed from bus " + String(event.bus) + ": " + romString);
+                }
+                break;
+
+            case DiscoveryEventType::REAPPEARED:
+                if (!sensor) break;
+                sensor->requestSample();
+                LoggerManager::info("DISCOVERY",
+                    "Sensor reconnected on bus " + String(event.bus) + ": " + romString);
+                break;
+        }
+    }
+}
+
+bool TemperatureController::_rememberFailedRom(const DiscoveryEvent& event) {
+    for (uint8_t i = 0; i < _failedRomCount; ++i) {
+        if (memcmp(_failedRoms[i].rom, event.rom, 8) != 0) continue;
+        if (_failedRoms[i].bus == event.bus) return false;
+        _failedRoms[i].bus = event.bus;
+        return true;
     }
+    if (_failedRomCount < DISCOVERY_FAILED_ROM_SLOTS) {
+        _failedRoms[_failedRomCount++] = event;
+    } else {
+        _failedRoms[_failedRomNext] = event;
+        _failedRomNext = (_failedRomNext + 1) % DISCOVERY_FAILED_ROM_SLOTS;
+    }
+    return true;
+}
+
+void TemperatureController::_forgetFailedRom(const uint8_t* rom) {
+    for (uint8_t i = 0; i < _failedRomCount; ++i) {
+        if (memcmp(_failedRoms[i].rom, rom, 8) == 0) {
+            _failedRoms[i] = _failedRoms[--_failedRomCount];
+            if (_failedRomNext >= _failedRomCount) _failedRomNext = 0;
+            return;
+        }
+    }
+}
+
+int TemperatureController::_nextDueGroup() {
+    unsigned long now = millis();
+    int due = -1;
+    bool pending = false;
+    for (int g = 0; g < 4; ++g) {
+        if (_groups[g].state != ConversionGroupState::CONVERTING) continue;
+        if (due < 0 && (long)(now - _groups[g].deadline) >= 0) due = g;
+        if (!pending || (long)(_groups[g].deadline - _acqDeadline) < 0) {
+            _acqDeadline = _groups[g].deadline;
+            pending = true;
+        }
+    }
+    if (_rtdStartPending && (long)(_rtdStartAt - _acqDeadline) < 0) _acqDeadline = _rtdStartAt;
+    return due;
+}
+
+void TemperatureController::_startRtdOneShots() {
+    unsigned long now = millis();
+    for (auto sensor : _sweepSensors) {
+        if (sensor && sensor->getType() == SensorType::PT1000) sensor->startRtdOneShot(now);
+    }
+    _rtdStartPending = false;
+}
+
+bool TemperatureController::_readNextSensor(int group) {
+    ConversionGroup& current = _groups[group];
+    while (current.readIndex < _sweepSensors.size()) {
+        Sensor* sensor = _sweepSensors[current.readIndex++];
+        if (sensor == nullptr) continue;
+
+        if (sensor->getType() == SensorType::PT1000) {
+            // PT1000 channels are read once per sweep, with the slowest group
+            if (group != _slowestGroup) continue;
+            if (sensor->collectRtdOneShot(millis()) == RtdCollectResult::PENDING) {
+                // Not converted yet: retry this sensor at its next step
+                current.readIndex--;
+                current.state = ConversionGroupState::CONVERTING;
+                current.deadline = sensor->getRtdOneShotStepAt();
+                _activeGroup = -1;
+                _acqPhase = AcquisitionPhase::CONVERTING;
+                _nextDueGroup();
+                return false;
+            }
+            return true;
+        }
+
+        // Skip sensors no longer on a bus converted in this sweep
+        int bus = getSensorBus(sensor);
+        if (bus < 0 || busTiming[bus].sensorCount == 0) continue;
+
+        int readGroup = _busReadGroup[bus] >= 0 ? _busReadGroup[bus]
+                                                 : sensor->getResolution() - DS18B20_MIN_RESOLUTION;
+        if (readGroup != group) continue;
+        // Resample passes read only the sensors _finishGroup() converted again
+        if (current.passes > 0 && !_isSampleDue(sensor, millis())) continue;
+
+        unsigned long readStart = millis();
+        sensor->readConvertedTemperature();
+        unsigned long readEnd = millis();
+
+        BusTiming& timing = busTiming[bus];
+        if (!_busReadStarted[bus]) {
+            timing.conversionMs = readStart - timing.lastSweepStart;
+            _busReadStarted[bus] = true;
+        }
+        timing.readMs += readEnd - readStart;
+        timing.sweepMs = readEnd - timing.lastSweepStart;
+        return true;
+    }
+    return false;
+}
+
+void TemperatureController::_finishGroup(int group) {
+    ConversionGroup& current = _groups[group];
+    current.passes++;
+    _activeGroup = -1;
+
+    // Resample a fast group if another conversion completes before the slow one
+    uint16_t conversionMs = ds18b20ConversionTimeMs(group + DS18B20_MIN_RESOLUTION);
+    unsigned long nextDeadline = millis() + conversionMs;
+    bool resample = false;
+    if (group != _slowestGroup &&
+        (long)(_groups[_slowestGroup].deadline - nextDeadline) >= 0) {
+        // Only sensors of this sweep whose interval ends by then are converted
+        // again; Match-ROM traffic would cut a parasite bus's strong pull-up
+        for (auto sensor : _sweepSensors) {
+            if (!sensor || sensor->getType() != SensorType::DS18B20 ||
+                sensor->getResolution() - DS18B20_MIN_RESOLUTION != group) continue;
+            int bus = getSensorBus(sensor);
+            if (bus < 0 || _busReadGroup[bus] >= 0 || !_isSampleDue(sensor, nextDeadline)) continue;
+            if (!resample) _publishSweep();
+            resample = true;
+            sensor->startConversion();
+        }
+    }
+    if (resample) {
+        current.deadline = millis() + conversionMs;
+        current.state = ConversionGroupState::CONVERTING;
+        current.readIndex = 0;
+    } else {
+        current.state = ConversionGroupState::DONE;
+    }
+
+    for (const auto& g : _groups) {
+        if (g.state == ConversionGroupState::CONVERTING ||
+            g.state == ConversionGroupState::READING) {
+            _acqPhase = AcquisitionPhase::CONVERTING;
+            _nextDueGroup();
+            return;
+        }
+    }
+    _acqPhase = AcquisitionPhase::PUBLISH;
+}
+
+void TemperatureController::_publishSweep() {
+    PointSample* samples = _pointSnapshot.beginWrite();
+    for (uint16_t i = 0; i < _points.size(); ++i) {
+        Sensor* sensor = _points[i].getBoundSensor();
+        samples[i].bound = sensor ? 1 : 0;
+        samples[i].currentTemp = sensor ? sensor->getCurrentTemp() : 0;
+        samples[i].errorStatus = sensor ? sensor->getErrorStatus() : 0x01;
+    }
+    _pointSnapshot.publish();
+}
+
+void TemperatureController::_logSensorErrors() {
+    // Edge-triggered: each error is logged when raised and when it clears;
+    // communication / disconnect onsets are rate-limited per sensor
+    const uint8_t linkErrors = ERROR_COMMUNICATION | ERROR_DISCONNECTED;
+    unsigned long now = millis();
+    for (auto sensor : sensors) {
+        uint8_t cleared;
+        uint8_t raised = sensor->takeErrorChanges(cleared);
+        if (!raised && !cleared) continue;
+
+        String sensorId = sensor->getType() == SensorType::DS18B20 ? 
+            sensor->getDS18B20RomString() : 
+            "BUS " + String(getSensorBus(sensor));
+
+        if (raised & ERROR_QUARANTINED) {
+            LoggerManager::error("SENSOR", 
+                "Sensor quarantined after " + String(sensor->getConsecutiveFailures()) +
+                " failed reads: " + sensorId + " (Error code: " + String(sensor->getErrorStatus()) +
+                ", re-probe in " + String(sensor->getQuarantineBackoff() / 1000) + " s)");
+        }
+        // Re-probe failures while quarantined are expected, quarantine entry covers them
+        if ((raised & linkErrors) && !sensor->isQuarantined() && sensor->claimLinkErrorLog(now)) {
+            LoggerManager::error("SENSOR", 
+                String((raised & ERROR_DISCONNECTED) ? "Sensor disconnected: " : "Sensor communication error: ") +
+                sensorId + " (Error code: " + String(sensor->getErrorStatus()) + ")");
+        }
+        if (raised & ERROR_OUT_OF_RANGE) {
+            LoggerManager::error("SENSOR", 
+                "Sensor reading out of range: " + sensorId + 
+                " (Error code: " + String(sensor->getErrorStatus()) + ")");
+        }
+        if (cleared & ERROR_QUARANTINED) {
+            sensor->takeLinkErrorRecovery();
+            LoggerManager::info("SENSOR", "Sensor recovered from quarantine: " + sensorId);
+        } else if ((cleared & linkErrors) && !(sensor->getErrorStatus() & linkErrors) &&
+                   sensor->takeLinkErrorRecovery()) {
+            LoggerManager::info("SENSOR", "Sensor communication restored: " + sensorId);
+        }
+    }
+}
+
+void TemperatureController::_updateHealthRegisters() {
+    uint16_t quarantined = 0;
+    uint16_t inError = 0;
+    HealthCounters total;
+    for (auto sensor : sensors) {
+        if (sensor->isQuarantined()) quarantined++;
+        if (sensor->getErrorStatus() != 0) inError++;
+        total.merge(sensor->getHealth());
+    }
+
+    uint16_t sweepMs = 0;
+    for (int b = 0; b < 4; ++b) {
+        if (busTiming[b].sweepMs > sweepMs) sweepMs = busTiming[b].sweepMs;
+    }
+
+    // Stalest bound sensor: a dead point shows here before it raises an alarm
+    uint32_t now = millis();
+    uint32_t stalestS = 0;
+    for (const MeasurementPoint& point : _points) {
+        Sensor* sensor = point.getBoundSensor();
+        if (!sensor) continue;
+        uint32_t lastGood = sensor->getHealth().lastGoodMs;
+        uint32_t ageS = lastGood ? (now - lastGood) / 1000 : 0xFFFF;
+        if (ageS > stalestS) stalestS = ageS;
+    }
+
+    registerMap.setDeviceStatus(RegisterMap::HEALTH_QUARANTINED_REG, quarantined);
+    registerMap.setDeviceStatus(RegisterMap::HEALTH_SENSOR_ERRORS_REG, inError);
+    registerMap.setDeviceStatus(RegisterMap::HEALTH_CRC_ERRORS_REG, std::min<uint32_t>(total.crcErrors, 0xFFFF));
+    registerMap.setDeviceStatus(RegisterMap::HEALTH_TIMEOUTS_REG, std::min<uint32_t>(total.timeouts, 0xFFFF));
+    registerMap.setDeviceStatus(RegisterMap::HEALTH_SWEEP_MS_REG, sweepMs);
+    registerMap.setDeviceStatus(RegisterMap::HEALTH_READ_P95_US_REG, std::min<uint32_t>(total.readUs.percentile(95), 0xFFFF));
+    registerMap.setDeviceStatus(RegisterMap::HEALTH_STALEST_S_REG, std::min<uint32_t>(stalestS, 0xFFFF));
+}
+
+HealthCounters TemperatureController::getBusHealth(uint8_t bus) const {
+    HealthCounters total;
+    if (bus >= 4) return total;
+    for (auto sensor : _busSensors[bus])
+        total.merge(sensor->getHealth());
+    return total;
+}
+
+HealthCounters TemperatureController::getChipSelectHealth(uint8_t channel) const {
+    HealthCounters total;
+    if (channel >= 4 || chipSelectPin[channel] >= SENSOR_CS_INDEX_SIZE) return total;
+    Sensor* sensor = _csIndex[chipSelectPin[channel]];
+    if (sensor) total.merge(sensor->getHealth());
+    return total;
+}
+
+void TemperatureController::_addHealthJson(JsonObject obj, const HealthCounters& health) {
+    obj["reads"] = health.reads;
+    obj["failures"] = health.failures;
+    obj["crcErrors"] = health.crcErrors;
+    obj["retries"] = health.retries;
+    obj["timeouts"] = health.timeouts;
+    obj["quarantines"] = health.quarantines;
+    obj["lastGoodMs"] = health.lastGoodMs;
+    obj["readP50Us"] = health.readUs.percentile(50);
+    obj["readP95Us"] = health.readUs.percentile(95);
+    obj["readMaxUs"] = health.readUs.maxValue;
+    JsonArray buckets = obj.createNestedArray("readHistogram");
+    for (uint8_t b = 0; b < LogHistogram<HEALTH_READ_BASE_US>::BUCKETS; ++b)
+        buckets.add(health.readUs.counts[b]);
+}
+
+bool TemperatureController::startAcquisitionTask(BaseType_t core, UBaseType_t priority) {
+    if (_acqTask != nullptr) return true;
+    if (_sensorsMutex == nullptr) {
+        LoggerManager::error("SENSOR", "Acquisition task not started: sensor mutex unavailable");
+        return false;
+    }
+
+    BaseType_t created = xTaskCreatePinnedToCore(
+        _acquisitionTaskEntry, "sensor_acq", 4096, this, priority, &_acqTask, core);
+    if (created != pdPASS) {
+        _acqTask = nullptr;
+        LoggerManager::error("SENSOR", "Failed to create sensor acquisition task");
+        return false;
+    }
+
+    LoggerManager::info("SENSOR", 
+        "Sensor acquisition task started on core " + String(core) + 
+        ", priority " + String(priority));
+    return true;
+}
+
+void TemperatureController::_acquisitionTaskEntry(void* arg) {
+    static_cast<TemperatureController*>(arg)->_acquisitionTaskLoop();
+}
+
+void TemperatureController::_acquisitionTaskLoop() {
+    for (;;) {
+        if (acquisitionMode == AcquisitionMode::BUS_SWEEP) {
+            _lockSensors();
+            _stepAcquisition();
+            _unlockSensors();
+        } else {
+            updateAllSensors();
+        }
+
+        // Sleep through the conversion instead of polling the deadline
+        if (_acqPhase == AcquisitionPhase::CONVERTING || _acqPhase == AcquisitionPhase::SCREENING) {
+            long remaining = (long)(_acqDeadline - millis());
+            vTaskDelay(pdMS_TO_TICKS(remaining > 0 ? remaining : 1));
+        } else if (_acqPhase == AcquisitionPhase::IDLE) {
+            // Nothing due; wake periodically to pick up new sensors and settings
+            long remaining = _discoveryActive ? 1 : (long)(_acqDeadline - millis());
+            if (remaining > ACQ_IDLE_POLL_MS) remaining = ACQ_IDLE_POLL_MS;
+            vTaskDelay(pdMS_TO_TICKS(remaining > 0 ? remaining : 1));
+        } else {
+            vTaskDelay(1);
+        }
+    }
+}
+
+void TemperatureController::_lockSensors() {
+    if (_sensorsMutex) xSemaphoreTakeRecursive(_sensorsMutex, portMAX_DELAY);
+}
+
+void TemperatureController::_unlockSensors() {
+    if (_sensorsMutex) xSemaphoreGiveRecursive(_sensorsMutex);
 }
 
 uint8_t TemperatureController::getOneWirePin(size_t bus) {
@@ -1515,25 +2645,19 @@ bool TemperatureController::unbindSensorFromPointBySensor(Sensor* sensor) {
     
     bool anyUnbound = false;
     
-    // Search through all DS18B20 points
-    for (auto& point : dsPoints) {
-        if (point.getBoundSensor() == sensor) {
-            point.unbindSensor();
-            Serial.printf("Unbound sensor %s from DS18B20 point %d\n", 
-                         sensor->getName().c_str(), point.getAddress());
-            anyUnbound = true;
-        }
-    }
-    
-    // Search through all PT1000 points
-    for (auto& point : ptPoints) {
+    // Search through all DS18B20 and PT1000 points
+    _lockSensors();
+    for (auto& point : _points) {
         if (point.getBoundSensor() == sensor) {
             point.unbindSensor();
-            Serial.printf("Unbound sensor %s from PT1000 point %d\n", 
-                         sensor->getName().c_str(), point.getAddress());
+            Serial.printf("Unbound sensor %s from %s point %d\n", 
+                         sensor->getName().c_str(),
+                         isPT1000Address(point.getAddress()) ? "PT1000" : "DS18B20",
+                         point.getAddress());
             anyUnbound = true;
         }
     }
+    _unlockSensors();
     
     return anyUnbound;
 }
@@ -1545,16 +2669,14 @@ bool TemperatureController::addAlarm(AlarmType type, uint8_t pointAddress, Alarm
     if (!point) return false;
     
     // Check if alarm already exists
-    String configKey = "alarm_" + String(pointAddress) + "_" + String(static_cast<int>(type));
-    
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->getConfigKey() == configKey) {
-            // Update existing
-            alarm->setPriority(priority);
-            alarm->setEnabled(true);
-            return true;
-        }
+    Alarm* alarm = _alarmSlots.get(pointAddress, type);
+    if (alarm) {
+        // Update existing
+        alarm->setPriority(priority);
+        alarm->setEnabled(true);
+        return true;
     }
+    String configKey = "alarm_" + String(pointAddress) + "_" + String(static_cast<int>(type));
     
     // Create new alarm
     Alarm* newAlarm = new Alarm(type, point, priority);
@@ -1580,7 +2702,7 @@ bool TemperatureController::addAlarm(AlarmType type, uint8_t pointAddress, Alarm
         newAlarm->setAcknowledgedDelay(delay);
     }
     newAlarm->setConfigKey(configKey);
-    _configuredAlarms.push_back(newAlarm);
+    _registerAlarm(newAlarm);
     
     Serial.printf("Added alarm configuration: %s\n", configKey.c_str());
     if (newAlarm) {
@@ -1599,10 +2721,15 @@ bool TemperatureController::addAlarm(AlarmType type, uint8_t pointAddress, Alarm
 }
 
 bool TemperatureController::removeAlarm(const String& configKey) {
-    for (auto it = _configuredAlarms.begin(); it != _configuredAlarms.end(); ++it) {
-        if ((*it)->getConfigKey() == configKey) {
-            
-            delete *it;
+    Alarm* alarm = findAlarm(configKey);
+    if (alarm) {
+        auto it = std::find(_configuredAlarms.begin(), _configuredAlarms.end(), alarm);
+        if (it != _configuredAlarms.end()) {
+            if (_currentDisplayedAlarm == alarm) {
+                _currentDisplayedAlarm = nullptr;
+            }
+            _alarmSlots.erase(alarm);
+            delete alarm;
             _configuredAlarms.erase(it);
             Serial.printf("Removed alarm configuration: %s\n", configKey.c_str());
             LoggerManager::info("ALARM_CONFIG", 
@@ -1624,12 +2751,10 @@ bool TemperatureController::updateAlarm(const String& configKey, AlarmPriority p
 }
 
 Alarm* TemperatureController::findAlarm(const String& configKey) {
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->getConfigKey() == configKey) {
-            return alarm;
-        }
-    }
-    return nullptr;
+    uint8_t address;
+    AlarmType type;
+    if (!AlarmSlotTable::parseConfigKey(configKey.c_str(), address, type)) return nullptr;
+    return _alarmSlots.get(address, type);
 }
 
 Alarm* TemperatureController::getAlarmByIndex(int idx) {
@@ -1671,7 +2796,9 @@ bool TemperatureController::bindSensorToPointByBusNumber(uint8_t busNumber, uint
             if (sensorBus == busNumber) {
                 MeasurementPoint* point = getMeasurementPoint(pointAddress);
                 if (point) {
+                    _lockSensors();
                     point->bindSensor(sensor);
+                    _unlockSensors();
                     
                     LoggerManager::info("BINDING", 
                         "PT1000 sensor on bus " + String(busNumber) + 
@@ -1794,78 +2921,19 @@ void TemperatureController::applyAcknowledgedDelaysToAlarms() {
 // }
 
 
-// Add these method implementations to TemperatureController.cpp
-int TemperatureController::getAlarmCount(AlarmPriority priority, const String& comparison) const {
-    int count = 0;
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->isEnabled() && _comparePriority(alarm->getPriority(), priority, comparison)) {
-            count++;
-        }
-    }
-    return count;
+int TemperatureController::getAlarmCount(AlarmPriority priority, AlarmCompare comparison) const {
+    return _alarmCounters.countPriority(static_cast<uint8_t>(priority), comparison);
 }
 
-int TemperatureController::getAlarmCount(AlarmStage stage, const String& comparison) const {
-    int count = 0;
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->isEnabled() && _compareStage(alarm->getStage(), stage, comparison)) {
-            count++;
-        }
-    }
-    return count;
+int TemperatureController::getAlarmCount(AlarmStage stage, AlarmCompare comparison) const {
+    return _alarmCounters.countStage(static_cast<uint8_t>(stage), comparison);
 }
 
 int TemperatureController::getAlarmCount(AlarmPriority priority, AlarmStage stage, 
-                                       const String& priorityComparison, 
-                                       const String& stageComparison) const {
-    int count = 0;
-    for (auto alarm : _configuredAlarms) {
-        if (alarm->isEnabled() && 
-            _comparePriority(alarm->getPriority(), priority, priorityComparison) &&
-            _compareStage(alarm->getStage(), stage, stageComparison)) {
-            count++;
-        }
-    }
-    return count;
-}
-
-// Add these helper method implementations to TemperatureController.cpp
-bool TemperatureController::_comparePriority(AlarmPriority alarmPriority, AlarmPriority targetPriority, const String& comparison) const {
-    int alarmValue = static_cast<int>(alarmPriority);
-    int targetValue = static_cast<int>(targetPriority);
-    
-    if (comparison == ">" || comparison == "gt") {
-        return alarmValue > targetValue;
-    } else if (comparison == ">=" || comparison == "gte") {
-        return alarmValue >= targetValue;
-    } else if (comparison == "<" || comparison == "lt") {
-        return alarmValue < targetValue;
-    } else if (comparison == "<=" || comparison == "lte") {
-        return alarmValue <= targetValue;
-    } else if (comparison == "!=" || comparison == "ne") {
-        return alarmValue != targetValue;
-    } else { // Default to "==" or "eq"
-        return alarmValue == targetValue;
-    }
-}
-
-bool TemperatureController::_compareStage(AlarmStage alarmStage, AlarmStage targetStage, const String& comparison) const {
-    int alarmValue = static_cast<int>(alarmStage);
-    int targetValue = static_cast<int>(targetStage);
-    
-    if (comparison == ">" || comparison == "gt") {
-        return alarmValue > targetValue;
-    } else if (comparison == ">=" || comparison == "gte") {
-        return alarmValue >= targetValue;
-    } else if (comparison == "<" || comparison == "lt") {
-        return alarmValue < targetValue;
-    } else if (comparison == "<=" || comparison == "lte") {
-        return alarmValue <= targetValue;
-    } else if (comparison == "!=" || comparison == "ne") {
-        return alarmValue != targetValue;
-    } else { // Default to "==" or "eq"
-        return alarmValue == targetValue;
-    }
+                                       AlarmCompare priorityComparison, 
+                                       AlarmCompare stageComparison) const {
+    return _alarmCounters.count(static_cast<uint8_t>(priority), priorityComparison,
+                                static_cast<uint8_t>(stage), stageComparison);
 }
 
 
@@ -1900,50 +2968,14 @@ void TemperatureController::handleAlarmDisplay() {
     indicator.updateBlinking();
 }
 
-void TemperatureController::_updateAlarmQueues() {
-    _activeAlarmsQueue.clear();
-    _acknowledgedAlarmsQueue.clear();
-    
-    // Get all active alarms from the system
-    std::vector<Alarm*> allActiveAlarms = getActiveAlarms();
-    
-    // Separate alarms into active and acknowledged queues
-    for (auto alarm : allActiveAlarms) {
-        if (!alarm) continue;
-        
-        if (alarm->getStage() == AlarmStage::ACTIVE) {
-            _activeAlarmsQueue.push_back(alarm);
-        } else if (alarm->getStage() == AlarmStage::ACKNOWLEDGED) {
-            _acknowledgedAlarmsQueue.push_back(alarm);
-        }
-    }
-    
-    // Sort active alarms by priority (highest first), then by timestamp (oldest first)
-    std::sort(_activeAlarmsQueue.begin(), _activeAlarmsQueue.end(), 
-              [](const Alarm* a, const Alarm* b) {
-                  if (a->getPriority() != b->getPriority()) {
-                      return static_cast<int>(a->getPriority()) > static_cast<int>(b->getPriority());
-                  }
-                  return a->getTimestamp() < b->getTimestamp();
-              });
-    
-    // Sort acknowledged alarms by priority (highest first), then by timestamp (oldest first)
-    std::sort(_acknowledgedAlarmsQueue.begin(), _acknowledgedAlarmsQueue.end(),
-              [](const Alarm* a, const Alarm* b) {
-                  if (a->getPriority() != b->getPriority()) {
-                      return static_cast<int>(a->getPriority()) > static_cast<int>(b->getPriority());
-                  }
-                  return a->getTimestamp() < b->getTimestamp();
-              });
-}
 void TemperatureController::_displayNextActiveAlarm() {
-    if (_activeAlarmsQueue.empty()) return;
+    if (_alarmQueues.empty(ALARM_QUEUE_ACTIVE)) return;
     
-    if (_currentActiveAlarmIndex >= _activeAlarmsQueue.size()) {
+    if (_currentActiveAlarmIndex >= _alarmQueues.size(ALARM_QUEUE_ACTIVE)) {
         _currentActiveAlarmIndex = 0;
     }
     
-    _currentDisplayedAlarm = _activeAlarmsQueue[_currentActiveAlarmIndex];
+    _currentDisplayedAlarm = _alarmQueues.at(ALARM_QUEUE_ACTIVE, _currentActiveAlarmIndex);
     _showingOK = false;
     
     // Ensure OLED is turned on whenever an alarm is displayed
@@ -1956,7 +2988,7 @@ void TemperatureController::_displayNextActiveAlarm() {
     String line2 = displayText.substring(newlineIndex + 1);
     
     // Create bottom line with alarm counter and alarm activation timestamp
-    String line3 = String(_currentActiveAlarmIndex + 1) + "/" + String(_activeAlarmsQueue.size());
+    String line3 = String(_currentActiveAlarmIndex + 1) + "/" + String(_alarmQueues.size(ALARM_QUEUE_ACTIVE));
     line3 += "  ";
     
     // Get alarm activation timestamp
@@ -1996,16 +3028,16 @@ void TemperatureController::_displayNextActiveAlarm() {
     
     Serial.printf("Displaying active alarm %d/%d: %s\n", 
                   _currentActiveAlarmIndex + 1,
-                  _activeAlarmsQueue.size(),
+                  _alarmQueues.size(ALARM_QUEUE_ACTIVE),
                   displayText.c_str());
 }
 
 void TemperatureController::_displayNextAcknowledgedAlarm() {
-    if (_acknowledgedAlarmsQueue.empty()) return;
+    if (_alarmQueues.empty(ALARM_QUEUE_ACKNOWLEDGED)) return;
     
-    _currentAcknowledgedAlarmIndex = (_currentAcknowledgedAlarmIndex + 1) % _acknowledgedAlarmsQueue.size();
+    _currentAcknowledgedAlarmIndex = (_currentAcknowledgedAlarmIndex + 1) % _alarmQueues.size(ALARM_QUEUE_ACKNOWLEDGED);
     
-    _currentDisplayedAlarm = _acknowledgedAlarmsQueue[_currentAcknowledgedAlarmIndex];
+    _currentDisplayedAlarm = _alarmQueues.at(ALARM_QUEUE_ACKNOWLEDGED, _currentAcknowledgedAlarmIndex);
     _lastAlarmDisplayTime = millis();
     _showingOK = false;
     
@@ -2021,7 +3053,7 @@ void TemperatureController::_displayNextAcknowledgedAlarm() {
     // Remove ACK from line1 - it's already shown in line2
     
     // Create bottom line with alarm counter and alarm activation timestamp
-    String line3 = String(_currentAcknowledgedAlarmIndex + 1) + "/" + String(_acknowledgedAlarmsQueue.size());
+    String line3 = String(_currentAcknowledgedAlarmIndex + 1) + "/" + String(_alarmQueues.size(ALARM_QUEUE_ACKNOWLEDGED));
     line3 += "  ";
     
     // Get alarm activation timestamp
@@ -2062,14 +3094,14 @@ void TemperatureController::_displayNextAcknowledgedAlarm() {
     Serial.printf("Displaying acknowledged alarm: %s (%d/%d)\n",
                   displayText.c_str(),
                   _currentAcknowledgedAlarmIndex + 1,
-                  _acknowledgedAlarmsQueue.size());
+                  _alarmQueues.size(ALARM_QUEUE_ACKNOWLEDGED));
 }
 
 void TemperatureController::_handleAlarmDisplayRotation() {
     unsigned long currentTime = millis();
     
     // Priority 1: Display active alarms first
-    if (!_activeAlarmsQueue.empty()) {
+    if (!_alarmQueues.empty(ALARM_QUEUE_ACTIVE)) {
         _displayingActiveAlarm = true;
         _currentAcknowledgedAlarmIndex = 0;
         
@@ -2079,7 +3111,7 @@ void TemperatureController::_handleAlarmDisplayRotation() {
         
         if (_currentDisplayedAlarm && _currentDisplayedAlarm->getStage() == AlarmStage::ACKNOWLEDGED) {
             _currentActiveAlarmIndex++;
-            if (_currentActiveAlarmIndex >= _activeAlarmsQueue.size()) {
+            if (_currentActiveAlarmIndex >= _alarmQueues.size(ALARM_QUEUE_ACTIVE)) {
                 _currentActiveAlarmIndex = 0;
             }
         }
@@ -2087,7 +3119,7 @@ void TemperatureController::_handleAlarmDisplayRotation() {
     }
     
     // Priority 2: Display acknowledged alarms in round-robin
-    if (!_acknowledgedAlarmsQueue.empty()) {
+    if (!_alarmQueues.empty(ALARM_QUEUE_ACKNOWLEDGED)) {
         _displayingActiveAlarm = false;
         
         // Always turn on OLED when there are acknowledged alarms
@@ -2179,7 +3211,7 @@ void TemperatureController::_checkButtonPress() {
                         
                         // Move to next active alarm
                         _currentActiveAlarmIndex++;
-                        if (_currentActiveAlarmIndex >= _activeAlarmsQueue.size()) {
+                        if (_currentActiveAlarmIndex >= _alarmQueues.size(ALARM_QUEUE_ACTIVE)) {
                             _currentActiveAlarmIndex = 0;
                         }
                         
@@ -2195,11 +3227,11 @@ void TemperatureController::_checkButtonPress() {
                     
                 case SECTION_ACK_ALARMS:
                     // Cycle through acknowledged alarms
-                    if (!_acknowledgedAlarmsQueue.empty()) {
+                    if (!_alarmQueues.empty(ALARM_QUEUE_ACKNOWLEDGED)) {
                         // Just call _displayNextAcknowledgedAlarm() which handles incrementing the index
                         _displayNextAcknowledgedAlarm();
                         Serial.printf("Short press - Cycling to acknowledged alarm %d/%d\n", 
-                                    _currentAcknowledgedAlarmIndex + 1, _acknowledgedAlarmsQueue.size());
+                                    _currentAcknowledgedAlarmIndex + 1, _alarmQueues.size(ALARM_QUEUE_ACKNOWLEDGED));
                     }
                     break;
                     
@@ -2303,11 +3335,7 @@ bool TemperatureController::getRelayCommandedState(uint8_t relayNumber) const {
         case 1: {
             // Relay1 (Siren) - on for ANY active alarm of ANY priority
             // Turns off only when ALL alarms are acknowledged
-            int totalActive = getAlarmCount(AlarmPriority::PRIORITY_LOW, AlarmStage::ACTIVE) +
-                              getAlarmCount(AlarmPriority::PRIORITY_MEDIUM, AlarmStage::ACTIVE) +
-                              getAlarmCount(AlarmPriority::PRIORITY_HIGH, AlarmStage::ACTIVE) +
-                              getAlarmCount(AlarmPriority::PRIORITY_CRITICAL, AlarmStage::ACTIVE);
-            return totalActive > 0;
+            return getAlarmCount(AlarmStage::ACTIVE) > 0;
         }
         case 2: {
             // Relay2 (Beacon) - complex logic based on priority and state
@@ -2379,7 +3407,7 @@ void TemperatureController::forceRelayState(uint8_t relayNumber, bool state) {
 // System Status Mode implementation
 void TemperatureController::_handleSystemStatusMode() {
     // Check if a new active alarm appeared - exit immediately
-    if (!_activeAlarmsQueue.empty()) {
+    if (!_alarmQueues.empty(ALARM_QUEUE_ACTIVE)) {
         Serial.println("Active alarm detected - exiting Status section");
         _switchToSection(SECTION_ALARM_ACK);
         return;
@@ -2443,30 +3471,18 @@ void TemperatureController::_displaySystemStats() {
     String lines[3];
     
     // Count points with bound sensors
-    int boundPoints = 0;
-    for (int i = 0; i < 60; i++) {
-        if (getBoundSensor(i) != nullptr) {
-            boundPoints++;
-        }
-    }
-    
-    // Count bound DS18B20 sensors
+    // Count bound DS18B20 and PT1000 sensors
     int boundDS18B20 = 0;
-    int totalDS18B20 = getDS18B20Count();
-    for (int i = 0; i < 50; i++) { // DS18B20 points are 0-49
-        if (getBoundSensor(i) != nullptr) {
-            boundDS18B20++;
-        }
-    }
-    
-    // Count bound PT1000 sensors
     int boundPT1000 = 0;
+    int totalDS18B20 = getDS18B20Count();
     int totalPT1000 = getPT1000Count();
-    for (int i = 50; i < 60; i++) { // PT1000 points are 50-59
-        if (getBoundSensor(i) != nullptr) {
-            boundPT1000++;
-        }
+    const PointHotStore& hot = _points.hot();
+    for (uint16_t i = 0; i < hot.size(); ++i) {
+        if (!hot.bound[i]) continue;
+        if (isPT1000Address(i)) boundPT1000++;
+        else boundDS18B20++;
     }
+    int boundPoints = boundDS18B20 + boundPT1000;
     
     // Use Cyrillic text as specified
     lines[0] = "Точки:   " + String(boundPoints);
@@ -2480,23 +3496,14 @@ void TemperatureController::_displayAlarmSummaryByPriority() {
     indicator.setOledModeSmall(4, true); // 4-line mode with small font
     String lines[4];
     
-    // Count total alarms in active or acknowledged state
-    int totalAlarms = 0;
-    for (Alarm* alarm : _configuredAlarms) {
-        if (alarm->getStage() == AlarmStage::ACTIVE || alarm->getStage() == AlarmStage::ACKNOWLEDGED) {
-            totalAlarms++;
-        }
-    }
+    // Count total alarms in active or acknowledged state (the two highest stages)
+    int totalAlarms = getAlarmCount(AlarmStage::ACKNOWLEDGED, AlarmCompare::GE);
     
     // Count alarms by priority
-    int criticalCount = getAlarmCount(AlarmPriority::PRIORITY_CRITICAL, AlarmStage::ACTIVE, "==", "==") +
-                       getAlarmCount(AlarmPriority::PRIORITY_CRITICAL, AlarmStage::ACKNOWLEDGED, "==", "==");
-    int highCount = getAlarmCount(AlarmPriority::PRIORITY_HIGH, AlarmStage::ACTIVE, "==", "==") +
-                    getAlarmCount(AlarmPriority::PRIORITY_HIGH, AlarmStage::ACKNOWLEDGED, "==", "==");
-    int mediumCount = getAlarmCount(AlarmPriority::PRIORITY_MEDIUM, AlarmStage::ACTIVE, "==", "==") +
-                      getAlarmCount(AlarmPriority::PRIORITY_MEDIUM, AlarmStage::ACKNOWLEDGED, "==", "==");
-    int lowCount = getAlarmCount(AlarmPriority::PRIORITY_LOW, AlarmStage::ACTIVE, "==", "==") +
-                   getAlarmCount(AlarmPriority::PRIORITY_LOW, AlarmStage::ACKNOWLEDGED, "==", "==");
+    int criticalCount = getAlarmCount(AlarmPriority::PRIORITY_CRITICAL, AlarmStage::ACKNOWLEDGED, AlarmCompare::EQ, AlarmCompare::GE);
+    int highCount = getAlarmCount(AlarmPriority::PRIORITY_HIGH, AlarmStage::ACKNOWLEDGED, AlarmCompare::EQ, AlarmCompare::GE);
+    int mediumCount = getAlarmCount(AlarmPriority::PRIORITY_MEDIUM, AlarmStage::ACKNOWLEDGED, AlarmCompare::EQ, AlarmCompare::GE);
+    int lowCount = getAlarmCount(AlarmPriority::PRIORITY_LOW, AlarmStage::ACKNOWLEDGED, AlarmCompare::EQ, AlarmCompare::GE);
     
     // Format with Cyrillic text
     if (totalAlarms == 0) {
@@ -2588,17 +3595,15 @@ void TemperatureController::_displayModbusStatus() {
 
 // Display Section Management
 void TemperatureController::_handleDisplaySections() {
-    // Update alarm queues first
-    _updateAlarmQueues();
-    
+    // Alarm queues are kept current by the alarm transitions themselves
     // Determine which section we should be in
-    if (!_activeAlarmsQueue.empty()) {
+    if (!_alarmQueues.empty(ALARM_QUEUE_ACTIVE)) {
         // Active alarms present - switch to acknowledgment section
         if (_currentSection != SECTION_ALARM_ACK) {
             _switchToSection(SECTION_ALARM_ACK);
         }
         _screenOff = false; // Always keep screen on with active alarms
-    } else if (!_acknowledgedAlarmsQueue.empty() && _currentSection != SECTION_STATUS) {
+    } else if (!_alarmQueues.empty(ALARM_QUEUE_ACKNOWLEDGED) && _currentSection != SECTION_STATUS) {
         // Only acknowledged alarms - show them
         if (_currentSection != SECTION_ACK_ALARMS) {
             _switchToSection(SECTION_ACK_ALARMS);
@@ -2619,7 +3624,7 @@ void TemperatureController::_handleDisplaySections() {
     
     // Handle screen timeout for normal and status sections (no timeout when alarms present)
     if ((_currentSection == SECTION_NORMAL || _currentSection == SECTION_STATUS) && 
-        _activeAlarmsQueue.empty() && _acknowledgedAlarmsQueue.empty()) {
+        _alarmQueues.empty(ALARM_QUEUE_ACTIVE) && _alarmQueues.empty(ALARM_QUEUE_ACKNOWLEDGED)) {
         unsigned long currentTime = millis();
         if (!_screenOff && _lastActivityTime > 0 && 
             (currentTime - _lastActivityTime >= SCREEN_TIMEOUT_MS)) {
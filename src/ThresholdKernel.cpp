@@ -0,0 +1,100 @@
+/**
+ * @file ThresholdKernel.cpp
+ * @brief Portable and SSE2 implementations of the threshold kernel
+ * @author barabashsr
+ * @date 2026-10-16
+ *
+ * @section dependencies Dependencies
+ * - ThresholdKernel.h for the interface
+ * - emmintrin.h on hosts with SSE2
+ */
+
+#include "ThresholdKernel.h"
+
+#if THRESHOLD_KERNEL_SSE2
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Evaluate points [first, last) of one mask word lane by lane
+ * @return Low, high and error bits of the range, shifted to their word position
+ */
+static inline void evaluateLanes(const ThresholdArrays& in, uint16_t first, uint16_t last,
+                                 uint32_t prevLow, uint32_t prevHigh,
+                                 uint32_t& low, uint32_t& high, uint32_t& error) {
+    for (uint16_t i = first; i < last; ++i) {
+        const uint8_t b = i & 31;
+        const uint8_t latched = (uint8_t)(((prevLow >> b) & 1u) | (((prevHigh >> b) & 1u) << 1));
+        const uint8_t bits = thresholdBits(in.temp[i], in.low[i], in.high[i], in.error[i],
+                                           in.lowHysteresis[i], in.highHysteresis[i], latched);
+        low |= (uint32_t)(bits & THRESHOLD_BIT_LOW) << b;
+        high |= (uint32_t)((bits & THRESHOLD_BIT_HIGH) >> 1) << b;
+        error |= (uint32_t)(in.error[i] != 0) << b;
+    }
+}
+
+void evaluateThresholdsPortable(const ThresholdArrays& in, ThresholdMasks& masks) {
+    const uint16_t words = thresholdMaskWords(in.count);
+    for (uint16_t w = 0; w < words; ++w) {
+        const uint16_t first = (uint16_t)(w * 32);
+        const uint16_t last = in.count - first < 32 ? in.count : (uint16_t)(first + 32);
+        uint32_t low = 0, high = 0, error = 0;
+        evaluateLanes(in, first, last, masks.low[w], masks.high[w], low, high, error);
+        masks.low[w] = low;
+        masks.high[w] = high;
+        masks.error[w] = error;
+    }
+}
+
+#if THRESHOLD_KERNEL_SSE2
+
+void evaluateThresholdsSse2(const ThresholdArrays& in, ThresholdMasks& masks) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i laneBit = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+    const uint16_t words = thresholdMaskWords(in.count);
+
+    for (uint16_t w = 0; w < words; ++w) {
+        const uint16_t first = (uint16_t)(w * 32);
+        const uint16_t last = in.count - first < 32 ? in.count : (uint16_t)(first + 32);
+        const uint32_t prevLow = masks.low[w];
+        const uint32_t prevHigh = masks.high[w];
+        uint32_t low = 0, high = 0, error = 0;
+
+        uint16_t i = first;
+        for (; i + 8 <= last; i += 8) {
+            const uint8_t b = i & 31;
+            const __m128i temp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.temp + i));
+            const __m128i lowThr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.low + i));
+            const __m128i highThr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.high + i));
+            const __m128i lowHyst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.lowHysteresis + i));
+            const __m128i highHyst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.highHysteresis + i));
+            const __m128i err = _mm_unpacklo_epi8(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in.error + i)), zero);
+
+            // Expand the eight latch bits to all-ones lanes
+            const __m128i latchLow = _mm_cmpeq_epi16(
+                _mm_and_si128(_mm_set1_epi16((short)((prevLow >> b) & 0xFF)), laneBit), laneBit);
+            const __m128i latchHigh = _mm_cmpeq_epi16(
+                _mm_and_si128(_mm_set1_epi16((short)((prevHigh >> b) & 0xFF)), laneBit), laneBit);
+
+            // Saturation only clamps thresholds to the int16 range, which
+            // cannot change a comparison with an int16 temperature
+            const __m128i lowBand = _mm_adds_epi16(lowThr, _mm_and_si128(lowHyst, latchLow));
+            const __m128i highBand = _mm_subs_epi16(highThr, _mm_and_si128(highHyst, latchHigh));
+            const __m128i ok = _mm_cmpeq_epi16(err, zero);
+            const __m128i isLow = _mm_andnot_si128(_mm_cmpgt_epi16(temp, lowBand), ok);
+            const __m128i isHigh = _mm_andnot_si128(_mm_cmplt_epi16(temp, highBand), ok);
+
+            low |= (uint32_t)(_mm_movemask_epi8(_mm_packs_epi16(isLow, zero)) & 0xFF) << b;
+            high |= (uint32_t)(_mm_movemask_epi8(_mm_packs_epi16(isHigh, zero)) & 0xFF) << b;
+            error |= (uint32_t)(~_mm_movemask_epi8(_mm_packs_epi16(ok, zero)) & 0xFF) << b;
+        }
+        evaluateLanes(in, i, last, prevLow, prevHigh, low, high, error);
+
+        masks.low[w] = low;
+        masks.high[w] = high;
+        masks.error[w] = error;
+    }
+}
+
+#endif // THRESHOLD_KERNEL_SSE2
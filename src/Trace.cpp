@@ -0,0 +1,14 @@
+/**
+ * @file Trace.cpp
+ * @brief Runtime state of the trace facility
+ * @author barabashsr
+ * @date 2026-10-16
+ *
+ * @section dependencies Dependencies
+ * - Trace.h for the module bits
+ */
+
+#include "Trace.h"
+
+// Every module until ConfigManager applies the saved selection
+volatile uint32_t traceModuleMask = TRACE_ALL_MODULES;
@@ -197,6 +197,11 @@ void setup() {
     controller.discoverDS18B20Sensors();  // Auto-discover DS18B20 sensors on OneWire buses
     controller.discoverPTSensors();       // Initialize PT1000 sensors on SPI
     Serial.println("Sensor discovery completed");
+
+    // Move sensor acquisition off the loop task (core 1, WiFi stays on core 0)
+    if (!controller.startAcquisitionTask()) {
+        Serial.println("Acquisition task not started - sensors are read from loop()");
+    }
     // Initialize Modbus RTU server if enabled in configuration
     if (configManager->isModbusEnabled()) {
         Serial.printf("Initializing Modbus RTU server (Address: %d, Baud: %d)...\n",
@@ -0,0 +1,144 @@
+/**
+ * @file rtd_conversion_test.cpp
+ * @brief Host accuracy test and benchmark for the fixed-point RTD table
+ * @details Runs on the build machine, not on the ESP32:
+ *
+ *          g++ -std=c++11 -O2 -Iinclude test/rtd_conversion_test.cpp -o rtd_test && ./rtd_test
+ *
+ *          Accuracy: every raw code covering -40..200 °C is converted with
+ *          rtdRawToMilliC() and with the floating-point Callendar-Van Dusen
+ *          solver used by Adafruit_MAX31865::calculateTemperature(), for PT100
+ *          and PT1000 and a few calibrated RREF values. Fails (exit 1) if any
+ *          code differs by more than 0.02 °C or rounds to a different
+ *          whole degree away from a .5 boundary.
+ *
+ *          Benchmark: times both conversions over the same code sweep.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include "RtdConversion.h"
+
+/**
+ * @brief Float reference, same algorithm as Adafruit_MAX31865::calculateTemperature()
+ */
+static float referenceTemperature(uint16_t raw, float nominal, float refResistor) {
+    const float A = 3.9083e-3f, B = -5.775e-7f;
+    float Rt = raw / 32768.0f * refResistor;
+
+    float Z1 = -A;
+    float Z2 = A * A - (4 * B);
+    float Z3 = (4 * B) / nominal;
+    float Z4 = 2 * B;
+    float temp = (sqrtf(Z2 + (Z3 * Rt)) + Z1) / Z4;
+    if (temp >= 0) return temp;
+
+    // Below 0 °C: polynomial fit of the inverse CVD
+    Rt /= nominal;
+    Rt *= 100;
+    float rpoly = Rt;
+    temp = -242.02f;
+    temp += 2.2228f * rpoly;
+    rpoly *= Rt;
+    temp += 2.5859e-3f * rpoly;
+    rpoly *= Rt;
+    temp -= 4.8260e-6f * rpoly;
+    rpoly *= Rt;
+    temp -= 2.8183e-8f * rpoly;
+    rpoly *= Rt;
+    temp += 1.5243e-10f * rpoly;
+    return temp;
+}
+
+struct Channel {
+    const char* name;
+    double nominal;
+    double refResistor;
+};
+
+static const Channel channels[] = {
+    {"PT1000 RREF 4300", RTD_PT1000_NOMINAL, 4300.0},
+    {"PT1000 RREF 4292.7", RTD_PT1000_NOMINAL, 4292.7},
+    {"PT1000 RREF 4310.4", RTD_PT1000_NOMINAL, 4310.4},
+    {"PT100 RREF 430", RTD_PT100_NOMINAL, 430.0},
+    {"PT100 RREF 431.2", RTD_PT100_NOMINAL, 431.2},
+    {"PT100 RREF 4300", RTD_PT100_NOMINAL, 4300.0},
+};
+
+/**
+ * @brief Raw code range covering -40..200 °C for a channel
+ */
+static void codeRange(const Channel& ch, uint16_t& first, uint16_t& last) {
+    first = (uint16_t)ceil(rtdCvdRatio(-40.0) * ch.nominal / ch.refResistor * 32768.0);
+    last = (uint16_t)floor(rtdCvdRatio(200.0) * ch.nominal / ch.refResistor * 32768.0);
+}
+
+static bool testAccuracy() {
+    bool ok = true;
+    for (const Channel& ch : channels) {
+        uint32_t scale = rtdScaleQ16(ch.refResistor, ch.nominal);
+        uint16_t first, last;
+        codeRange(ch, first, last);
+
+        double maxErr = 0.0;
+        double maxErrAt = 0.0;
+        unsigned roundingMismatches = 0;
+        for (uint32_t raw = first; raw <= last; ++raw) {
+            double ref = referenceTemperature(raw, ch.nominal, ch.refResistor);
+            double fixed = rtdRawToMilliC(raw, scale) / 1000.0;
+            double err = fabs(fixed - ref);
+            if (err > maxErr) { maxErr = err; maxErrAt = ref; }
+
+            // Whole-degree result may only differ right at a .5 boundary
+            double distToHalf = fabs(ref - floor(ref) - 0.5);
+            if (lround(fixed) != lround(ref) && distToHalf > 0.02) roundingMismatches++;
+        }
+
+        bool pass = maxErr <= 0.02 && roundingMismatches == 0;
+        printf("%-20s codes %5u..%5u  max error %.4f C at %.1f C  rounding mismatches %u  %s\n",
+               ch.name, first, last, maxErr, maxErrAt, roundingMismatches, pass ? "PASS" : "FAIL");
+        ok = ok && pass;
+    }
+    return ok;
+}
+
+static void benchmark() {
+    const Channel& ch = channels[0];
+    uint32_t scale = rtdScaleQ16(ch.refResistor, ch.nominal);
+    uint16_t first, last;
+    codeRange(ch, first, last);
+    const int passes = 200;
+    uint32_t conversions = (uint32_t)(last - first + 1) * passes;
+
+    volatile int64_t sinkFixed = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int p = 0; p < passes; ++p)
+        for (uint32_t raw = first; raw <= last; ++raw)
+            sinkFixed += rtdRawToMilliC(raw, scale);
+    auto t1 = std::chrono::steady_clock::now();
+
+    volatile double sinkFloat = 0;
+    for (int p = 0; p < passes; ++p)
+        for (uint32_t raw = first; raw <= last; ++raw)
+            sinkFloat += referenceTemperature(raw, (float)ch.nominal, (float)ch.refResistor);
+    auto t2 = std::chrono::steady_clock::now();
+
+    double fixedNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / conversions;
+    double floatNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / conversions;
+    printf("\nBenchmark (%u conversions each)\n", conversions);
+    printf("  fixed-point table : %6.2f ns/conversion\n", fixedNs);
+    printf("  float CVD solver  : %6.2f ns/conversion (%.1fx)\n", floatNs, floatNs / fixedNs);
+}
+
+int main() {
+    printf("RTD table: %u segments, R/R0 %.4f..%.4f, %.3f..%.3f C\n\n",
+           RTD_SEGMENTS, RTD_FIRST_SEGMENT / 32.0, (RTD_FIRST_SEGMENT + RTD_SEGMENTS) / 32.0,
+           RTD_TABLE.milliC[0] / 1000.0, RTD_TABLE.milliC[RTD_SEGMENTS] / 1000.0);
+
+    bool ok = testAccuracy();
+    benchmark();
+
+    printf("\n%s\n", ok ? "ALL TESTS PASSED" : "TESTS FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file sensor_bus_sim_test.cpp
+ * @brief Host test and benchmark for the simulated sensor backends
+ * @details Runs on the build machine, not on the ESP32:
+ *
+ *          g++ -std=c++11 -O2 -Iinclude test/sensor_bus_sim_test.cpp src/SimulatedSensorBus.cpp -o bus_sim && ./bus_sim
+ *
+ *          Drives SimulatedOneWireBus and SimulatedRtd only through
+ *          OneWireInterface / RtdInterface, the way Sensor does, on a manual
+ *          clock: enumeration, conversion timing, resolution, Alarm Search,
+ *          CRC/dropout injection and the RTD code path. Fails (exit 1) on the
+ *          first mismatch.
+ *
+ *          Benchmark: full convert + read sweeps over 8 buses of 64 devices
+ *          (512 sensors) with the configured per-read latency.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include <chrono>
+#include "SimulatedSensorBus.h"
+
+static uint32_t manualNow = 1000;
+static uint32_t manualClock() { return manualNow; }
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); failures++; } \
+} while (0)
+
+/**
+ * @brief Read one device the way Sensor::readConvertedTemperature() does
+ * @return 0 ok, 1 no answer, 2 CRC error
+ */
+static int readDevice(OneWireInterface* bus, const uint8_t* rom, float& tempC) {
+    uint8_t sp[DS18B20_SCRATCHPAD_SIZE];
+    if (!bus->readScratchPad(rom, sp)) return 1;
+    if (oneWireCrc8(sp, 8) != sp[DS18B20_SP_CRC]) return 2;
+    int16_t raw = (int16_t)((sp[DS18B20_SP_TEMP_MSB] << 8) | sp[DS18B20_SP_TEMP_LSB]);
+    tempC = raw / 16.0f;
+    return 0;
+}
+
+static std::vector<std::vector<uint8_t> > enumerate(OneWireInterface* bus, bool alarmOnly) {
+    std::vector<std::vector<uint8_t> > roms;
+    uint8_t rom[8];
+    bus->resetSearch();
+    while (bus->search(rom, alarmOnly)) roms.push_back(std::vector<uint8_t>(rom, rom + 8));
+    return roms;
+}
+
+static void testEnumerationAndTiming() {
+    SimulationProfile profile;
+    profile.devicesPerBus = 64;
+    profile.baseTempC = 20.0f;
+    profile.spreadC = 10.0f;
+    profile.noiseC = 0.0f;
+    SimulatedOneWireBus sim(4, profile);
+    OneWireInterface* bus = &sim;
+
+    std::vector<std::vector<uint8_t> > roms = enumerate(bus, false);
+    CHECK(roms.size() == 64, "enumerated %u devices", (unsigned)roms.size());
+    for (size_t i = 0; i < roms.size(); ++i) {
+        CHECK(oneWireValidFamily(&roms[i][0]), "family 0x%02X", roms[i][0]);
+        CHECK(oneWireCrc8(&roms[i][0], 7) == roms[i][7], "ROM CRC of device %u", (unsigned)i);
+    }
+
+    float t = 0;
+    CHECK(readDevice(bus, &roms[0][0], t) == 0 && t == 85.0f, "power-on value %.2f", t);
+
+    bus->convertAll();
+    manualNow += ds18b20ConversionTimeMs(12) - 1;
+    readDevice(bus, &roms[0][0], t);
+    CHECK(t == 85.0f, "value before conversion end %.2f", t);
+    manualNow += 1;
+    for (size_t i = 0; i < roms.size(); ++i) {
+        CHECK(readDevice(bus, &roms[i][0], t) == 0, "read device %u", (unsigned)i);
+        CHECK(t >= 14.9f && t <= 25.1f, "device %u at %.2f outside spread", (unsigned)i, t);
+    }
+
+    // 9-bit: 94 ms and 0.5 °C steps
+    CHECK(bus->setResolution(&roms[1][0], 9), "setResolution");
+    bus->convert(&roms[1][0]);
+    manualNow += ds18b20ConversionTimeMs(9);
+    readDevice(bus, &roms[1][0], t);
+    CHECK(fmodf(t * 2.0f, 1.0f) == 0.0f, "9-bit value %.4f not in 0.5 steps", t);
+
+    // Hot-unplug
+    sim.setPresent(2, false);
+    CHECK(enumerate(bus, false).size() == 63, "unplugged device still enumerated");
+    CHECK(!bus->isConnected(sim.getDeviceRom(2)), "unplugged device connected");
+}
+
+static void testAlarmSearch() {
+    SimulationProfile profile;
+    profile.devicesPerBus = 16;
+    profile.baseTempC = 30.0f;
+    profile.spreadC = 0.0f;
+    profile.noiseC = 0.0f;
+    SimulatedOneWireBus sim(5, profile);
+    OneWireInterface* bus = &sim;
+
+    // Flag every fourth device with TH below the simulated temperature
+    for (size_t i = 0; i < sim.getDeviceCount(); ++i) {
+        uint8_t sp[DS18B20_SCRATCHPAD_SIZE] = {};
+        sp[DS18B20_SP_TH] = (i % 4 == 0) ? 25 : 40;
+        sp[DS18B20_SP_TL] = (uint8_t)(int8_t)-10;
+        sp[DS18B20_SP_CONFIG] = 0x7F;
+        bus->writeScratchPad(sim.getDeviceRom(i), sp);
+    }
+    bus->convertAll();
+    manualNow += ds18b20ConversionTimeMs(12);
+    std::vector<std::vector<uint8_t> > flagged = enumerate(bus, true);
+    CHECK(flagged.size() == 4, "alarm search found %u devices", (unsigned)flagged.size());
+}
+
+static void testFaultInjection() {
+    SimulationProfile profile;
+    profile.devicesPerBus = 32;
+    profile.crcErrorPerMille = 100;
+    profile.dropoutPerMille = 50;
+    SimulatedOneWireBus sim(6, profile);
+    OneWireInterface* bus = &sim;
+
+    bus->convertAll();
+    manualNow += 750;
+    unsigned counts[3] = {0, 0, 0};
+    float t;
+    for (int round = 0; round < 100; ++round) {
+        for (size_t i = 0; i < sim.getDeviceCount(); ++i) counts[readDevice(bus, sim.getDeviceRom(i), t)]++;
+    }
+    // 3200 reads: expect about 160 dropouts and 304 CRC errors
+    CHECK(counts[1] > 80 && counts[1] < 260, "dropouts %u", counts[1]);
+    CHECK(counts[2] > 200 && counts[2] < 420, "CRC errors %u", counts[2]);
+    printf("Fault injection: %u ok, %u no answer, %u CRC errors\n", counts[0], counts[1], counts[2]);
+}
+
+static void testRtd() {
+    SimulationProfile profile;
+    profile.baseTempC = 55.0f;
+    profile.noiseC = 0.0f;
+    SimulatedRtd sim(12, profile, RTD_PT1000_NOMINAL, 4300.0);
+    sim.setOffset(0.0f);
+    RtdInterface* rtd = &sim;
+    rtd->begin();
+    rtd->configure(true, true);
+
+    uint16_t raw;
+    uint8_t fault;
+    rtd->readLatest(raw, fault);
+    float t = rtdRawToMilliC(raw, rtdScaleQ16(4300.0, RTD_PT1000_NOMINAL)) / 1000.0f;
+    CHECK(fault == 0, "fault 0x%02X", fault);
+    CHECK(fabsf(t - 55.0f) < 0.1f, "RTD reads %.3f", t);
+
+    SimulationProfile open = profile;
+    open.dropoutPerMille = 1000;
+    SimulatedRtd broken(13, open);
+    broken.readOneShot(raw, fault);
+    CHECK((fault & RTD_FAULT_SERIOUS) != 0, "open RTD fault 0x%02X", fault);
+}
+
+static void benchmark() {
+    const int buses = 8;
+    const int sweeps = 20;
+    SimulationProfile profile;
+    profile.devicesPerBus = 64;
+    profile.readLatencyUs = 5;
+    setSimulationClock(nullptr);
+
+    std::vector<SimulatedOneWireBus*> sims;
+    std::vector<std::vector<std::vector<uint8_t> > > roms;
+    for (int b = 0; b < buses; ++b) {
+        sims.push_back(new SimulatedOneWireBus((uint8_t)(b + 1), profile));
+        roms.push_back(enumerate(sims.back(), false));
+    }
+
+    unsigned reads = 0, ok = 0;
+    float t;
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < sweeps; ++s) {
+        for (int b = 0; b < buses; ++b) {
+            OneWireInterface* bus = sims[b];
+            bus->lock();
+            bus->convertAll();
+            for (size_t i = 0; i < roms[b].size(); ++i) {
+                reads++;
+                if (readDevice(bus, &roms[b][i][0], t) == 0) ok++;
+            }
+            bus->unlock();
+        }
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("Benchmark: %d sweeps x %d sensors, %u reads (%u ok) in %.1f ms, %.2f us/read\n",
+           sweeps, buses * (int)profile.devicesPerBus, reads, ok, ms, ms * 1000.0 / reads);
+
+    for (SimulatedOneWireBus* sim : sims) delete sim;
+}
+
+int main() {
+    setSimulationClock(manualClock);
+    testEnumerationAndTiming();
+    testAlarmSearch();
+    testFaultInjection();
+    testRtd();
+    benchmark();
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All simulated bus checks passed\n");
+    return 0;
+}
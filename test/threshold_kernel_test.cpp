@@ -0,0 +1,203 @@
+/**
+ * @file threshold_kernel_test.cpp
+ * @brief Host test and benchmark for the batch threshold kernel
+ * @details Runs on the build machine, not on the ESP32:
+ *
+ *          g++ -std=c++11 -O2 -Iinclude test/threshold_kernel_test.cpp src/ThresholdKernel.cpp -o thresholds && ./thresholds
+ *
+ *          Checks the portable and (where available) SSE2 kernels against a
+ *          straightforward per-point reference with if/else hysteresis, over
+ *          random temperatures that wander across the thresholds so the
+ *          latch is exercised, odd point counts and extreme int16 values.
+ *          Fails (exit 1) on the first mismatch.
+ *
+ *          Benchmark: 60, 250 and 4096 points, reference vs kernels.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <chrono>
+#include "ThresholdKernel.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); failures++; } \
+} while (0)
+
+static uint32_t rngState = 12345;
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+/**
+ * @brief Point arrays plus the three mask sets under test
+ */
+struct Fixture {
+    uint16_t count;
+    std::vector<int16_t> temp, low, high, lowHyst, highHyst;
+    std::vector<uint8_t> error;
+    std::vector<uint32_t> refLow, refHigh, refError;
+    std::vector<uint32_t> portLow, portHigh, portError;
+    std::vector<uint32_t> simdLow, simdHigh, simdError;
+
+    explicit Fixture(uint16_t n)
+        : count(n), temp(n), low(n), high(n), lowHyst(n), highHyst(n), error(n),
+          refLow(thresholdMaskWords(n)), refHigh(thresholdMaskWords(n)), refError(thresholdMaskWords(n)),
+          portLow(thresholdMaskWords(n)), portHigh(thresholdMaskWords(n)), portError(thresholdMaskWords(n)),
+          simdLow(thresholdMaskWords(n)), simdHigh(thresholdMaskWords(n)), simdError(thresholdMaskWords(n)) {
+        for (uint16_t i = 0; i < n; ++i) {
+            low[i] = (int16_t)(nextRandom() % 20) - 10;
+            high[i] = (int16_t)(40 + nextRandom() % 20);
+            lowHyst[i] = (int16_t)(nextRandom() % 4);
+            highHyst[i] = (int16_t)(nextRandom() % 4);
+            temp[i] = (int16_t)(nextRandom() % 80) - 20;
+        }
+    }
+
+    ThresholdArrays arrays() const {
+        ThresholdArrays in = { &temp[0], &low[0], &high[0], &lowHyst[0], &highHyst[0], &error[0], count };
+        return in;
+    }
+};
+
+static bool bit(const std::vector<uint32_t>& mask, uint16_t i) { return (mask[i >> 5] >> (i & 31)) & 1u; }
+
+/**
+ * @brief Reference: the per-alarm checks as Alarm::_checkCondition() did them
+ */
+static void evaluateReference(Fixture& f) {
+    std::vector<uint32_t> low(f.refLow.size()), high(f.refHigh.size()), error(f.refError.size());
+    for (uint16_t i = 0; i < f.count; ++i) {
+        bool isLow, isHigh;
+        if (bit(f.refLow, i)) isLow = f.temp[i] <= f.low[i] + f.lowHyst[i];
+        else isLow = f.temp[i] <= f.low[i];
+        if (bit(f.refHigh, i)) isHigh = f.temp[i] >= f.high[i] - f.highHyst[i];
+        else isHigh = f.temp[i] >= f.high[i];
+        if (f.error[i] != 0) {
+            isLow = isHigh = false;
+            error[i >> 5] |= 1u << (i & 31);
+        }
+        if (isLow) low[i >> 5] |= 1u << (i & 31);
+        if (isHigh) high[i >> 5] |= 1u << (i & 31);
+    }
+    f.refLow = low;
+    f.refHigh = high;
+    f.refError = error;
+}
+
+static void runPortable(Fixture& f) {
+    ThresholdMasks masks = { &f.portLow[0], &f.portHigh[0], &f.portError[0] };
+    evaluateThresholdsPortable(f.arrays(), masks);
+}
+
+static void runSimd(Fixture& f) {
+    ThresholdMasks masks = { &f.simdLow[0], &f.simdHigh[0], &f.simdError[0] };
+    evaluateThresholds(f.arrays(), masks);
+}
+
+static void compare(const Fixture& f, const char* what) {
+    for (size_t w = 0; w < f.refLow.size(); ++w) {
+        CHECK(f.portLow[w] == f.refLow[w] && f.portHigh[w] == f.refHigh[w] && f.portError[w] == f.refError[w],
+              "%s: portable word %u low %08X/%08X high %08X/%08X error %08X/%08X", what, (unsigned)w,
+              f.portLow[w], f.refLow[w], f.portHigh[w], f.refHigh[w], f.portError[w], f.refError[w]);
+        CHECK(f.simdLow[w] == f.refLow[w] && f.simdHigh[w] == f.refHigh[w] && f.simdError[w] == f.refError[w],
+              "%s: dispatched word %u low %08X/%08X high %08X/%08X error %08X/%08X", what, (unsigned)w,
+              f.simdLow[w], f.refLow[w], f.simdHigh[w], f.refHigh[w], f.simdError[w], f.refError[w]);
+    }
+}
+
+static void testRandomWalk(uint16_t count) {
+    Fixture f(count);
+    for (int round = 0; round < 200; ++round) {
+        for (uint16_t i = 0; i < count; ++i) {
+            f.temp[i] = (int16_t)(f.temp[i] + (int)(nextRandom() % 7) - 3);
+            f.error[i] = (nextRandom() % 50 == 0) ? (uint8_t)(1u << (nextRandom() % 8)) : 0;
+        }
+        evaluateReference(f);
+        runPortable(f);
+        runSimd(f);
+        char what[48];
+        snprintf(what, sizeof(what), "%u points, round %d", (unsigned)count, round);
+        compare(f, what);
+        if (failures) return;
+    }
+}
+
+static void testHysteresis() {
+    Fixture f(1);
+    f.low[0] = 0; f.high[0] = 50; f.lowHyst[0] = 2; f.highHyst[0] = 2; f.error[0] = 0;
+    const int16_t walk[] = { 49, 50, 49, 48, 47, 50, 10, 0, 1, 2, 3 };
+    const uint8_t expect[] = { 0, THRESHOLD_BIT_HIGH, THRESHOLD_BIT_HIGH, THRESHOLD_BIT_HIGH, 0,
+                               THRESHOLD_BIT_HIGH, 0, THRESHOLD_BIT_LOW, THRESHOLD_BIT_LOW,
+                               THRESHOLD_BIT_LOW, 0 };
+    for (size_t k = 0; k < sizeof(walk) / sizeof(walk[0]); ++k) {
+        f.temp[0] = walk[k];
+        runSimd(f);
+        ThresholdMasks masks = { &f.simdLow[0], &f.simdHigh[0], &f.simdError[0] };
+        CHECK(thresholdMaskBits(masks, 0) == expect[k], "step %u temp %d: bits %u, expected %u",
+              (unsigned)k, walk[k], thresholdMaskBits(masks, 0), expect[k]);
+    }
+}
+
+static void testExtremes() {
+    Fixture f(19);
+    for (uint16_t i = 0; i < f.count; ++i) {
+        f.temp[i] = (i & 1) ? 32767 : -32768;
+        f.low[i] = (i % 3 == 0) ? 32767 : -32768;
+        f.high[i] = (i % 3 == 1) ? -32768 : 32767;
+        f.lowHyst[i] = 30000;
+        f.highHyst[i] = 30000;
+    }
+    for (int round = 0; round < 3; ++round) {
+        evaluateReference(f);
+        runPortable(f);
+        runSimd(f);
+        compare(f, "extremes");
+    }
+    // Unused bits of the last word stay clear
+    CHECK((f.simdLow[0] >> 19) == 0 && (f.simdHigh[0] >> 19) == 0, "bits past count set");
+}
+
+template <typename Fn>
+static double timeNs(Fixture& f, int iterations, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < iterations; ++k) {
+        f.temp[k % f.count] ^= 1;   // keep the compiler from hoisting the pass
+        fn(f);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+static void benchmark(uint16_t count) {
+    Fixture f(count);
+    const int iterations = count > 1000 ? 20000 : 200000;
+    double reference = timeNs(f, iterations, evaluateReference);
+    double portable = timeNs(f, iterations, runPortable);
+    double dispatched = timeNs(f, iterations, runSimd);
+    printf("Benchmark %4u points: reference %8.1f ns, portable %8.1f ns, %s %8.1f ns per pass\n",
+           (unsigned)count, reference, portable, THRESHOLD_KERNEL_SSE2 ? "SSE2" : "portable", dispatched);
+}
+
+int main() {
+    const uint16_t counts[] = { 1, 7, 8, 31, 32, 33, 60, 250 };
+    for (uint16_t count : counts) testRandomWalk(count);
+    testHysteresis();
+    testExtremes();
+
+    benchmark(60);
+    benchmark(250);
+    benchmark(4096);
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All threshold kernel checks passed\n");
+    return 0;
+}